@@ -1,27 +1,105 @@
-TEMPLATE = app
-CONFIG += console c++11
-CONFIG -= app_bundle
-CONFIG -= qt
-
-SOURCES += main.cpp \
-    readxml.cpp \
-    tag.cpp \
-    primenumfunc.cpp \
-    findprimes.cpp \
-    intervalsoutput.cpp \
-    primesconsoleoutput.cpp \
-    primenumbersvector.cpp \
-    primesfileoutput.cpp
-
-HEADERS += \
-    readxml.h \
-    tag.h \
-    interval.hpp \
-    primenumfunc.h \
-    findprimes.h \
-    intervalsoutput.h \
-    xml_output.hpp \
-    primesoutput.hpp \
-    primesconsoleoutput.h \
-    primenumbersvector.h \
-    primesfileoutput.h
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += main.cpp \
+    readxml.cpp \
+    tag.cpp \
+    primenumfunc.cpp \
+    findprimes.cpp \
+    intervalsoutput.cpp \
+    primesconsoleoutput.cpp \
+    primenumbersvector.cpp \
+    primesfileoutput.cpp \
+    bucketsieve.cpp \
+    presieve.cpp \
+    simdkernels.cpp \
+    millerrabin.cpp \
+    sieveplanner.cpp \
+    numbersoutput.cpp \
+    batchprimality.cpp \
+    profiler.cpp \
+    perfcounters.cpp \
+    alloctracker.cpp \
+    primesring.cpp \
+    primegenerator.cpp \
+    primesindex.cpp \
+    tuplefinder.cpp \
+    tuplesoutput.cpp \
+    statisticsoutput.cpp \
+    intervalpieces.cpp \
+    groupedoutput.cpp \
+    progressionoutput.cpp \
+    factorsieve.cpp \
+    factorsfileoutput.cpp \
+    primesbinaryoutput.cpp \
+    shardcoordinator.cpp \
+    checkpoint.cpp \
+    arena.cpp \
+    sharedprimesexport.cpp \
+    sharedprimesreader.cpp \
+    gzipwriter.cpp \
+    primesgzipoutput.cpp \
+    primesteeoutput.cpp
+
+HEADERS += \
+    readxml.h \
+    tag.h \
+    interval.hpp \
+    primenumfunc.h \
+    findprimes.h \
+    intervalsoutput.h \
+    xml_output.hpp \
+    primesoutput.hpp \
+    primesconsoleoutput.h \
+    primenumbersvector.h \
+    primesfileoutput.h \
+    sievewords.hpp \
+    sievesettings.hpp \
+    bucketsieve.h \
+    presieve.h \
+    simdkernels.h \
+    millerrabin.h \
+    sieveplanner.h \
+    numbersoutput.h \
+    batchprimality.h \
+    profiler.h \
+    perfcounters.h \
+    alloctracker.h \
+    primesring.h \
+    primegenerator.h \
+    primesindex.h \
+    tuplepattern.hpp \
+    tuplefinder.h \
+    tuplesoutput.h \
+    statisticsoutput.h \
+    intervalpieces.h \
+    groupedoutput.h \
+    progression.hpp \
+    progressionoutput.h \
+    factorsoutput.hpp \
+    factorsieve.h \
+    factorsfileoutput.h \
+    primesbinaryoutput.h \
+    shardcoordinator.h \
+    checkpoint.h \
+    arena.h \
+    arenaallocator.hpp \
+    sharedprimes.hpp \
+    sharedprimesexport.h \
+    sharedprimesreader.h \
+    primesrow.hpp \
+    gzipwriter.h \
+    primesgzipoutput.h \
+    primesteeoutput.h
+
+
+LIBS += -lz
+linux: LIBS += -lrt
+
+alloc_tracker {
+    DEFINES += PRIMES_ALLOC_TRACKER
+    LIBS += -ldl
+    QMAKE_LFLAGS += -rdynamic
+}
\ No newline at end of file
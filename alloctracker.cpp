@@ -0,0 +1,370 @@
+/**
+  *************************************************************************************************************************
+  * @file    alloctracker.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Opt-in tracker of the heap allocations. When the program is built with PRIMES_ALLOC_TRACKER
+  *          (CONFIG += alloc_tracker), global operators new and delete count allocations, bytes and peak live memory
+  *          for the current phase of the thread (phases are set by Profiler::ScopedTimer) and for the call sites.
+  *          In the usual build the operators are not replaced and the tracker reports nothing
+  **************************************************************************************************************************
+*/
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <ostream>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#endif
+
+#include "alloctracker.h"
+
+#ifdef PRIMES_ALLOC_TRACKER
+
+namespace
+{
+    // All data is zero-initialised before any dynamic initialisation, so operator new may be called at any time
+
+    struct PhaseStat
+    {
+        std::atomic <uint64_t> m_nAllocs;
+        std::atomic <uint64_t> m_nFrees;
+        std::atomic <uint64_t> m_nBytes;
+        std::atomic <uint64_t> m_nPeakLive;                 // Max of the live memory of the program during the phase
+    };
+
+    struct SiteStat
+    {
+        std::atomic <uintptr_t> m_nAddress;                 // Return address of operator new, 0 - empty entry
+        std::atomic <uint64_t> m_nAllocs;
+        std::atomic <uint64_t> m_nBytes;
+    };
+
+    struct Header                                           // Placed before every block, keeps the alignment of malloc
+    {
+        uint64_t m_nSize;
+        uint32_t m_nPhase;
+        uint32_t m_nReserved;
+    };
+
+    static_assert(sizeof(Header) == 16, "Header must keep the alignment of malloc");
+
+    const char *g_pPhaseNames[AllocTracker::m_nMaxPhases];
+    uint32_t g_nPhasesNum;
+    std::mutex g_PhasesMutex;
+
+    PhaseStat g_Phases[AllocTracker::m_nMaxPhases];
+    SiteStat g_Sites[AllocTracker::m_nMaxSites];
+    std::atomic <uint64_t> g_nLive;
+    thread_local uint32_t g_nCurPhase;
+
+    /**
+     * @brief Add the allocation to the call site. Open addressing, the site is lost if the table is full
+     * @param nAddress Return address of operator new
+     * @param nSize Size of the allocation
+     * @return None
+     */
+    void addSite(uintptr_t nAddress, uint64_t nSize)
+    {
+        uint32_t nIdx = static_cast <uint32_t> ((nAddress >> 4) * 0x9E3779B1u) % AllocTracker::m_nMaxSites;
+
+        for(uint32_t i = 0; i < AllocTracker::m_nMaxSites; ++i, nIdx = (nIdx + 1) % AllocTracker::m_nMaxSites)
+        {
+            uintptr_t nCur = g_Sites[nIdx].m_nAddress.load(std::memory_order_relaxed);
+
+            if(!nCur && g_Sites[nIdx].m_nAddress.compare_exchange_strong(nCur, nAddress))
+            {
+                nCur = nAddress;
+            }
+            if(nCur == nAddress)
+            {
+                g_Sites[nIdx].m_nAllocs.fetch_add(1, std::memory_order_relaxed);
+                g_Sites[nIdx].m_nBytes.fetch_add(nSize, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check whether operators new and delete are replaced
+ * @param None
+ * @return true in the build with PRIMES_ALLOC_TRACKER
+ */
+bool AllocTracker::isCompiled()
+{
+    return true;
+}
+
+/**
+ * @brief Make the phase current for the calling thread. Names are compared by contents, new names are registered
+ * @param pPhase Name of the phase (string literal)
+ * @return Previous phase of the thread to restore by leavePhase
+ */
+uint32_t AllocTracker::enterPhase(const char *pPhase)
+{
+    uint32_t nPrev = g_nCurPhase, nIdx(0);
+    std::lock_guard <std::mutex> Lock(g_PhasesMutex);
+
+    if(!g_nPhasesNum)
+    {
+        g_pPhaseNames[g_nPhasesNum++] = "other";
+    }
+
+    for(nIdx = 0; nIdx < g_nPhasesNum && strcmp(g_pPhaseNames[nIdx], pPhase); ++nIdx) {}
+
+    if(nIdx == g_nPhasesNum)
+    {
+        if(g_nPhasesNum == m_nMaxPhases)
+        {
+            return nPrev;                                               // No room: the phase is counted as the previous one
+        }
+        g_pPhaseNames[g_nPhasesNum++] = pPhase;
+    }
+
+    g_nCurPhase = nIdx;
+
+    return nPrev;
+}
+
+/**
+ * @brief Restore the previous phase of the calling thread
+ * @param nPrevPhase Phase returned by enterPhase
+ * @return None
+ */
+void AllocTracker::leavePhase(uint32_t nPrevPhase)
+{
+    g_nCurPhase = nPrevPhase;
+}
+
+/**
+ * @brief Allocate the block with the header and count it
+ * @param nSize Size requested
+ * @param pCaller Return address of operator new
+ * @return Pointer to the block or nullptr
+ */
+void *AllocTracker::allocate(size_t nSize, void *pCaller)
+{
+    Header *pHeader = static_cast <Header *> (malloc(sizeof(Header) + nSize));
+    if(!pHeader)
+    {
+        return nullptr;
+    }
+
+    uint32_t nPhase = g_nCurPhase;
+    PhaseStat &Stat = g_Phases[nPhase];
+
+    pHeader->m_nSize = nSize;
+    pHeader->m_nPhase = nPhase;
+
+    Stat.m_nAllocs.fetch_add(1, std::memory_order_relaxed);
+    Stat.m_nBytes.fetch_add(nSize, std::memory_order_relaxed);
+
+    uint64_t nLive = g_nLive.fetch_add(nSize, std::memory_order_relaxed) + nSize;
+    uint64_t nPeak = Stat.m_nPeakLive.load(std::memory_order_relaxed);
+    while(nPeak < nLive && !Stat.m_nPeakLive.compare_exchange_weak(nPeak, nLive, std::memory_order_relaxed)) {}
+
+    addSite(reinterpret_cast <uintptr_t> (pCaller), nSize);
+
+    return pHeader + 1;
+}
+
+/**
+ * @brief Free the block allocated by allocate()
+ * @param pMem Pointer to the block (may be nullptr)
+ * @return None
+ */
+void AllocTracker::deallocate(void *pMem)
+{
+    if(!pMem)
+    {
+        return;
+    }
+
+    Header *pHeader = static_cast <Header *> (pMem) - 1;
+
+    g_Phases[pHeader->m_nPhase].m_nFrees.fetch_add(1, std::memory_order_relaxed);
+    g_nLive.fetch_sub(pHeader->m_nSize, std::memory_order_relaxed);
+    free(pHeader);
+}
+
+/**
+ * @brief Write statistics of phases and the top call sites by bytes in JSON. Call sites are resolved by dladdr
+ *        (symbols of the executable need -rdynamic), the module and the offset in it are given for addr2line
+ * @param out Stream to write in
+ * @return None
+ */
+void AllocTracker::writeJson(std::ostream &out)
+{
+    uint32_t nPhasesNum;
+    {
+        std::lock_guard <std::mutex> Lock(g_PhasesMutex);
+        nPhasesNum = std::max(g_nPhasesNum, 1u);
+    }
+
+    out << "{\n    \"phases\": [";
+    for(uint32_t i = 0; i < nPhasesNum; ++i)
+    {
+        out << (i ? ",\n" : "\n") << "      { \"name\": \"" << (g_pPhaseNames[i] ? g_pPhaseNames[i] : "other")
+            << "\", \"allocations\": " << g_Phases[i].m_nAllocs.load() << ", \"frees\": " << g_Phases[i].m_nFrees.load()
+            << ", \"bytes\": " << g_Phases[i].m_nBytes.load() << ", \"peak_live\": " << g_Phases[i].m_nPeakLive.load() << " }";
+    }
+
+    std::vector <uint32_t> nSitesVc;
+    for(uint32_t i = 0; i < m_nMaxSites; ++i)
+    {
+        if(g_Sites[i].m_nAddress.load())
+        {
+            nSitesVc.push_back(i);
+        }
+    }
+
+    size_t nTop = std::min <size_t> (m_nTopSites, nSitesVc.size());
+    std::partial_sort(nSitesVc.begin(), nSitesVc.begin() + nTop, nSitesVc.end(), [] (uint32_t nA, uint32_t nB)
+    {
+        return g_Sites[nA].m_nBytes.load() > g_Sites[nB].m_nBytes.load();
+    });
+
+    out << "\n    ],\n    \"top_sites\": [";
+    for(size_t i = 0; i < nTop; ++i)
+    {
+        const SiteStat &Site = g_Sites[nSitesVc[i]];
+        const char *pSymbol = "", *pModule = "";
+        uintptr_t nOffset = Site.m_nAddress.load();
+
+#ifdef __linux__
+        Dl_info Info;
+        if(dladdr(reinterpret_cast <void *> (Site.m_nAddress.load()), &Info))
+        {
+            pSymbol = (Info.dli_sname ? Info.dli_sname : "");
+            pModule = (Info.dli_fname ? Info.dli_fname : "");
+            nOffset -= reinterpret_cast <uintptr_t> (Info.dli_fbase);
+        }
+#endif
+
+        out << (i ? ",\n" : "\n") << "      { \"module\": \"" << pModule << "\", \"offset\": \"0x" << std::hex << nOffset
+            << std::dec << "\", \"symbol\": \"" << pSymbol << "\", \"allocations\": " << Site.m_nAllocs.load()
+            << ", \"bytes\": " << Site.m_nBytes.load() << " }";
+    }
+    out << "\n    ]\n  }";
+}
+
+void *operator new(size_t nSize)
+{
+    void *pMem = AllocTracker::allocate(nSize, __builtin_return_address(0));
+    if(!pMem)
+    {
+        throw std::bad_alloc();
+    }
+    return pMem;
+}
+
+void *operator new[](size_t nSize)
+{
+    void *pMem = AllocTracker::allocate(nSize, __builtin_return_address(0));
+    if(!pMem)
+    {
+        throw std::bad_alloc();
+    }
+    return pMem;
+}
+
+void *operator new(size_t nSize, const std::nothrow_t &) noexcept
+{
+    return AllocTracker::allocate(nSize, __builtin_return_address(0));
+}
+
+void *operator new[](size_t nSize, const std::nothrow_t &) noexcept
+{
+    return AllocTracker::allocate(nSize, __builtin_return_address(0));
+}
+
+void operator delete(void *pMem) noexcept
+{
+    AllocTracker::deallocate(pMem);
+}
+
+void operator delete[](void *pMem) noexcept
+{
+    AllocTracker::deallocate(pMem);
+}
+
+void operator delete(void *pMem, const std::nothrow_t &) noexcept
+{
+    AllocTracker::deallocate(pMem);
+}
+
+void operator delete[](void *pMem, const std::nothrow_t &) noexcept
+{
+    AllocTracker::deallocate(pMem);
+}
+
+#else
+
+/**
+ * @brief Check whether operators new and delete are replaced
+ * @param None
+ * @return false in the usual build
+ */
+bool AllocTracker::isCompiled()
+{
+    return false;
+}
+
+/**
+ * @brief Phases are not tracked in the usual build
+ * @param None
+ * @return 0
+ */
+uint32_t AllocTracker::enterPhase(const char *)
+{
+    return 0;
+}
+
+/**
+ * @brief Phases are not tracked in the usual build
+ * @param None
+ * @return None
+ */
+void AllocTracker::leavePhase(uint32_t) {}
+
+/**
+ * @brief No statistics in the usual build
+ * @param out Stream to write in
+ * @return None
+ */
+void AllocTracker::writeJson(std::ostream &out)
+{
+    out << "null";
+}
+
+/**
+ * @brief Allocate the block without counting
+ * @param nSize Size requested
+ * @return Pointer to the block or nullptr
+ */
+void *AllocTracker::allocate(size_t nSize, void *)
+{
+    return malloc(nSize);
+}
+
+/**
+ * @brief Free the block allocated by allocate()
+ * @param pMem Pointer to the block
+ * @return None
+ */
+void AllocTracker::deallocate(void *pMem)
+{
+    free(pMem);
+}
+
+#endif
+
+//*****************************************************************************************
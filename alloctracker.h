@@ -0,0 +1,39 @@
+/**
+  *************************************************************************************************************************
+  * @file    alloctracker.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Opt-in tracker of the heap allocations. When the program is built with PRIMES_ALLOC_TRACKER
+  *          (CONFIG += alloc_tracker), global operators new and delete count allocations, bytes and peak live memory
+  *          for the current phase of the thread (phases are set by Profiler::ScopedTimer) and for the call sites.
+  *          In the usual build the operators are not replaced and the tracker reports nothing
+  **************************************************************************************************************************
+*/
+
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <iosfwd>
+#include <cstddef>
+#include <stdint.h>
+
+class AllocTracker
+{
+public:
+    static bool isCompiled();                               // Operators new and delete are replaced
+    static uint32_t enterPhase(const char *pPhase);         // Returns the previous phase of the thread
+    static void leavePhase(uint32_t nPrevPhase);
+    static void writeJson(std::ostream &out);               // Statistics of phases and top call sites (JSON object)
+
+    static void *allocate(size_t nSize, void *pCaller);
+    static void deallocate(void *pMem);
+
+    static constexpr uint32_t m_nMaxPhases = 32;            // Phase 0 is everything outside of phases
+    static constexpr uint32_t m_nMaxSites = 4096;           // Size of the hash table of call sites
+    static constexpr uint32_t m_nTopSites = 20;             // Number of call sites in the report
+};
+
+#endif // ALLOCTRACKER_H
+
+//*****************************************************************************************
@@ -0,0 +1,263 @@
+/**
+  *************************************************************************************************************************
+  * @file    arena.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Arena of big buffers: words of the sieve, blocks of buckets and buffers of output files. Buffers are
+  *          aligned to the cache line (small ones) or to the page, they may be backed by transparent or explicit huge
+  *          pages and pre-faulted by several threads. Released buffers are kept in the arena and given again for
+  *          the next segments and searches, memory is never returned to the system
+  **************************************************************************************************************************
+*/
+
+#include <new>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "arena.h"
+#include "profiler.h"
+
+/**
+ * @brief Class Arena constructor
+ */
+Arena::Arena(): m_eHugePages(HUGE_PAGES_NONE), m_fPrefault(false), m_nReserved(0) {}
+
+/**
+ * @brief Class Arena destructor
+ */
+Arena::~Arena() {}
+
+/**
+ * @brief Returns the arena of the program. It is never destroyed, so containers of static objects may release their
+ *        buffers at exit
+ * @param None
+ * @return Arena
+ */
+Arena &Arena::get()
+{
+    static Arena *pArena = new Arena();
+
+    return *pArena;
+}
+
+/**
+ * @brief Set the kind of pages and pre-faulting of new buffers
+ * @param eHugePages Kind of pages
+ * @param fPrefault Touch pages of big buffers by several threads before they are given
+ * @return None
+ */
+void Arena::configure(HugePages eHugePages, bool fPrefault)
+{
+    std::lock_guard <std::mutex> Lock(m_Mutex);
+
+    m_eHugePages = eHugePages;
+    m_fPrefault = fPrefault;
+}
+
+/**
+ * @brief Size of the buffer: small ones are rounded to the cache line, others to the page (to the huge page if they
+ *        are backed by huge pages)
+ * @param nBytes Bytes requested
+ * @param eHugePages Kind of pages
+ * @return Size of the buffer
+ */
+size_t Arena::roundSize(size_t nBytes, HugePages eHugePages)
+{
+    size_t nAlign = (nBytes < m_nPageSize ? m_nCacheLine : m_nPageSize);
+
+    if(eHugePages != HUGE_PAGES_NONE && nBytes >= m_nHugePageSize)
+    {
+        nAlign = m_nHugePageSize;
+    }
+
+    return (nBytes ? (nBytes + nAlign - 1) / nAlign * nAlign : m_nCacheLine);
+}
+
+/**
+ * @brief Give the buffer. The smallest released buffer which is not more than 1/4 bigger is reused, otherwise new
+ *        buffer is taken from the system
+ * @param nBytes Bytes requested
+ * @return Buffer (std::bad_alloc is thrown if there is no memory)
+ */
+void *Arena::allocate(size_t nBytes)
+{
+    HugePages eHugePages;
+    bool fPrefault;
+    size_t nSize;
+
+    {
+        std::lock_guard <std::mutex> Lock(m_Mutex);
+
+        eHugePages = m_eHugePages;
+        fPrefault = m_fPrefault;
+        nSize = roundSize(nBytes, eHugePages);
+
+        std::multimap <size_t, void*>::iterator it = m_FreeMap.lower_bound(nSize);
+        if(it != m_FreeMap.end() && it->first - nSize <= nSize / 4)
+        {
+            void *pMem = it->second;
+
+            m_FreeMap.erase(it);
+            return pMem;
+        }
+    }
+
+    void *pMem = map(nSize, eHugePages);
+    if(!pMem)
+    {
+        throw std::bad_alloc();
+    }
+
+    if(fPrefault && nSize >= m_nPrefaultMin)
+    {
+        prefault(pMem, nSize, eHugePages == HUGE_PAGES_EXPLICIT ? m_nHugePageSize : m_nPageSize);
+    }
+
+    {
+        std::lock_guard <std::mutex> Lock(m_Mutex);
+
+        m_SizeMap[pMem] = nSize;
+        m_nReserved += nSize;
+    }
+    Profiler::get().addCounter("arena_reserved_bytes", nSize);
+
+    return pMem;
+}
+
+/**
+ * @brief Take the buffer back, it is kept for the next requests
+ * @param pMem Buffer given by allocate()
+ * @return None
+ */
+void Arena::release(void *pMem)
+{
+    if(!pMem)
+    {
+        return;
+    }
+
+    std::lock_guard <std::mutex> Lock(m_Mutex);
+    std::unordered_map <void*, size_t>::iterator it = m_SizeMap.find(pMem);
+
+    if(it != m_SizeMap.end())
+    {
+        m_FreeMap.emplace(it->second, pMem);
+    }
+}
+
+/**
+ * @brief Returns bytes of all buffers taken from the system
+ * @param None
+ * @return Bytes
+ */
+size_t Arena::getReserved() const
+{
+    std::lock_guard <std::mutex> Lock(m_Mutex);
+
+    return m_nReserved;
+}
+
+/**
+ * @brief Take new buffer from the system. Buffers of huge pages are aligned to the huge page, explicit huge pages fall
+ *        back to transparent ones if they are not reserved in the system
+ * @param nSize Size of the buffer (rounded by roundSize())
+ * @param eHugePages Kind of pages
+ * @return Buffer (nullptr if there is no memory)
+ */
+void *Arena::map(size_t nSize, HugePages eHugePages) const
+{
+#ifdef __linux__
+    void *pMem = nullptr;
+
+    if(nSize < m_nPageSize)
+    {
+        return (posix_memalign(&pMem, m_nCacheLine, nSize) ? nullptr : pMem);
+    }
+
+    if(eHugePages == HUGE_PAGES_EXPLICIT && !(nSize % m_nHugePageSize))
+    {
+        pMem = mmap(nullptr, nSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(pMem != MAP_FAILED)
+        {
+            return pMem;
+        }
+
+        Profiler::get().addCounter("arena_hugetlb_fallbacks", 1);
+        eHugePages = HUGE_PAGES_TRANSPARENT;
+    }
+
+    if(eHugePages == HUGE_PAGES_TRANSPARENT && !(nSize % m_nHugePageSize))
+    {
+        char *pRaw = static_cast <char*> (mmap(nullptr, nSize + m_nHugePageSize, PROT_READ | PROT_WRITE,
+                                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if(pRaw == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        char *pAligned = pRaw + (m_nHugePageSize - reinterpret_cast <uintptr_t> (pRaw) % m_nHugePageSize) % m_nHugePageSize;
+        if(pAligned != pRaw)
+        {
+            munmap(pRaw, pAligned - pRaw);                                  // Cut the head and the tail of the mapping
+        }
+        if(pAligned + nSize != pRaw + nSize + m_nHugePageSize)
+        {
+            munmap(pAligned + nSize, pRaw + nSize + m_nHugePageSize - (pAligned + nSize));
+        }
+
+        madvise(pAligned, nSize, MADV_HUGEPAGE);
+        return pAligned;
+    }
+
+    pMem = mmap(nullptr, nSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return (pMem == MAP_FAILED ? nullptr : pMem);
+#else
+    size_t nAlign = (nSize < m_nPageSize ? m_nCacheLine : m_nPageSize);
+    char *pRaw = static_cast <char*> (std::malloc(nSize + nAlign));        // It is never freed, so the raw pointer isn't kept
+
+    (void)eHugePages;
+    return (pRaw ? pRaw + (nAlign - reinterpret_cast <uintptr_t> (pRaw) % nAlign) : nullptr);
+#endif
+}
+
+/**
+ * @brief Touch every page of the buffer, parts of the buffer are touched by different threads
+ * @param pMem Buffer
+ * @param nSize Size of the buffer
+ * @param nStep Size of the page
+ * @return None
+ */
+void Arena::prefault(void *pMem, size_t nSize, size_t nStep)
+{
+    Profiler::ScopedTimer Timer("prefault");
+    size_t nPages = nSize / nStep;
+    size_t nThreads = std::max <size_t> (1, std::min <size_t> (std::thread::hardware_concurrency(), nSize / m_nPrefaultPart));
+    std::vector <std::thread> ThreadsVc;
+
+    for(size_t t = 0; t < nThreads; ++t)
+    {
+        ThreadsVc.emplace_back([pMem, nStep, nPages, nThreads, t] ()
+        {
+            volatile char *pBytes = static_cast <char*> (pMem);
+
+            for(size_t i = nPages * t / nThreads, p = nPages * (t + 1) / nThreads; i < p; ++i)
+            {
+                pBytes[i * nStep] = 0;
+            }
+        });
+    }
+
+    for(std::thread &Thread : ThreadsVc)
+    {
+        Thread.join();
+    }
+}
+
+//*****************************************************************************************
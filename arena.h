@@ -0,0 +1,67 @@
+/**
+  *************************************************************************************************************************
+  * @file    arena.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Arena of big buffers: words of the sieve, blocks of buckets and buffers of output files. Buffers are
+  *          aligned to the cache line (small ones) or to the page, they may be backed by transparent or explicit huge
+  *          pages and pre-faulted by several threads. Released buffers are kept in the arena and given again for
+  *          the next segments and searches, memory is never returned to the system
+  **************************************************************************************************************************
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+#include <stdint.h>
+
+class Arena
+{
+public:
+    enum HugePages
+    {
+        HUGE_PAGES_NONE,                                    // Usual pages
+        HUGE_PAGES_TRANSPARENT,                             // madvise(MADV_HUGEPAGE) for big buffers
+        HUGE_PAGES_EXPLICIT                                 // MAP_HUGETLB (reserved pages), transparent ones if they are absent
+    };
+
+    static Arena &get();
+
+    void configure(HugePages eHugePages, bool fPrefault);   // For buffers allocated after the call
+    void *allocate(size_t nBytes);
+    void release(void *pMem);
+    size_t getReserved() const;                             // Bytes taken from the system
+
+    static constexpr size_t m_nCacheLine = 64;
+    static constexpr size_t m_nPageSize = 4096;
+    static constexpr size_t m_nHugePageSize = 2 << 20;
+
+private:
+    static constexpr size_t m_nPrefaultMin = 4 << 20;       // Smaller buffers are faulted by the first touch
+    static constexpr size_t m_nPrefaultPart = 4 << 20;      // Bytes pre-faulted by one thread at least
+
+    mutable std::mutex m_Mutex;
+    std::multimap <size_t, void*> m_FreeMap;                // Released buffers by size
+    std::unordered_map <void*, size_t> m_SizeMap;           // Size of every buffer
+    HugePages m_eHugePages;
+    bool m_fPrefault;
+    size_t m_nReserved;
+
+    Arena();
+    ~Arena();
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    static size_t roundSize(size_t nBytes, HugePages eHugePages);
+    void *map(size_t nSize, HugePages eHugePages) const;   // New buffer from the system
+    static void prefault(void *pMem, size_t nSize, size_t nStep);
+};
+
+#endif // ARENA_H
+
+//*****************************************************************************************
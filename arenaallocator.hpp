@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    arenaallocator.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Allocator of the standard containers which takes memory from
+  *          Arena: buffers are aligned and reused by the next containers
+  ******************************************************************************
+*/
+
+#ifndef ARENAALLOCATOR_HPP
+#define ARENAALLOCATOR_HPP
+
+#include <new>
+
+#include "arena.h"
+
+template <class T>
+struct ArenaAllocator
+{
+    typedef T value_type;
+
+    ArenaAllocator() {}
+    template <class U> ArenaAllocator(const ArenaAllocator <U> &) {}
+
+    T *allocate(size_t n)
+    {
+        return static_cast <T*> (Arena::get().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t)
+    {
+        Arena::get().release(p);
+    }
+};
+
+template <class T, class U>
+inline bool operator==(const ArenaAllocator <T> &, const ArenaAllocator <U> &) { return true; }
+
+template <class T, class U>
+inline bool operator!=(const ArenaAllocator <T> &, const ArenaAllocator <U> &) { return false; }
+
+#endif // ARENAALLOCATOR_HPP
+
+//*****************************************************************************************
@@ -0,0 +1,156 @@
+/**
+  *************************************************************************************************************************
+  * @file    batchprimality.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class for the primality test of the list of separate numbers. Small numbers are looked up in the sieve,
+  *          large ones are tested by the batch Miller-Rabin test in several threads
+  **************************************************************************************************************************
+*/
+
+#include <thread>
+#include <algorithm>
+
+#include "batchprimality.h"
+#include "millerrabin.h"
+#include "profiler.h"
+
+/**
+ * @brief Class BatchPrimality constructor. Tests all numbers of the list
+ * @param pNumVc Numbers to test
+ */
+BatchPrimality::BatchPrimality(const std::vector <uint64_t> *pNumVc): m_pNumVc(pNumVc), m_fResVc(pNumVc->size())
+{
+    Profiler::ScopedTimer Timer("batch_test");
+    m_nNumOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    lookupSmall();
+    multyThreadTesting();
+    Profiler::get().addCounter("batch_numbers", pNumVc->size());
+}
+
+/**
+ * @brief Class BatchPrimality destructor
+ */
+BatchPrimality::~BatchPrimality() {}
+
+/**
+ * @brief Result of the test
+ * @param None
+ * @return Bitmap: element i is true if the number i of the list is prime
+ */
+const std::vector <bool> &BatchPrimality::getResult() const
+{
+    return m_fResVc;
+}
+
+/**
+ * @brief Number of primes in the list (repeated numbers are counted every time)
+ * @param None
+ * @return Number of primes
+ */
+size_t BatchPrimality::count() const
+{
+    return std::count(m_fResVc.begin(), m_fResVc.end(), true);
+}
+
+/**
+ * @brief Sieve odd numbers up to the largest number under the lookup limit and look small numbers up.
+ *        Indices of large numbers are collected for the Miller-Rabin test
+ * @param None
+ * @return None
+ */
+void BatchPrimality::lookupSmall()
+{
+    uint64_t nMaxSmall(0);
+
+    for(size_t i = 0, p = m_pNumVc->size(); i < p; ++i)
+    {
+        if((*m_pNumVc)[i] > m_nLookupLimit)
+        {
+            m_nLargeVc.push_back(i);
+        }
+        else if((*m_pNumVc)[i] > nMaxSmall)
+        {
+            nMaxSmall = (*m_pNumVc)[i];
+        }
+    }
+
+    m_fLookupVc.assign(nMaxSmall / 2 + 1, false);
+    m_fLookupVc[0] = true;                                                  // 1 is not prime
+
+    for(uint64_t i = 3; i * i <= nMaxSmall; i += 2)
+    {
+        if(!m_fLookupVc[i / 2])
+        {
+            for(uint64_t j = i * i; j <= nMaxSmall; j += 2 * i)
+            {
+                m_fLookupVc[j / 2] = true;
+            }
+        }
+    }
+
+    for(size_t i = 0, p = m_pNumVc->size(); i < p; ++i)
+    {
+        uint64_t nVal = (*m_pNumVc)[i];
+
+        if(nVal <= m_nLookupLimit)
+        {
+            m_fResVc[i] = (nVal == 2 || ((nVal & 1) && !m_fLookupVc[nVal / 2]));
+        }
+    }
+
+    m_fLookupVc.clear();
+    m_fLookupVc.shrink_to_fit();
+}
+
+/**
+ * @brief Gather large numbers, split them among threads and test every part by the batch Miller-Rabin test.
+ *        Threads write bytes of m_nTestVc, so they don't share words of the bool vector
+ * @param None
+ * @return None
+ */
+void BatchPrimality::multyThreadTesting()
+{
+    size_t nLarge = m_nLargeVc.size();
+    if(!nLarge)
+    {
+        return;
+    }
+
+    std::vector <uint64_t> nValVc(nLarge);
+    for(size_t i = 0; i < nLarge; ++i)
+    {
+        nValVc[i] = (*m_pNumVc)[m_nLargeVc[i]];
+    }
+    m_nTestVc.assign(nLarge, 0);
+
+    size_t nThreads = std::min <size_t> (m_nNumOfThreads, (nLarge + m_nMinPerThread - 1) / m_nMinPerThread);
+    size_t nPart = (nLarge + nThreads - 1) / nThreads;
+    std::vector <std::thread> threadsVc;
+
+    for(size_t nBeg = 0; nBeg < nLarge; nBeg += nPart)
+    {
+        size_t nCount = std::min(nPart, nLarge - nBeg);
+        threadsVc.emplace_back([&nValVc, this, nBeg, nCount]()
+        {
+            MillerRabin::isPrime(&nValVc[nBeg], nCount, &m_nTestVc[nBeg]);
+        });
+    }
+
+    for(std::thread &thr : threadsVc)
+    {
+        thr.join();
+    }
+
+    for(size_t i = 0; i < nLarge; ++i)
+    {
+        m_fResVc[m_nLargeVc[i]] = m_nTestVc[i];
+    }
+
+    m_nTestVc.clear();
+    m_nTestVc.shrink_to_fit();
+}
+
+//*****************************************************************************************
@@ -0,0 +1,45 @@
+/**
+  *************************************************************************************************************************
+  * @file    batchprimality.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class for the primality test of the list of separate numbers. Small numbers are looked up in the sieve,
+  *          large ones are tested by the batch Miller-Rabin test in several threads
+  **************************************************************************************************************************
+*/
+
+#ifndef BATCHPRIMALITY_H
+#define BATCHPRIMALITY_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+class BatchPrimality
+{
+public:
+    BatchPrimality(const std::vector <uint64_t> *pNumVc);
+    ~BatchPrimality();
+
+    const std::vector <bool> &getResult() const;            // Primality bitmap in the order of the input numbers
+    size_t count() const;                                   // Number of primes in the list
+
+private:
+    static constexpr uint64_t m_nLookupLimit = 1 << 24;     // Numbers up to the limit are looked up in the sieve
+    static constexpr size_t m_nMinPerThread = 1 << 12;      // Less numbers are not worth to start the thread
+
+    const std::vector <uint64_t> *m_pNumVc;                 // Numbers to test
+    std::vector <bool> m_fResVc;                            // Result of the test
+    std::vector <bool> m_fLookupVc;                         // Odd-only sieve: bit i is set if 2 * i + 1 is composite
+    std::vector <uint8_t> m_nTestVc;                        // Result of the Miller-Rabin test (byte per number for threads)
+    std::vector <size_t> m_nLargeVc;                        // Indices of numbers above the lookup limit
+    uint32_t m_nNumOfThreads;
+
+    void lookupSmall();                                     // Sieve up to the largest small number and look numbers up
+    void multyThreadTesting();                              // Miller-Rabin test of large numbers
+};
+
+#endif // BATCHPRIMALITY_H
+
+//*****************************************************************************************
@@ -0,0 +1,996 @@
+/**
+  *************************************************************************************************************************
+  * @file    benchmark.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Benchmark of the pipeline on deterministic workloads. Every stage (reading and parsing of xml, merging of
+  *          intervals, sieve, counting, writing of the result) is timed separately, the best time of the repeats is
+  *          reported. Primes of the engine, of the written file, of PrimeGenerator and of PrimesIndex are checked against
+  *          the reference sieve, the generator is also stopped after its first primes and the index answers random
+  *          rank and next prime queries.
+  *
+  *          With --checks the benchmark also runs verification steps of the features which have no workload: prime
+  *          tuples of every size of the wheel are compared with the brute force, factors of FactorSieve (up to the max
+  *          64-bit number) are checked by FactorsCheck, and SharedPrimesReader is compared with PrimesIndex across
+  *          the switch of the generation of shared memory.
+  *          Works offline, results are printed as the table and optionally written as CSV and JSON.
+  *
+  *          Sweep mode searches one workload (dense_low by default) with every combination of numbers of threads,
+  *          primes of the wheel and sizes of the segment (log2 of bits) and reports scaling of the engine.
+  *
+  *          With --pipelined primes are sieved while they are written (the count stage is skipped, only the file is
+  *          checked).
+  *
+  *          The long workload top_edge (the window which ends at 2^64 - 1) is run only by --workload top_edge.
+  *
+  *          benchmark [--scale X] [--seed N] [--repeat N] [--workload NAME] [--dir DIR] [--csv FILE] [--json FILE]
+  *                    [--simd] [--pipelined] [--checks]
+  *          benchmark --sweep [--threads 1,2,4] [--wheels 3,4,5] [--segments 16,18,20] [--scale X] [--seed N]
+  *                    [--repeat N] [--workload NAME] [--dir DIR] [--json FILE]
+  *          benchmark --verify INTERVALS.xml PRIMES.xml
+  *
+  *          Exit code is 1 if any check fails, so the benchmark can gate changes
+  **************************************************************************************************************************
+*/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <random>
+
+#include "readxml.h"
+#include "intervalsoutput.h"
+#include "findprimes.h"
+#include "primesfileoutput.h"
+#include "simdkernels.h"
+#include "tuplefinder.h"
+#include "millerrabin.h"
+#include "factorsieve.h"
+#include "primesindex.h"
+#include "sharedprimesexport.h"
+#include "sharedprimesreader.h"
+#include "workload.h"
+#include "referencesieve.h"
+#include "primecursor.h"
+#include "sweep.h"
+#include "factorscheck.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+    enum Stage { READ_PARSE, INTERVALS, SIEVE, COUNT, WRITE, VERIFY, STAGES_NUM };
+
+    const char *g_pStageNames[STAGES_NUM] = { "read_parse", "intervals", "sieve", "count", "write", "verify" };
+
+    const uint64_t g_nIndexQueries = 100000;                // Random queries of rank and next prime of PrimesIndex
+
+    struct Options
+    {
+        double m_fScale = 1.0;
+        uint64_t m_nSeed = 2026;
+        uint32_t m_nRepeat = 3;
+        std::string m_sWorkload;                            // Empty - all workloads
+        std::string m_sDir = ".";
+        const char *m_pCsvName = nullptr;
+        const char *m_pJsonName = nullptr;
+        bool m_fSimd = false;
+        bool m_fChecks = false;                             // Verification steps of the features
+        bool m_fSweep = false;
+        bool m_fPipelined = false;
+        std::vector <uint32_t> m_nThreadsVc;                // Lists of the sweep
+        std::vector <uint32_t> m_nWheelsVc = { 3, 4, 5 };
+        std::vector <uint32_t> m_nSegmentsVc = { 1 << 16, 1 << 18, 1 << 20 };
+    };
+
+    struct CheckResult
+    {
+        uint64_t m_nCount = 0;                              // Primes of the reference
+        uint64_t m_nChecksum = 0;                           // FNV-1a of primes of the reference
+        std::vector <uint64_t> m_nErrorsVc;                 // Mismatches of every cursor
+        std::vector <std::string> m_FirstErrorVc;           // The first mismatch of every cursor
+        std::vector <const char *> m_pNamesVc;              // Names of cursors
+    };
+
+    struct Result
+    {
+        std::string m_sName;
+        uint64_t m_nIntervals = 0;                          // Intervals of the input
+        uint64_t m_nMerged = 0;                             // Intervals after merging
+        uint64_t m_nNumbers = 0;                            // Numbers covered by intervals
+        uint64_t m_nPrimes = 0;                             // Count of the engine
+        CheckResult m_Check;
+        bool m_fOk = false;
+        uint64_t m_nTimes[STAGES_NUM] = {};                 // Best time of every stage in nanoseconds
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @brief Nanoseconds since the time point
+     * @param Start Time point
+     * @return Nanoseconds
+     */
+    uint64_t elapsed(Clock::time_point Start)
+    {
+        return std::chrono::duration_cast <std::chrono::nanoseconds> (Clock::now() - Start).count();
+    }
+
+    /**
+     * @brief Count the mismatch of the cursor, the first one is kept
+     * @param Res Result of the check
+     * @param nCursor Index of the cursor
+     * @param sError Mismatch
+     * @return None
+     */
+    void addError(CheckResult &Res, size_t nCursor, const std::string &sError)
+    {
+        if(!Res.m_nErrorsVc[nCursor]++)
+        {
+            Res.m_FirstErrorVc[nCursor] = sError;
+        }
+    }
+
+    /**
+     * @brief Compare primes of the cursors with the reference sieve
+     * @param IntVc Sorted merged intervals
+     * @param CursorsVc Cursors to check
+     * @return Count and checksum of the reference and mismatches of every cursor
+     */
+    CheckResult checkPrimes(const std::vector <Interval> &IntVc, const std::vector <PrimeCursor *> &CursorsVc)
+    {
+        CheckResult Res;
+
+        Res.m_nChecksum = 14695981039346656037ULL;
+        Res.m_nErrorsVc.assign(CursorsVc.size(), 0);
+        Res.m_FirstErrorVc.assign(CursorsVc.size(), "");
+
+        ReferenceSieve(&IntVc).run([&] (const std::vector <uint64_t> &PrimesVc)
+        {
+            for(uint64_t nPrime : PrimesVc)
+            {
+                ++Res.m_nCount;
+                Res.m_nChecksum = (Res.m_nChecksum ^ nPrime) * 1099511628211ULL;
+
+                for(size_t i = 0, p = CursorsVc.size(); i < p; ++i)
+                {
+                    uint64_t nGot;
+                    if(!CursorsVc[i]->next(nGot))
+                    {
+                        addError(Res, i, "missing " + std::to_string(nPrime));
+                    }
+                    else if(nGot != nPrime)
+                    {
+                        addError(Res, i, "expected " + std::to_string(nPrime) + ", got " + std::to_string(nGot));
+                    }
+                }
+            }
+        });
+
+        for(size_t i = 0, p = CursorsVc.size(); i < p; ++i)
+        {
+            uint64_t nGot;
+            while(CursorsVc[i]->next(nGot))
+            {
+                addError(Res, i, "extra " + std::to_string(nGot));
+            }
+        }
+
+        return Res;
+    }
+
+    /**
+     * @brief Take the first primes of the generator and stop it: they must be the first primes of the checked file
+     * @param IntVc Sorted merged intervals
+     * @param pFileName Name of the checked file of primes
+     * @return Empty string or the mismatch
+     */
+    std::string checkEarlyStop(std::vector <Interval> IntVc, const char *pFileName)
+    {
+        const uint64_t nTaken = 1000;
+        PrimeGenerator Generator(&IntVc);
+        FileCursor File(pFileName);
+        uint64_t nCount(0), nExpected;
+
+        for(uint64_t nPrime : Generator)
+        {
+            if(!File.next(nExpected))
+            {
+                return "early stop: extra " + std::to_string(nPrime);
+            }
+            if(nExpected != nPrime)
+            {
+                return "early stop: expected " + std::to_string(nExpected) + ", got " + std::to_string(nPrime);
+            }
+            if(++nCount == nTaken)
+            {
+                break;                                      // The rest chunks are not sieved
+            }
+        }
+
+        if(nCount < nTaken && File.next(nExpected))
+        {
+            return "early stop: missing " + std::to_string(nExpected);
+        }
+
+        return "";
+    }
+
+    /**
+     * @brief Check random queries of the index: the rank and the next prime of numbers of intervals, of primes and of
+     *        numbers before primes. All positions of the index are checked with the reference before, so the answers
+     *        are checked with nthPrime
+     * @param Index Index over the result of the engine
+     * @param IntVc Sorted merged intervals
+     * @param nSeed Seed of the random generator
+     * @param Res Result of the check to add mismatches to
+     * @param nCursor Index of the cursor of the index
+     * @return None
+     */
+    void checkIndexQueries(const PrimesIndex &Index, const std::vector <Interval> &IntVc, uint64_t nSeed, CheckResult &Res,
+                           size_t nCursor)
+    {
+        std::mt19937_64 Random(nSeed);
+        uint64_t nCount = Index.count();
+
+        for(uint64_t q = 0; q < g_nIndexQueries && !IntVc.empty(); ++q)
+        {
+            uint64_t nVal;
+
+            if(q % 2 || !nCount)                            // A number of the random interval
+            {
+                const Interval &Int = IntVc[Random() % IntVc.size()];
+                nVal = Int.m_nLowIntervalSide + Random() % (Int.m_nHighIntervalSide - Int.m_nLowIntervalSide + 1);
+            }
+            else                                            // The random prime or the number before it
+            {
+                nVal = Index.nthPrime(Random() % nCount) - (q % 4 ? 1 : 0);
+            }
+
+            uint64_t nRank = Index.rank(nVal), nNext = Index.nextPrime(nVal);
+            if(nRank > nCount || (nRank && Index.nthPrime(nRank - 1) > nVal) ||
+               nNext != (nRank < nCount ? Index.nthPrime(nRank) : 0))
+            {
+                addError(Res, nCursor, "query " + std::to_string(nVal) + ": rank " + std::to_string(nRank) +
+                                       ", next prime " + std::to_string(nNext));
+            }
+        }
+    }
+
+    /**
+     * @brief Run the pipeline on the workload several times, check the result of the first run
+     * @param Work Workload
+     * @param Opt Options
+     * @return Result
+     */
+    Result runWorkload(const Workload &Work, const Options &Opt)
+    {
+        Result Res;
+        std::string sInName = Opt.m_sDir + "/bench_" + Work.m_sName + ".xml";
+        std::string sOutName = Opt.m_sDir + "/bench_" + Work.m_sName + "_primes.xml";
+
+        Res.m_sName = Work.m_sName;
+        Res.m_nIntervals = Work.m_IntVc.size();
+
+        if(!WorkloadGenerator::writeXml(Work, sInName.c_str()))
+        {
+            std::cerr << "Can't write " << sInName << '\n';
+            return Res;
+        }
+
+        for(uint32_t r = 0; r < Opt.m_nRepeat; ++r)
+        {
+            uint64_t nTimes[STAGES_NUM] = {};
+            std::vector <Interval> IntVc;
+            Clock::time_point Start = Clock::now();
+
+            ReadXml Xml(sInName.c_str(), { "root" });
+            nTimes[READ_PARSE] = elapsed(Start);
+
+            Start = Clock::now();
+            Xml.setOutput(new IntervalsOutput(&IntVc));
+            Xml.output();
+            nTimes[INTERVALS] = elapsed(Start);
+
+            Start = Clock::now();
+            FindPrimes Primes(&IntVc, SieveSettings(0, 0, 0, Opt.m_fPipelined));
+            nTimes[SIEVE] = elapsed(Start);
+
+            if(!Opt.m_fPipelined)
+            {
+                Start = Clock::now();
+                Res.m_nPrimes = Primes.m_pPrimeNumVector->count();
+                nTimes[COUNT] = elapsed(Start);
+            }
+
+            Start = Clock::now();
+            Primes.setOutput(new PrimesFileOutput(sOutName.c_str()));
+            Primes.output();
+            nTimes[WRITE] = elapsed(Start);
+
+            if(!r)
+            {
+                Start = Clock::now();
+                FileCursor File(sOutName.c_str());
+                std::vector <Interval> GenIntVc(IntVc);
+                GeneratorCursor Generator(&GenIntVc);
+                std::vector <PrimeCursor *> CursorsVc = { &File, &Generator };
+                std::unique_ptr <EngineCursor> pEngine;
+                std::unique_ptr <PrimesIndex> pIndex;
+                std::unique_ptr <IndexCursor> pIndexCursor;
+
+                if(!Opt.m_fPipelined)                       // The result is not kept in the pipelined mode
+                {
+                    pEngine.reset(new EngineCursor(Primes.m_pPrimeNumVector));
+                    pIndex.reset(new PrimesIndex(Primes.m_pPrimeNumVector));
+                    pIndexCursor.reset(new IndexCursor(pIndex.get()));
+                    CursorsVc.push_back(pEngine.get());
+                    CursorsVc.push_back(pIndexCursor.get());
+                }
+
+                Res.m_Check = checkPrimes(IntVc, CursorsVc);
+                Res.m_Check.m_pNamesVc = { "file", "generator", "engine", "index" };
+
+                std::string sError = checkEarlyStop(IntVc, sOutName.c_str());
+                if(!sError.empty())
+                {
+                    addError(Res.m_Check, 1, sError);
+                }
+
+                if(pIndex)
+                {
+                    checkIndexQueries(*pIndex, IntVc, Opt.m_nSeed, Res.m_Check, 3);
+                }
+                nTimes[VERIFY] = elapsed(Start);
+
+                Res.m_nMerged = IntVc.size();
+                for(const Interval &Int : IntVc)
+                {
+                    Res.m_nNumbers += Int.m_nHighIntervalSide - Int.m_nLowIntervalSide + 1;
+                }
+                Res.m_nPrimes = (Opt.m_fPipelined ? Res.m_Check.m_nCount : Res.m_nPrimes);
+                Res.m_fOk = File.isOpen() && Res.m_nPrimes == Res.m_Check.m_nCount &&
+                            std::count(Res.m_Check.m_nErrorsVc.begin(), Res.m_Check.m_nErrorsVc.end(), 0) ==
+                            static_cast <std::ptrdiff_t> (CursorsVc.size());
+            }
+
+            for(uint32_t i = 0; i < STAGES_NUM; ++i)
+            {
+                if(!r || (i != VERIFY && nTimes[i] < Res.m_nTimes[i]))
+                {
+                    Res.m_nTimes[i] = nTimes[i];
+                }
+            }
+        }
+
+        remove(sInName.c_str());
+        remove(sOutName.c_str());
+
+        return Res;
+    }
+
+    /**
+     * @brief Cross-check all SIMD variants supported by the CPU with the scalar one on random words
+     * @param None
+     * @return Names of variants and results
+     */
+    std::vector <std::pair <std::string, bool> > checkSimd()
+    {
+        std::vector <std::pair <std::string, bool> > ResVc;
+
+        for(const SimdKernels::Variant &Var : SimdKernels::getSupported())
+        {
+            ResVc.emplace_back(Var.m_pName, SimdKernels::check(Var));
+        }
+
+        return ResVc;
+    }
+
+    /**
+     * @brief Find tuples of several patterns with every size of the wheel and compare counts and first members of every
+     *        block with the brute force (every number is tested by Miller-Rabin). Intervals give the block of small
+     *        numbers with tuples of primes of the wheel, the sieved block and the block of the direct test
+     * @param None
+     * @return Names of checks and results
+     */
+    std::vector <std::pair <std::string, bool> > checkTuples()
+    {
+        static const char *pPatterns[] = { "twins", "cousins", "sexy", "triplets", "triplets2", "quadruplets",
+                                           "0,2,6,8,12", "0,30" };
+        const std::vector <Interval> IntVc = { Interval(0, 100000), Interval(10000000000ULL, 10001000000ULL),
+                                               Interval(1000000000000ULL, 1000000100000ULL) };
+        std::vector <std::vector <bool> > fPrimesVc;        // Primality of every number of intervals
+        std::vector <std::pair <std::string, bool> > ResVc;
+
+        for(const Interval &Int : IntVc)
+        {
+            fPrimesVc.emplace_back();
+            for(uint64_t n = Int.m_nLowIntervalSide; n <= Int.m_nHighIntervalSide; ++n)
+            {
+                fPrimesVc.back().push_back(MillerRabin::isPrime(n));
+            }
+        }
+
+        auto isPrime = [&IntVc, &fPrimesVc] (uint64_t nVal)
+        {
+            for(size_t i = 0; i < IntVc.size(); ++i)
+            {
+                if(nVal >= IntVc[i].m_nLowIntervalSide && nVal <= IntVc[i].m_nHighIntervalSide)
+                {
+                    return static_cast <bool> (fPrimesVc[i][nVal - IntVc[i].m_nLowIntervalSide]);
+                }
+            }
+            return MillerRabin::isPrime(nVal);
+        };
+
+        for(uint32_t nWheel = 1; nWheel <= SieveSettings::m_nMaxWheelPrimes; ++nWheel)
+        {
+            std::vector <Interval> SearchVc(IntVc);
+            FindPrimes Primes(&SearchVc, SieveSettings(0, nWheel));
+            TupleFinder Finder(Primes.m_pPrimeNumVector);
+            bool fOk(Finder.getBlocksNum() == SearchVc.size());  // Blocks are intervals of the search
+
+            for(const char *pPattern : pPatterns)
+            {
+                TuplePattern Pattern;
+                TupleFinder::parsePattern(pPattern, Pattern);
+
+                for(size_t b = 0, p = (fOk ? SearchVc.size() : 0); b < p; ++b)
+                {
+                    const Interval &Int = SearchVc[b];
+                    std::vector <uint64_t> FirstVc, ExpectedVc;
+                    uint64_t nCount = Finder.find(b, Pattern, &FirstVc);
+
+                    for(uint64_t n = Int.m_nLowIntervalSide; n <= Int.m_nHighIntervalSide &&
+                        Pattern.m_nOffsetsVc.back() <= Int.m_nHighIntervalSide - n; ++n)
+                    {
+                        bool fTuple(true);
+                        for(size_t j = 0; fTuple && j < Pattern.m_nOffsetsVc.size(); ++j)
+                        {
+                            fTuple = isPrime(n + Pattern.m_nOffsetsVc[j]);
+                        }
+                        if(fTuple)
+                        {
+                            ExpectedVc.push_back(n);
+                        }
+                    }
+
+                    if(nCount != ExpectedVc.size() || FirstVc != ExpectedVc)
+                    {
+                        printf("    wheel %u, %s, block %llu: %llu tuples, expected %llu\n", nWheel, pPattern,
+                               static_cast <unsigned long long> (b), static_cast <unsigned long long> (nCount),
+                               static_cast <unsigned long long> (ExpectedVc.size()));
+                        fOk = false;
+                    }
+                }
+            }
+
+            ResVc.emplace_back("tuples_wheel_" + std::to_string(nWheel), fOk);
+        }
+
+        return ResVc;
+    }
+
+    /**
+     * @brief Factor numbers of windows by FactorSieve in both modes and check them by FactorsCheck. The last window ends
+     *        at the max 64-bit number, so initial primes are found up to 2^32
+     * @param None
+     * @return Names of checks and results
+     */
+    std::vector <std::pair <std::string, bool> > checkFactors()
+    {
+        const std::vector <Interval> IntVc = { Interval(0, 100000), Interval(1000000000000ULL, 1000000100000ULL),
+                                               Interval(18446744073709551515ULL, 18446744073709551615ULL) };
+        std::vector <uint64_t> nSmallestVc;
+        std::vector <std::pair <std::string, bool> > ResVc;
+        uint64_t nNumbers(0);
+
+        for(const Interval &Int : IntVc)
+        {
+            nNumbers += Int.m_nHighIntervalSide - Int.m_nLowIntervalSide + 1;
+        }
+
+        for(bool fFull : { true, false })
+        {
+            FactorSieve Sieve(&IntVc, SieveSettings(), fFull);
+            FactorsCheck *pCheck = new FactorsCheck(&nSmallestVc);  // The sieve deletes it
+
+            Sieve.setOutput(pCheck);
+            Sieve.output();
+            if(pCheck->getErrors())
+            {
+                printf("    %s: %llu mismatches, first: %s\n", fFull ? "full" : "smallest",
+                       static_cast <unsigned long long> (pCheck->getErrors()), pCheck->getFirstError().c_str());
+            }
+            ResVc.emplace_back(fFull ? "factors_full" : "factors_smallest",
+                               !pCheck->getErrors() && nSmallestVc.size() == nNumbers);
+        }
+
+        return ResVc;
+    }
+
+    /**
+     * @brief Compare all positions and random queries (isPrime, rank, nextPrime) of the reader with the index. Numbers
+     *        of queries are taken from intervals and from gaps around them
+     * @param Reader Reader of shared memory
+     * @param Index Index over the published result
+     * @param IntVc Sorted merged intervals of the result
+     * @param nSeed Seed of the random generator
+     * @return true if all answers are the same
+     */
+    bool compareReader(const SharedPrimesReader &Reader, const PrimesIndex &Index, const std::vector <Interval> &IntVc,
+                       uint64_t nSeed)
+    {
+        std::mt19937_64 Random(nSeed);
+        uint64_t nCount = Index.count();
+        bool fOk(Reader.count() == nCount);
+
+        for(uint64_t i = 0; fOk && i < nCount; ++i)
+        {
+            fOk = (Reader.nthPrime(i) == Index.nthPrime(i));
+        }
+
+        for(uint64_t q = 0; fOk && q < g_nIndexQueries; ++q)
+        {
+            const Interval &Int = IntVc[Random() % IntVc.size()];
+            uint64_t nVal = Int.m_nLowIntervalSide + Random() % (Int.m_nHighIntervalSide - Int.m_nLowIntervalSide + 1);
+
+            if(q % 8 == 0)
+            {
+                nVal = (q % 16 ? Int.m_nHighIntervalSide + Random() % 1000 : Int.m_nLowIntervalSide - Random() % 1000);
+            }
+
+            uint64_t nRank = Index.rank(nVal);
+            fOk = Reader.rank(nVal) == nRank && Reader.nextPrime(nVal) == Index.nextPrime(nVal) &&
+                  Reader.isPrime(nVal) == (nRank && nVal && nRank - Index.rank(nVal - 1) == 1);
+        }
+
+        return fOk;
+    }
+
+    /**
+     * @brief Publish two results one after another in shared memory and compare SharedPrimesReader with PrimesIndex.
+     *        The reader must go on with the first generation after the second one is published, and switch to it
+     *        by refresh(). Segments are unlinked at the end
+     * @param None
+     * @return Names of checks and results (empty without POSIX shared memory)
+     */
+    std::vector <std::pair <std::string, bool> > checkSharedReader()
+    {
+        std::vector <std::pair <std::string, bool> > ResVc;
+#ifdef __linux__
+        std::string sName = "/benchmark_primes_" + std::to_string(getpid());
+        std::vector <Interval> FirstVc = { Interval(0, 300000), Interval(10000000000ULL, 10000300000ULL),
+                                           Interval(1000000000000ULL, 1000000010000ULL) };
+        std::vector <Interval> SecondVc = { Interval(1000000000, 1000500000) };
+        FindPrimes First(&FirstVc), Second(&SecondVc);
+        PrimesIndex FirstIndex(First.m_pPrimeNumVector), SecondIndex(Second.m_pPrimeNumVector);
+        SharedPrimesExport Export(sName.c_str());
+
+        uint64_t nGeneration = Export.publish(First.m_pPrimeNumVector, FirstIndex);
+        SharedPrimesReader Reader(sName.c_str());
+        ResVc.emplace_back("shared_first", Reader.getGeneration() == nGeneration &&
+                                           compareReader(Reader, FirstIndex, FirstVc, 1));
+
+        nGeneration = Export.publish(Second.m_pPrimeNumVector, SecondIndex);
+        ResVc.emplace_back("shared_old", Reader.getGeneration() == nGeneration - 1 &&
+                                         compareReader(Reader, FirstIndex, FirstVc, 2));
+        ResVc.emplace_back("shared_switched", Reader.refresh() && Reader.getGeneration() == nGeneration &&
+                                              compareReader(Reader, SecondIndex, SecondVc, 3));
+
+        shm_unlink((sName + '.' + std::to_string(nGeneration)).c_str());
+        shm_unlink(sName.c_str());
+#endif
+
+        return ResVc;
+    }
+
+    /**
+     * @brief Write results as CSV: one row for every workload
+     * @param pFileName Name of the file
+     * @param ResVc Results
+     * @return true if the file has been written
+     */
+    bool writeCsv(const char *pFileName, const std::vector <Result> &ResVc)
+    {
+        std::ofstream out(pFileName);
+
+        out << "workload,intervals,merged,numbers,primes,checksum,ok";
+        for(const char *pStage : g_pStageNames)
+        {
+            out << ',' << pStage << "_ns";
+        }
+        out << '\n';
+
+        for(const Result &Res : ResVc)
+        {
+            out << Res.m_sName << ',' << Res.m_nIntervals << ',' << Res.m_nMerged << ',' << Res.m_nNumbers << ','
+                << Res.m_nPrimes << ',' << Res.m_Check.m_nChecksum << ',' << (Res.m_fOk ? 1 : 0);
+            for(uint64_t nTime : Res.m_nTimes)
+            {
+                out << ',' << nTime;
+            }
+            out << '\n';
+        }
+
+        return static_cast <bool> (out);
+    }
+
+    /**
+     * @brief Write results as JSON
+     * @param pFileName Name of the file
+     * @param Opt Options
+     * @param ResVc Results
+     * @param SimdVc Results of the SIMD check (may be empty)
+     * @param ChecksVc Results of verification steps of the features (may be empty)
+     * @return true if the file has been written
+     */
+    bool writeJson(const char *pFileName, const Options &Opt, const std::vector <Result> &ResVc,
+                   const std::vector <std::pair <std::string, bool> > &SimdVc,
+                   const std::vector <std::pair <std::string, bool> > &ChecksVc)
+    {
+        std::ofstream out(pFileName);
+
+        out << "{\n  \"scale\": " << Opt.m_fScale << ",\n  \"seed\": " << Opt.m_nSeed << ",\n  \"repeat\": "
+            << Opt.m_nRepeat << ",\n  \"simd_variant\": \"" << SimdKernels::get().m_pName << "\",\n  \"workloads\": [";
+
+        for(size_t i = 0; i < ResVc.size(); ++i)
+        {
+            const Result &Res = ResVc[i];
+
+            out << (i ? ",\n" : "\n") << "    { \"name\": \"" << Res.m_sName << "\", \"intervals\": " << Res.m_nIntervals
+                << ", \"merged\": " << Res.m_nMerged << ", \"numbers\": " << Res.m_nNumbers << ", \"primes\": "
+                << Res.m_nPrimes << ", \"checksum\": \"" << Res.m_Check.m_nChecksum << "\", \"ok\": "
+                << (Res.m_fOk ? "true" : "false") << ", \"stages_ns\": {";
+            for(uint32_t j = 0; j < STAGES_NUM; ++j)
+            {
+                out << (j ? ", \"" : " \"") << g_pStageNames[j] << "\": " << Res.m_nTimes[j];
+            }
+            out << " } }";
+        }
+
+        out << "\n  ],\n  \"simd\": [";
+        for(size_t i = 0; i < SimdVc.size(); ++i)
+        {
+            out << (i ? ", " : " ") << "{ \"name\": \"" << SimdVc[i].first << "\", \"ok\": "
+                << (SimdVc[i].second ? "true" : "false") << " }";
+        }
+        out << " ],\n  \"checks\": [";
+        for(size_t i = 0; i < ChecksVc.size(); ++i)
+        {
+            out << (i ? ", " : " ") << "{ \"name\": \"" << ChecksVc[i].first << "\", \"ok\": "
+                << (ChecksVc[i].second ? "true" : "false") << " }";
+        }
+        out << " ]\n}\n";
+
+        return static_cast <bool> (out);
+    }
+
+    /**
+     * @brief Check the file of primes (for example, the checked-in primes.xml) for the file of intervals
+     * @param pIntName Name of the file of intervals
+     * @param pPrimesName Name of the file of primes
+     * @return Exit code
+     */
+    int verifyFiles(const char *pIntName, const char *pPrimesName)
+    {
+        std::vector <Interval> IntVc;
+        ReadXml Xml(pIntName, { "root" });
+
+        Xml.setOutput(new IntervalsOutput(&IntVc));
+        Xml.output();
+
+        FileCursor File(pPrimesName);
+        if(!File.isOpen())
+        {
+            std::cerr << "File opening error!\n";
+            return 1;
+        }
+
+        CheckResult Res = checkPrimes(IntVc, { &File });
+        std::cout << "Expected primes: " << Res.m_nCount << ", mismatches: " << Res.m_nErrorsVc[0] << '\n';
+        if(Res.m_nErrorsVc[0])
+        {
+            std::cout << "First mismatch: " << Res.m_FirstErrorVc[0] << '\n';
+        }
+
+        return (Res.m_nErrorsVc[0] ? 1 : 0);
+    }
+
+    /**
+     * @brief Search primes of one workload with all combinations of the settings
+     * @param Work Workload
+     * @param Opt Options
+     * @return Exit code
+     */
+    int runSweep(const Workload &Work, const Options &Opt)
+    {
+        std::string sInName = Opt.m_sDir + "/bench_" + Work.m_sName + ".xml";
+        std::vector <Interval> IntVc;
+
+        if(!WorkloadGenerator::writeXml(Work, sInName.c_str()))
+        {
+            std::cerr << "Can't write " << sInName << '\n';
+            return 1;
+        }
+
+        {
+            ReadXml Xml(sInName.c_str(), { "root" });
+            Xml.setOutput(new IntervalsOutput(&IntVc));
+            Xml.output();
+        }
+        remove(sInName.c_str());
+
+        Sweep Runs(&IntVc, Opt.m_nRepeat);
+        Runs.run(Opt.m_nThreadsVc, Opt.m_nWheelsVc, Opt.m_nSegmentsVc);
+        printf("workload %s, hardware threads %u\n", Work.m_sName.c_str(), std::thread::hardware_concurrency());
+        Runs.print();
+
+        if(Opt.m_pJsonName && !Runs.writeJson(Opt.m_pJsonName, Work.m_sName.c_str()))
+        {
+            std::cerr << "Can't write " << Opt.m_pJsonName << '\n';
+        }
+        if(!Runs.isConsistent())
+        {
+            printf("Numbers of primes differ between runs!\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Parse comma separated list of numbers
+     * @param pList List
+     * @param fLog2 Values are powers of 2
+     * @param nValsVc Container to write values in
+     * @return false if the list is empty or has zero values
+     */
+    bool parseList(const char *pList, bool fLog2, std::vector <uint32_t> &nValsVc)
+    {
+        nValsVc.clear();
+        for(char *pEnd; *pList; pList = (*pEnd ? pEnd + 1 : pEnd))
+        {
+            unsigned long nVal = strtoul(pList, &pEnd, 10);
+            if(pEnd == pList || !nVal || (fLog2 && nVal > 31))
+            {
+                return false;
+            }
+            nValsVc.push_back(fLog2 ? 1U << nVal : nVal);
+        }
+
+        return !nValsVc.empty();
+    }
+
+    /**
+     * @brief Parse command line options
+     * @param argc Number of arguments
+     * @param argv Arguments
+     * @param Opt Options to fill in
+     * @return false if the arguments are wrong
+     */
+    bool parseOptions(int argc, char *argv[], Options &Opt)
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            bool fHasValue = (i + 1 < argc);
+
+            if(!strcmp(argv[i], "--scale") && fHasValue)
+            {
+                Opt.m_fScale = atof(argv[++i]);
+            }
+            else if(!strcmp(argv[i], "--seed") && fHasValue)
+            {
+                Opt.m_nSeed = strtoull(argv[++i], nullptr, 10);
+            }
+            else if(!strcmp(argv[i], "--repeat") && fHasValue)
+            {
+                Opt.m_nRepeat = std::max(1, atoi(argv[++i]));
+            }
+            else if(!strcmp(argv[i], "--workload") && fHasValue)
+            {
+                Opt.m_sWorkload = argv[++i];
+            }
+            else if(!strcmp(argv[i], "--dir") && fHasValue)
+            {
+                Opt.m_sDir = argv[++i];
+            }
+            else if(!strcmp(argv[i], "--csv") && fHasValue)
+            {
+                Opt.m_pCsvName = argv[++i];
+            }
+            else if(!strcmp(argv[i], "--json") && fHasValue)
+            {
+                Opt.m_pJsonName = argv[++i];
+            }
+            else if(!strcmp(argv[i], "--simd"))
+            {
+                Opt.m_fSimd = true;
+            }
+            else if(!strcmp(argv[i], "--checks"))
+            {
+                Opt.m_fChecks = true;
+            }
+            else if(!strcmp(argv[i], "--pipelined"))
+            {
+                Opt.m_fPipelined = true;
+            }
+            else if(!strcmp(argv[i], "--sweep"))
+            {
+                Opt.m_fSweep = true;
+            }
+            else if(!strcmp(argv[i], "--threads") && fHasValue)
+            {
+                if(!parseList(argv[++i], false, Opt.m_nThreadsVc))
+                {
+                    return false;
+                }
+            }
+            else if(!strcmp(argv[i], "--wheels") && fHasValue)
+            {
+                if(!parseList(argv[++i], false, Opt.m_nWheelsVc))
+                {
+                    return false;
+                }
+            }
+            else if(!strcmp(argv[i], "--segments") && fHasValue)
+            {
+                if(!parseList(argv[++i], true, Opt.m_nSegmentsVc))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if(Opt.m_nThreadsVc.empty())                        // Powers of 2 up to twice the hardware threads
+        {
+            for(uint32_t n = 1, p = 2 * std::max(1U, std::thread::hardware_concurrency()); n <= p; n *= 2)
+            {
+                Opt.m_nThreadsVc.push_back(n);
+            }
+        }
+
+        return Opt.m_fScale > 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Options Opt;
+
+    if(argc == 4 && !strcmp(argv[1], "--verify"))
+    {
+        return verifyFiles(argv[2], argv[3]);
+    }
+
+    if(!parseOptions(argc, argv, Opt))
+    {
+        std::cerr << "Usage: benchmark [--scale X] [--seed N] [--repeat N] [--workload NAME] [--dir DIR] [--csv FILE] "
+                     "[--json FILE] [--simd] [--pipelined] [--checks]\n       benchmark --sweep [--threads 1,2,4] [--wheels 3,4,5] "
+                     "[--segments 16,18,20] [options]\n       benchmark --verify INTERVALS.xml PRIMES.xml\n";
+        return 2;
+    }
+
+    WorkloadGenerator Generator(Opt.m_nSeed, Opt.m_fScale);
+    std::vector <Workload> WorkVc = Generator.generate();
+
+    if(!Opt.m_sWorkload.empty())                            // Long workloads are run only when they are chosen by name
+    {
+        std::vector <Workload> LongVc = Generator.generateLong();
+        WorkVc.insert(WorkVc.end(), LongVc.begin(), LongVc.end());
+    }
+
+    if(Opt.m_fSweep)
+    {
+        std::string sName = (Opt.m_sWorkload.empty() ? "dense_low" : Opt.m_sWorkload);
+
+        for(const Workload &Work : WorkVc)
+        {
+            if(Work.m_sName == sName)
+            {
+                return runSweep(Work, Opt);
+            }
+        }
+
+        std::cerr << "Unknown workload " << sName << '\n';
+        return 2;
+    }
+
+    std::vector <Result> ResVc;
+    std::vector <std::pair <std::string, bool> > SimdVc, ChecksVc;
+    bool fOk(true);
+
+    printf("%-12s %9s %12s %10s %4s", "workload", "intervals", "numbers", "primes", "ok");
+    for(const char *pStage : g_pStageNames)
+    {
+        printf(" %11s", pStage);
+    }
+    printf("   (ms)\n");
+
+    for(const Workload &Work : WorkVc)
+    {
+        if(!Opt.m_sWorkload.empty() && Opt.m_sWorkload != Work.m_sName)
+        {
+            continue;
+        }
+
+        ResVc.push_back(runWorkload(Work, Opt));
+
+        const Result &Res = ResVc.back();
+        printf("%-12s %9llu %12llu %10llu %4s", Res.m_sName.c_str(), static_cast <unsigned long long> (Res.m_nIntervals),
+               static_cast <unsigned long long> (Res.m_nNumbers), static_cast <unsigned long long> (Res.m_nPrimes),
+               Res.m_fOk ? "yes" : "NO");
+        for(uint64_t nTime : Res.m_nTimes)
+        {
+            printf(" %11.3f", nTime / 1e6);
+        }
+        printf("\n");
+
+        for(size_t i = 0; i < Res.m_Check.m_nErrorsVc.size(); ++i)
+        {
+            if(Res.m_Check.m_nErrorsVc[i])
+            {
+                printf("    %s: %llu mismatches, first: %s\n", Res.m_Check.m_pNamesVc[i],
+                       static_cast <unsigned long long> (Res.m_Check.m_nErrorsVc[i]), Res.m_Check.m_FirstErrorVc[i].c_str());
+            }
+        }
+        fOk = fOk && Res.m_fOk;
+    }
+
+    if(Opt.m_fSimd)
+    {
+        SimdVc = checkSimd();
+        for(const std::pair <std::string, bool> &Var : SimdVc)
+        {
+            printf("simd %-8s %s\n", Var.first.c_str(), Var.second ? "ok" : "MISMATCH");
+            fOk = fOk && Var.second;
+        }
+    }
+
+    if(Opt.m_fChecks)
+    {
+        ChecksVc = checkTuples();
+        for(const std::pair <std::string, bool> &Check : checkFactors())
+        {
+            ChecksVc.push_back(Check);
+        }
+        for(const std::pair <std::string, bool> &Check : checkSharedReader())
+        {
+            ChecksVc.push_back(Check);
+        }
+        for(const std::pair <std::string, bool> &Check : ChecksVc)
+        {
+            printf("check %-16s %s\n", Check.first.c_str(), Check.second ? "ok" : "MISMATCH");
+            fOk = fOk && Check.second;
+        }
+    }
+
+    if(Opt.m_pCsvName && !writeCsv(Opt.m_pCsvName, ResVc))
+    {
+        std::cerr << "Can't write " << Opt.m_pCsvName << '\n';
+    }
+    if(Opt.m_pJsonName && !writeJson(Opt.m_pJsonName, Opt, ResVc, SimdVc, ChecksVc))
+    {
+        std::cerr << "Can't write " << Opt.m_pJsonName << '\n';
+    }
+
+    return (fOk ? 0 : 1);
+}
+
+//*****************************************************************************************
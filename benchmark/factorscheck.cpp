@@ -0,0 +1,161 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorscheck.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class FactorsOutput which checks factors of FactorSieve instead of writing
+  *          them. All factors of every number must be primes (by Miller-Rabin) in ascending order, and their product
+  *          with powers must be the number. The smallest factor of every number is kept, so the smallest factor mode
+  *          is checked with the result of the full mode
+  **************************************************************************************************************************
+*/
+
+#include "factorscheck.h"
+#include "millerrabin.h"
+
+/**
+ * @brief Class FactorsCheck constructor
+ * @param pSmallestVc Container of smallest factors: it is filled in the full mode and read in the smallest factor mode
+ */
+FactorsCheck::FactorsCheck(std::vector <uint64_t> *pSmallestVc): FactorsOutput(), m_pSmallestVc(pSmallestVc), m_nNext(0),
+    m_fFull(true), m_nErrors(0) {}
+
+/**
+ * @brief Class FactorsCheck destructor
+ */
+FactorsCheck::~FactorsCheck() {}
+
+/**
+ * @brief Start of the stream of factors
+ * @param fFull All factors, otherwise the smallest one only
+ * @return None
+ */
+void FactorsCheck::begin(bool fFull)
+{
+    m_fFull = fFull;
+    m_nNext = 0;
+    if(m_fFull)
+    {
+        m_pSmallestVc->clear();
+    }
+}
+
+/**
+ * @brief Check factors of numbers of the segment
+ * @param Segment Factors of the segment
+ * @return None
+ */
+void FactorsCheck::write(const FactorsSegment &Segment)
+{
+    for(uint32_t j = 0; j < Segment.m_nCount; ++j)
+    {
+        uint64_t nVal = Segment.m_nLow + j;
+
+        if(m_fFull)
+        {
+            if(!checkFactors(nVal, Segment, j))
+            {
+                addError(nVal, "wrong factors");
+            }
+            m_pSmallestVc->push_back(Segment.m_nFirstVc[j] < Segment.m_nFirstVc[j + 1] ?
+                                     Segment.m_nPrimesVc[Segment.m_nFirstVc[j]] : 0);
+        }
+        else if(m_nNext == m_pSmallestVc->size())
+        {
+            addError(nVal, "extra number");
+        }
+        else if(Segment.m_nSmallestVc[j] != (*m_pSmallestVc)[m_nNext++])
+        {
+            addError(nVal, "wrong smallest factor");
+        }
+    }
+}
+
+/**
+ * @brief End of the stream of factors: all numbers of the full mode must be passed by the smallest factor mode
+ * @param None
+ * @return None
+ */
+void FactorsCheck::end()
+{
+    if(!m_fFull && m_nNext != m_pSmallestVc->size())
+    {
+        addError(m_nNext, "missing numbers after the position");
+    }
+}
+
+/**
+ * @brief Returns the number of mismatches of both modes
+ * @param None
+ * @return Mismatches
+ */
+uint64_t FactorsCheck::getErrors() const
+{
+    return m_nErrors;
+}
+
+/**
+ * @brief Returns the first mismatch
+ * @param None
+ * @return Number and the mismatch (empty if there are no mismatches)
+ */
+const std::string &FactorsCheck::getFirstError() const
+{
+    return m_sFirstError;
+}
+
+/**
+ * @brief Check factors of the number: 0 and 1 have no factors, factors of others are primes in ascending order and
+ *        divide the number exactly with their powers
+ * @param nVal Number
+ * @param Segment Factors of the segment
+ * @param nIdx Index of the number in the segment
+ * @return true if factors are right
+ */
+bool FactorsCheck::checkFactors(uint64_t nVal, const FactorsSegment &Segment, uint32_t nIdx) const
+{
+    uint32_t nFirst = Segment.m_nFirstVc[nIdx], nEnd = Segment.m_nFirstVc[nIdx + 1];
+    uint64_t nRest = nVal, nPrev(0);
+
+    if(nVal < 2)
+    {
+        return nFirst == nEnd;
+    }
+
+    for(uint32_t k = nFirst; k < nEnd; ++k)
+    {
+        uint64_t nPrime = Segment.m_nPrimesVc[k];
+
+        if(nPrime <= nPrev || !Segment.m_nPowersVc[k] || !MillerRabin::isPrime(nPrime))
+        {
+            return false;
+        }
+        for(uint32_t m = 0; m < Segment.m_nPowersVc[k]; ++m, nRest /= nPrime)
+        {
+            if(nRest % nPrime)
+            {
+                return false;
+            }
+        }
+        nPrev = nPrime;
+    }
+
+    return nRest == 1;
+}
+
+/**
+ * @brief Count the mismatch, the first one is kept
+ * @param nVal Number
+ * @param pWhat Mismatch
+ * @return None
+ */
+void FactorsCheck::addError(uint64_t nVal, const char *pWhat)
+{
+    if(!m_nErrors++)
+    {
+        m_sFirstError = std::to_string(nVal) + ": " + pWhat;
+    }
+}
+
+//*****************************************************************************************
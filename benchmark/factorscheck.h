@@ -0,0 +1,49 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorscheck.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class FactorsOutput which checks factors of FactorSieve instead of writing
+  *          them. All factors of every number must be primes (by Miller-Rabin) in ascending order, and their product
+  *          with powers must be the number. The smallest factor of every number is kept, so the smallest factor mode
+  *          is checked with the result of the full mode
+  **************************************************************************************************************************
+*/
+
+#ifndef FACTORSCHECK_H
+#define FACTORSCHECK_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "factorsoutput.hpp"
+
+class FactorsCheck: public FactorsOutput
+{
+public:
+    FactorsCheck(std::vector <uint64_t> *pSmallestVc);
+    ~FactorsCheck() override;
+
+    void begin(bool fFull) override;
+    void write(const FactorsSegment &Segment) override;
+    void end() override;
+
+    uint64_t getErrors() const;
+    const std::string &getFirstError() const;
+
+private:
+    std::vector <uint64_t> *m_pSmallestVc;                  // The smallest factor of every number of the full mode (0 for 0 and 1)
+    size_t m_nNext;                                         // Next number of m_pSmallestVc in the smallest factor mode
+    bool m_fFull;
+    uint64_t m_nErrors;
+    std::string m_sFirstError;
+
+    bool checkFactors(uint64_t nVal, const FactorsSegment &Segment, uint32_t nIdx) const;
+    void addError(uint64_t nVal, const char *pWhat);
+};
+
+#endif // FACTORSCHECK_H
+
+//*****************************************************************************************
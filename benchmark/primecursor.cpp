@@ -0,0 +1,190 @@
+/**
+  *************************************************************************************************************************
+  * @file    primecursor.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Sequential readers of prime numbers to compare them with the reference sieve: from PrimeNumbersVector of the
+  *          engine by chunks, from the xml file written by PrimesFileOutput, from PrimeGenerator prime by prime and from
+  *          PrimesIndex position by position
+  **************************************************************************************************************************
+*/
+
+#include <cstring>
+
+#include "primecursor.h"
+
+/**
+ * @brief Class EngineCursor constructor
+ * @param pPrimeNumVc Result of the engine
+ */
+EngineCursor::EngineCursor(const PrimeNumbersVector *pPrimeNumVc): PrimeCursor(), m_pPrimeNumVc(pPrimeNumVc), m_nPos(0),
+    m_nBufPos(0) {}
+
+/**
+ * @brief Class EngineCursor destructor
+ */
+EngineCursor::~EngineCursor() {}
+
+/**
+ * @brief Get the next prime, positions are taken by chunks
+ * @param nPrime Prime
+ * @return false when primes are over
+ */
+bool EngineCursor::next(uint64_t &nPrime)
+{
+    while(m_nBufPos == m_BufVc.size())
+    {
+        if(m_nPos >= m_pPrimeNumVc->size())
+        {
+            return false;
+        }
+
+        m_pPrimeNumVc->getPrimes(m_nPos, m_nChunkSize, m_BufVc);
+        m_nPos += m_nChunkSize;
+        m_nBufPos = 0;
+    }
+
+    nPrime = m_BufVc[m_nBufPos++];
+
+    return true;
+}
+
+/**
+ * @brief Class FileCursor constructor
+ * @param pFileName Name of the file written by PrimesFileOutput
+ */
+FileCursor::FileCursor(const char *pFileName): PrimeCursor(), m_pFile(fopen(pFileName, "rb")), m_fInPrimes(false) {}
+
+/**
+ * @brief Class FileCursor destructor
+ */
+FileCursor::~FileCursor()
+{
+    if(m_pFile)
+    {
+        fclose(m_pFile);
+    }
+}
+
+/**
+ * @brief Check whether the file has been opened
+ * @param None
+ * @return true if opened
+ */
+bool FileCursor::isOpen() const
+{
+    return m_pFile != nullptr;
+}
+
+/**
+ * @brief Next character of the file
+ * @param None
+ * @return Character or EOF
+ */
+int FileCursor::getChar()
+{
+    return getc(m_pFile);
+}
+
+/**
+ * @brief Get the next number of the <primes> tag
+ * @param nPrime Prime
+ * @return false when primes are over
+ */
+bool FileCursor::next(uint64_t &nPrime)
+{
+    static const char *pTag = "<primes>";
+    int c;
+
+    if(!m_pFile)
+    {
+        return false;
+    }
+
+    for(size_t nMatched = 0; !m_fInPrimes; )                            // Skip everything before <primes>
+    {
+        if((c = getChar()) == EOF)
+        {
+            return false;
+        }
+        nMatched = (c == pTag[nMatched] ? nMatched + 1 : (c == pTag[0] ? 1 : 0));
+        m_fInPrimes = (nMatched == strlen(pTag));
+    }
+
+    while((c = getChar()) != EOF && (c < '0' || c > '9'))
+    {
+        if(c == '<')
+        {
+            return false;                                                // End of the tag
+        }
+    }
+
+    if(c == EOF)
+    {
+        return false;
+    }
+
+    for(nPrime = 0; c >= '0' && c <= '9'; c = getChar())
+    {
+        nPrime = nPrime * 10 + (c - '0');
+    }
+
+    if(c == '<')
+    {
+        ungetc(c, m_pFile);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Class GeneratorCursor constructor
+ * @param pIntVc Sorted merged intervals (they must live as long as the cursor)
+ */
+GeneratorCursor::GeneratorCursor(std::vector <Interval> *pIntVc): PrimeCursor(), m_Generator(pIntVc) {}
+
+/**
+ * @brief Class GeneratorCursor destructor
+ */
+GeneratorCursor::~GeneratorCursor() {}
+
+/**
+ * @brief Get the next prime of the generator
+ * @param nPrime Prime
+ * @return false when primes are over
+ */
+bool GeneratorCursor::next(uint64_t &nPrime)
+{
+    return m_Generator.next(nPrime);
+}
+
+/**
+ * @brief Class IndexCursor constructor
+ * @param pIndex Index over the result of the engine
+ */
+IndexCursor::IndexCursor(const PrimesIndex *pIndex): PrimeCursor(), m_pIndex(pIndex), m_nPos(0) {}
+
+/**
+ * @brief Class IndexCursor destructor
+ */
+IndexCursor::~IndexCursor() {}
+
+/**
+ * @brief Get the next prime by its number
+ * @param nPrime Prime
+ * @return false when primes are over
+ */
+bool IndexCursor::next(uint64_t &nPrime)
+{
+    if(m_nPos == m_pIndex->count())
+    {
+        return false;
+    }
+
+    nPrime = m_pIndex->nthPrime(m_nPos++);
+
+    return true;
+}
+
+//*****************************************************************************************
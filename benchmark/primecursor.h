@@ -0,0 +1,93 @@
+/**
+  *************************************************************************************************************************
+  * @file    primecursor.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Sequential readers of prime numbers to compare them with the reference sieve: from PrimeNumbersVector of the
+  *          engine by chunks, from the xml file written by PrimesFileOutput, from PrimeGenerator prime by prime and from
+  *          PrimesIndex position by position
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMECURSOR_H
+#define PRIMECURSOR_H
+
+#include <cstdio>
+#include <vector>
+#include <stdint.h>
+
+#include "primenumbersvector.h"
+#include "primegenerator.h"
+#include "primesindex.h"
+
+class PrimeCursor
+{
+public:
+    PrimeCursor() {}
+    virtual ~PrimeCursor() {}
+
+    virtual bool next(uint64_t &nPrime) = 0;                // false when primes are over
+};
+
+class EngineCursor: public PrimeCursor
+{
+public:
+    EngineCursor(const PrimeNumbersVector *pPrimeNumVc);
+    ~EngineCursor() override;
+
+    bool next(uint64_t &nPrime) override;
+
+private:
+    static constexpr size_t m_nChunkSize = 1 << 20;         // Positions taken at once
+
+    const PrimeNumbersVector *m_pPrimeNumVc;
+    std::vector <uint64_t> m_BufVc;
+    size_t m_nPos;                                          // Next position of PrimeNumbersVector
+    size_t m_nBufPos;                                       // Next prime of the buffer
+};
+
+class FileCursor: public PrimeCursor
+{
+public:
+    FileCursor(const char *pFileName);
+    ~FileCursor() override;
+
+    bool isOpen() const;
+    bool next(uint64_t &nPrime) override;
+
+private:
+    FILE *m_pFile;
+    bool m_fInPrimes;                                       // Contents of <primes> tag is being read
+
+    int getChar();
+};
+
+class GeneratorCursor: public PrimeCursor
+{
+public:
+    GeneratorCursor(std::vector <Interval> *pIntVc);
+    ~GeneratorCursor() override;
+
+    bool next(uint64_t &nPrime) override;
+
+private:
+    PrimeGenerator m_Generator;                             // Sieves chunks only when their primes are taken
+};
+
+class IndexCursor: public PrimeCursor
+{
+public:
+    IndexCursor(const PrimesIndex *pIndex);
+    ~IndexCursor() override;
+
+    bool next(uint64_t &nPrime) override;
+
+private:
+    const PrimesIndex *m_pIndex;
+    uint64_t m_nPos;                                        // Number of the next prime
+};
+
+#endif // PRIMECURSOR_H
+
+//*****************************************************************************************
@@ -0,0 +1,163 @@
+/**
+  *************************************************************************************************************************
+  * @file    referencesieve.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Plain segmented Eratosthenes Sieve over the intervals to check results of the engine. It shares no code with
+  *          the engine (no wheel, no pre-sieve, no buckets, no direct test). Close intervals are sieved together
+  **************************************************************************************************************************
+*/
+
+#include <cmath>
+
+#include "referencesieve.h"
+
+/**
+ * @brief Class ReferenceSieve constructor
+ * @param pIntVc Sorted merged intervals
+ */
+ReferenceSieve::ReferenceSieve(const std::vector <Interval> *pIntVc): m_pIntVc(pIntVc)
+{
+    findBasePrimes();
+}
+
+/**
+ * @brief Class ReferenceSieve destructor
+ */
+ReferenceSieve::~ReferenceSieve() {}
+
+/**
+ * @brief Find primes up to square root of the max number by the simple Eratosthenes Sieve
+ * @param None
+ * @return None
+ */
+void ReferenceSieve::findBasePrimes()
+{
+    uint64_t nMax = (m_pIntVc->empty() ? 0 : m_pIntVc->back().m_nHighIntervalSide);
+    uint64_t nRoot = sqrtl(nMax);
+
+    while(nRoot * nRoot > nMax)
+    {
+        --nRoot;
+    }
+    while(nRoot < 0xFFFFFFFFULL && (nRoot + 1) * (nRoot + 1) <= nMax)
+    {
+        ++nRoot;
+    }
+
+    std::vector <bool> fCompositeVc(nRoot + 1, false);
+    for(uint64_t i = 2; i <= nRoot; ++i)
+    {
+        if(!fCompositeVc[i])
+        {
+            m_nBasePrimesVc.push_back(i);
+            for(uint64_t j = i * i; j <= nRoot; j += i)
+            {
+                fCompositeVc[j] = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Give primes of all intervals to the callback in ascending order
+ * @param Func Callback
+ * @return None
+ */
+void ReferenceSieve::run(const Callback &Func) const
+{
+    size_t nInt(0);
+
+    for(size_t i = 0, p = m_pIntVc->size(); i < p; )
+    {
+        uint64_t nLow = (*m_pIntVc)[i].m_nLowIntervalSide, nHigh = (*m_pIntVc)[i].m_nHighIntervalSide;
+
+        for(++i; i < p && (*m_pIntVc)[i].m_nLowIntervalSide - nHigh <= m_nJoinGap; ++i)
+        {
+            nHigh = (*m_pIntVc)[i].m_nHighIntervalSide;                     // Join close intervals into one window
+        }
+
+        sieveWindow(nLow, nHigh, nInt, Func);
+    }
+}
+
+/**
+ * @brief Sieve numbers nLow...nHigh segment by segment and give primes which belong to intervals to the callback
+ * @param nLow First number of the window
+ * @param nHigh Last number of the window
+ * @param nInt Index of the first interval which is not passed yet
+ * @param Func Callback
+ * @return None
+ */
+void ReferenceSieve::sieveWindow(uint64_t nLow, uint64_t nHigh, size_t &nInt, const Callback &Func) const
+{
+    std::vector <uint8_t> fCompositeVc;
+    std::vector <uint64_t> PrimesVc;
+    uint64_t nSegSize = m_nSegmentSize;
+
+    if(nSegSize < m_nBasePrimesVc.size() / 4)
+    {
+        nSegSize = m_nBasePrimesVc.size() / 4;                             // Near 2^64 every segment passes 2e8 base primes
+    }
+
+    for(uint64_t nSegLow = nLow; ; nSegLow += nSegSize)
+    {
+        uint64_t nSegHigh = (nHigh - nSegLow < nSegSize ? nHigh : nSegLow + nSegSize - 1);
+
+        fCompositeVc.assign(nSegHigh - nSegLow + 1, 0);
+        for(uint64_t nPrime : m_nBasePrimesVc)
+        {
+            if(nPrime * nPrime > nSegHigh)
+            {
+                break;
+            }
+
+            uint64_t nQuot = nSegLow / nPrime + (nSegLow % nPrime ? 1 : 0);
+            if(nQuot > nSegHigh / nPrime)
+            {
+                continue;                                                   // No multiples in the segment
+            }
+
+            uint64_t j = nQuot * nPrime;
+            if(j < nPrime * nPrime)
+            {
+                j = nPrime * nPrime;
+            }
+
+            for(; j <= nSegHigh; j += nPrime)
+            {
+                fCompositeVc[j - nSegLow] = 1;
+                if(nSegHigh - j < nPrime)
+                {
+                    break;                                                  // The next multiple may overflow
+                }
+            }
+        }
+
+        PrimesVc.clear();
+        for(uint64_t n = nSegLow; ; ++n)
+        {
+            while(nInt < m_pIntVc->size() && (*m_pIntVc)[nInt].m_nHighIntervalSide < n)
+            {
+                ++nInt;
+            }
+            if(n >= 2 && !fCompositeVc[n - nSegLow] && nInt < m_pIntVc->size() && n >= (*m_pIntVc)[nInt].m_nLowIntervalSide)
+            {
+                PrimesVc.push_back(n);
+            }
+            if(n == nSegHigh)
+            {
+                break;
+            }
+        }
+        Func(PrimesVc);
+
+        if(nSegHigh == nHigh)
+        {
+            break;
+        }
+    }
+}
+
+//*****************************************************************************************
@@ -0,0 +1,44 @@
+/**
+  *************************************************************************************************************************
+  * @file    referencesieve.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Plain segmented Eratosthenes Sieve over the intervals to check results of the engine. It shares no code with
+  *          the engine (no wheel, no pre-sieve, no buckets, no direct test). Close intervals are sieved together
+  **************************************************************************************************************************
+*/
+
+#ifndef REFERENCESIEVE_H
+#define REFERENCESIEVE_H
+
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+#include "interval.hpp"
+
+class ReferenceSieve
+{
+public:
+    typedef std::function <void (const std::vector <uint64_t> &)> Callback;    // Gets primes of every segment in order
+
+    ReferenceSieve(const std::vector <Interval> *pIntVc);
+    ~ReferenceSieve();
+
+    void run(const Callback &Func) const;
+
+private:
+    static constexpr uint64_t m_nSegmentSize = 1 << 20;    // Numbers sieved at once
+    static constexpr uint64_t m_nJoinGap = 1 << 16;        // Intervals closer than the gap are sieved together
+
+    const std::vector <Interval> *m_pIntVc;                 // Sorted merged intervals
+    std::vector <uint32_t> m_nBasePrimesVc;                 // Primes up to square root of the max number
+
+    void findBasePrimes();
+    void sieveWindow(uint64_t nLow, uint64_t nHigh, size_t &nInt, const Callback &Func) const;
+};
+
+#endif // REFERENCESIEVE_H
+
+//*****************************************************************************************
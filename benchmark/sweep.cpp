@@ -0,0 +1,171 @@
+/**
+  *************************************************************************************************************************
+  * @file    sweep.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Parameter sweep of the sieve: the same intervals are searched by FindPrimes for every combination of number of
+  *          threads, size of the wheel and size of the segment. For every run speedup and parallel efficiency against
+  *          the smallest number of threads with the same wheel and segment, memory of the search and imbalance of
+  *          threads (time of the slowest thread to the mean time) are reported
+  **************************************************************************************************************************
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include "sweep.h"
+#include "findprimes.h"
+
+/**
+ * @brief Class Sweep constructor
+ * @param pIntVc Sorted merged intervals
+ * @param nRepeat Number of repeats of every run
+ */
+Sweep::Sweep(const std::vector <Interval> *pIntVc, uint32_t nRepeat): m_pIntVc(pIntVc), m_nRepeat(nRepeat) {}
+
+/**
+ * @brief Class Sweep destructor
+ */
+Sweep::~Sweep() {}
+
+/**
+ * @brief Search primes with the settings several times
+ * @param Settings Settings of the sieve
+ * @return Result of the fastest repeat
+ */
+Sweep::Run Sweep::measure(const SieveSettings &Settings) const
+{
+    Run Best;
+    std::vector <Interval> IntVc(*m_pIntVc);                // FindPrimes takes not constant intervals
+
+    Best.m_nTime = 0;
+    for(uint32_t r = 0; r < m_nRepeat; ++r)
+    {
+        std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+        FindPrimes Primes(&IntVc, Settings);
+        uint64_t nTime = std::chrono::duration_cast <std::chrono::nanoseconds> (std::chrono::steady_clock::now() - Start).count();
+
+        if(!r || nTime < Best.m_nTime)
+        {
+            std::vector <uint64_t> nThreadTimesVc = Primes.getThreadTimes();
+            uint64_t nSum(0), nMax(0);
+
+            for(uint64_t nThreadTime : nThreadTimesVc)
+            {
+                nSum += nThreadTime;
+                nMax = (nThreadTime > nMax ? nThreadTime : nMax);
+            }
+
+            Best.m_Requested = Settings;
+            Best.m_Used = Primes.getSettings();
+            Best.m_nTime = nTime;
+            Best.m_nPrimes = Primes.m_pPrimeNumVector->count();
+            Best.m_nMemory = Primes.getMemoryUsage();
+            Best.m_fImbalance = (nSum ? static_cast <double> (nMax) * nThreadTimesVc.size() / nSum : 1.0);
+        }
+    }
+
+    return Best;
+}
+
+/**
+ * @brief Run the search for every combination of the settings. Speedup and efficiency are counted against the first
+ *        number of threads of the list with the same wheel and segment
+ * @param nThreadsVc Numbers of threads
+ * @param nWheelsVc Numbers of primes of the wheel
+ * @param nSegmentsVc Sizes of the segment in bits
+ * @return None
+ */
+void Sweep::run(const std::vector <uint32_t> &nThreadsVc, const std::vector <uint32_t> &nWheelsVc,
+                const std::vector <uint32_t> &nSegmentsVc)
+{
+    for(uint32_t nWheel : nWheelsVc)
+    {
+        for(uint32_t nSegment : nSegmentsVc)
+        {
+            size_t nBase = m_RunsVc.size();
+
+            for(uint32_t nThreads : nThreadsVc)
+            {
+                m_RunsVc.push_back(measure(SieveSettings(nThreads, nWheel, nSegment)));
+
+                Run &Cur = m_RunsVc.back();
+                const Run &Base = m_RunsVc[nBase];
+                uint32_t nUsed = (Cur.m_Used.m_nThreads ? Cur.m_Used.m_nThreads : 1);
+                uint32_t nBaseUsed = (Base.m_Used.m_nThreads ? Base.m_Used.m_nThreads : 1);
+
+                Cur.m_fSpeedup = (Cur.m_nTime ? static_cast <double> (Base.m_nTime) / Cur.m_nTime : 1.0);
+                Cur.m_fEfficiency = Cur.m_fSpeedup * nBaseUsed / nUsed;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check that all runs have found the same number of primes
+ * @param None
+ * @return true if numbers are equal
+ */
+bool Sweep::isConsistent() const
+{
+    for(const Run &Cur : m_RunsVc)
+    {
+        if(Cur.m_nPrimes != m_RunsVc.front().m_nPrimes)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Print runs as the table
+ * @param None
+ * @return None
+ */
+void Sweep::print() const
+{
+    printf("%7s %5s %9s %10s %10s %8s %10s %10s %9s\n", "threads", "wheel", "segment", "time_ms", "primes", "speedup",
+           "efficiency", "memory_mb", "imbalance");
+
+    for(const Run &Cur : m_RunsVc)
+    {
+        printf("%7u %5u %9u %10.3f %10llu %8.2f %10.2f %10.2f %9.2f\n", Cur.m_Used.m_nThreads, Cur.m_Used.m_nWheelPrimes,
+               Cur.m_Used.m_nSegmentSize, Cur.m_nTime / 1e6, static_cast <unsigned long long> (Cur.m_nPrimes),
+               Cur.m_fSpeedup, Cur.m_fEfficiency, Cur.m_nMemory / 1048576.0, Cur.m_fImbalance);
+    }
+}
+
+/**
+ * @brief Write runs as JSON
+ * @param pFileName Name of the file
+ * @param pWorkload Name of the workload
+ * @return true if the file has been written
+ */
+bool Sweep::writeJson(const char *pFileName, const char *pWorkload) const
+{
+    std::ofstream out(pFileName);
+
+    out << "{\n  \"workload\": \"" << pWorkload << "\",\n  \"repeat\": " << m_nRepeat << ",\n  \"consistent\": "
+        << (isConsistent() ? "true" : "false") << ",\n  \"runs\": [";
+
+    for(size_t i = 0; i < m_RunsVc.size(); ++i)
+    {
+        const Run &Cur = m_RunsVc[i];
+
+        out << (i ? ",\n" : "\n") << "    { \"threads\": " << Cur.m_Used.m_nThreads << ", \"wheel_primes\": "
+            << Cur.m_Used.m_nWheelPrimes << ", \"segment_bits\": " << Cur.m_Used.m_nSegmentSize
+            << ", \"requested_threads\": " << Cur.m_Requested.m_nThreads << ", \"time_ns\": " << Cur.m_nTime
+            << ", \"primes\": " << Cur.m_nPrimes << ", \"speedup\": " << Cur.m_fSpeedup << ", \"efficiency\": "
+            << Cur.m_fEfficiency << ", \"memory_bytes\": " << Cur.m_nMemory << ", \"imbalance\": " << Cur.m_fImbalance
+            << " }";
+    }
+    out << "\n  ]\n}\n";
+
+    return static_cast <bool> (out);
+}
+
+//*****************************************************************************************
@@ -0,0 +1,58 @@
+/**
+  *************************************************************************************************************************
+  * @file    sweep.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Parameter sweep of the sieve: the same intervals are searched by FindPrimes for every combination of number of
+  *          threads, size of the wheel and size of the segment. For every run speedup and parallel efficiency against
+  *          the smallest number of threads with the same wheel and segment, memory of the search and imbalance of
+  *          threads (time of the slowest thread to the mean time) are reported
+  **************************************************************************************************************************
+*/
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+#include "interval.hpp"
+#include "sievesettings.hpp"
+
+class Sweep
+{
+public:
+    struct Run
+    {
+        SieveSettings m_Requested;                          // Settings given to FindPrimes
+        SieveSettings m_Used;                               // Settings really used by FindPrimes
+        uint64_t m_nTime;                                   // Best time of the search in nanoseconds
+        uint64_t m_nPrimes;                                 // Number of found primes
+        size_t m_nMemory;                                   // Bytes of the search
+        double m_fSpeedup;
+        double m_fEfficiency;
+        double m_fImbalance;                                // Time of the slowest thread to the mean time (1 is ideal)
+    };
+
+    Sweep(const std::vector <Interval> *pIntVc, uint32_t nRepeat);
+    ~Sweep();
+
+    void run(const std::vector <uint32_t> &nThreadsVc, const std::vector <uint32_t> &nWheelsVc,
+             const std::vector <uint32_t> &nSegmentsVc);
+    bool isConsistent() const;                              // All runs have found the same number of primes
+    void print() const;
+    bool writeJson(const char *pFileName, const char *pWorkload) const;
+
+private:
+    const std::vector <Interval> *m_pIntVc;                 // Sorted merged intervals
+    uint32_t m_nRepeat;                                     // Number of repeats of every run (the best time is taken)
+    std::vector <Run> m_RunsVc;
+
+    Run measure(const SieveSettings &Settings) const;
+};
+
+#endif // SWEEP_H
+
+//*****************************************************************************************
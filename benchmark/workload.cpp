@@ -0,0 +1,157 @@
+/**
+  *************************************************************************************************************************
+  * @file    workload.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Deterministic interval workloads for the benchmark: dense low range, sparse high windows, many tiny intervals
+  *          and one giant interval. The same seed and scale give the same intervals on every platform (values are taken
+  *          from std::mt19937_64 directly, without distributions). Long workloads (the window at the top of 64-bit
+  *          numbers) are run only when they are chosen by name
+  **************************************************************************************************************************
+*/
+
+#include <cstdio>
+
+#include "workload.h"
+
+/**
+ * @brief Class WorkloadGenerator constructor
+ * @param nSeed Seed of the random generator
+ * @param fScale Multiplier of sizes of workloads
+ */
+WorkloadGenerator::WorkloadGenerator(uint64_t nSeed, double fScale): m_nSeed(nSeed), m_fScale(fScale) {}
+
+/**
+ * @brief Class WorkloadGenerator destructor
+ */
+WorkloadGenerator::~WorkloadGenerator() {}
+
+/**
+ * @brief Scaled size, at least 1
+ * @param fVal Size for the scale 1
+ * @return Scaled size
+ */
+uint64_t WorkloadGenerator::scaled(double fVal) const
+{
+    double fRes = fVal * m_fScale;
+
+    return (fRes < 1 ? 1 : static_cast <uint64_t> (fRes));
+}
+
+/**
+ * @brief Generate workloads of the default run
+ * @param None
+ * @return Workloads
+ */
+std::vector <Workload> WorkloadGenerator::generate() const
+{
+    return { denseLow(), sparseHigh(), tinyMany(), giant() };
+}
+
+/**
+ * @brief Generate workloads which are too long for every run, they are run only when they are chosen by name
+ * @param None
+ * @return Workloads
+ */
+std::vector <Workload> WorkloadGenerator::generateLong() const
+{
+    return { topEdge() };
+}
+
+/**
+ * @brief One range from 0: the wheel primes, pre-sieve and small primes dominate
+ * @param None
+ * @return Workload
+ */
+Workload WorkloadGenerator::denseLow() const
+{
+    return { "dense_low", { Interval(0, scaled(2e7)) } };
+}
+
+/**
+ * @brief Narrow windows scattered over 1e12...1e15: the start of initial primes and the direct test dominate
+ * @param None
+ * @return Workload
+ */
+Workload WorkloadGenerator::sparseHigh() const
+{
+    std::mt19937_64 Rand(m_nSeed + 1);
+    Workload Work = { "sparse_high", {} };
+
+    for(uint64_t i = 0, p = scaled(100); i < p; ++i)
+    {
+        uint64_t nLow = 1000000000000ULL + Rand() % 999000000000000ULL;
+        Work.m_IntVc.emplace_back(nLow, nLow + Rand() % 100000);
+    }
+
+    return Work;
+}
+
+/**
+ * @brief Many intervals up to 64 numbers wide below 1e8, some of them overlap: parsing and merging dominate
+ * @param None
+ * @return Workload
+ */
+Workload WorkloadGenerator::tinyMany() const
+{
+    std::mt19937_64 Rand(m_nSeed + 2);
+    Workload Work = { "tiny_many", {} };
+
+    for(uint64_t i = 0, p = scaled(200000); i < p; ++i)
+    {
+        uint64_t nLow = Rand() % 100000000;
+        Work.m_IntVc.emplace_back(nLow, nLow + Rand() % 64);
+    }
+
+    return Work;
+}
+
+/**
+ * @brief One wide interval above 1e9: crossing off by the bucket sieve dominates
+ * @param None
+ * @return Workload
+ */
+Workload WorkloadGenerator::giant() const
+{
+    return { "giant", { Interval(1000000000, 1000000000 + scaled(3e8)) } };
+}
+
+/**
+ * @brief One window which ends at the max 64-bit number: initial primes up to 2^32 and crossing off near the overflow.
+ *        The planner sieves the window from the scale 1 (narrower windows are tested directly)
+ * @param None
+ * @return Workload
+ */
+Workload WorkloadGenerator::topEdge() const
+{
+    return { "top_edge", { Interval(18446744073709551615ULL - scaled(1e9) + 1, 18446744073709551615ULL) } };
+}
+
+/**
+ * @brief Write the workload as the xml file for ReadXml
+ * @param Work Workload
+ * @param pFileName Name of the file
+ * @return true if the file has been written
+ */
+bool WorkloadGenerator::writeXml(const Workload &Work, const char *pFileName)
+{
+    FILE *pFile = fopen(pFileName, "w");
+    if(!pFile)
+    {
+        return false;
+    }
+
+    fputs("<root>\n<intervals>\n", pFile);
+    for(const Interval &Int : Work.m_IntVc)
+    {
+        fprintf(pFile, "<interval><low> %llu </low><high> %llu </high></interval>\n",
+                static_cast <unsigned long long> (Int.m_nLowIntervalSide),
+                static_cast <unsigned long long> (Int.m_nHighIntervalSide));
+    }
+    fputs("</intervals>\n</root>\n", pFile);
+
+    return !fclose(pFile);
+}
+
+//*****************************************************************************************
@@ -0,0 +1,54 @@
+/**
+  *************************************************************************************************************************
+  * @file    workload.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Deterministic interval workloads for the benchmark: dense low range, sparse high windows, many tiny intervals
+  *          and one giant interval. The same seed and scale give the same intervals on every platform (values are taken
+  *          from std::mt19937_64 directly, without distributions). Long workloads (the window at the top of 64-bit
+  *          numbers) are run only when they are chosen by name
+  **************************************************************************************************************************
+*/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <stdint.h>
+
+#include "interval.hpp"
+
+struct Workload
+{
+    std::string m_sName;
+    std::vector <Interval> m_IntVc;                         // Intervals as they are written to xml (not merged)
+};
+
+class WorkloadGenerator
+{
+public:
+    WorkloadGenerator(uint64_t nSeed, double fScale);
+    ~WorkloadGenerator();
+
+    std::vector <Workload> generate() const;                // Workloads of the default run
+    std::vector <Workload> generateLong() const;            // Workloads run only when they are chosen by name
+    static bool writeXml(const Workload &Work, const char *pFileName);
+
+private:
+    uint64_t m_nSeed;
+    double m_fScale;                                        // Multiplier of sizes of workloads
+
+    uint64_t scaled(double fVal) const;
+    Workload denseLow() const;
+    Workload sparseHigh() const;
+    Workload tinyMany() const;
+    Workload giant() const;
+    Workload topEdge() const;
+};
+
+#endif // WORKLOAD_H
+
+//*****************************************************************************************
@@ -0,0 +1,236 @@
+/**
+  *************************************************************************************************************************
+  * @file    bucketsieve.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Bucket sieve (T. Oliveira e Silva) for initial primes which are bigger than the segment of the spoke.
+  *          Such prime hits every segment at most once, so instead of looping over all of them for each segment,
+  *          every prime is filed into the bucket of the segment of its next hit. Buckets are taken from the pool
+  *          and returned into it after the segment has been sieved
+  **************************************************************************************************************************
+*/
+
+#include "bucketsieve.h"
+#include "arena.h"
+#include "sievewords.hpp"
+
+/**
+ * @brief Class BucketPool constructor
+ * @param None
+ */
+BucketPool::BucketPool(): m_pFree(nullptr) {}
+
+/**
+ * @brief Class BucketPool destructor
+ */
+BucketPool::~BucketPool()
+{
+    for(Bucket *pBlock : m_BlocksVc)
+    {
+        Arena::get().release(pBlock);                   // The block is reused by the next pool
+    }
+}
+
+/**
+ * @brief Take empty bucket from the pool, allocate new block of buckets if the pool is empty
+ * @param None
+ * @return pBucket Empty bucket
+ */
+Bucket *BucketPool::get()
+{
+    if(!m_pFree)
+    {
+        Bucket *pBlock = static_cast <Bucket*> (Arena::get().allocate(m_nBucketsPerBlock * sizeof(Bucket)));
+        m_BlocksVc.push_back(pBlock);
+
+        for(uint32_t i = 0; i < m_nBucketsPerBlock; ++i)
+        {
+            pBlock[i].m_pNext = m_pFree;
+            m_pFree = &pBlock[i];
+        }
+    }
+
+    Bucket *pBucket = m_pFree;
+    m_pFree = pBucket->m_pNext;
+    pBucket->m_pNext = nullptr;
+    pBucket->m_nCount = 0;
+
+    return pBucket;
+}
+
+/**
+ * @brief Return the list of buckets into the pool. Memory is kept for the next segments
+ * @param pBucket First bucket of the list
+ * @return None
+ */
+void BucketPool::put(Bucket *pBucket)
+{
+    while(pBucket)
+    {
+        Bucket *pNext = pBucket->m_pNext;
+        pBucket->m_pNext = m_pFree;
+        m_pFree = pBucket;
+        pBucket = pNext;
+    }
+}
+
+/**
+ * @brief Returns memory of all blocks of buckets allocated by the pool
+ * @param None
+ * @return Bytes
+ */
+size_t BucketPool::getMemoryUsage() const
+{
+    return m_BlocksVc.size() * m_nBucketsPerBlock * sizeof(Bucket);
+}
+
+/**
+ * @brief Class BucketSieve constructor
+ * @param nSegmentSize Number of bits in the segment
+ */
+BucketSieve::BucketSieve(uint32_t nSegmentSize): m_nSlotsMask(0), m_nSegmentSize(nSegmentSize) {}
+
+/**
+ * @brief Class BucketSieve destructor
+ */
+BucketSieve::~BucketSieve()
+{
+    reset(0);
+}
+
+/**
+ * @brief Drop all pending hits and prepare slots for the new range. The next hit of the prime nMaxPrime
+ *        is not further than nMaxPrime / m_nSegmentSize + 1 segments, so it is enough slots to never overlap
+ * @param nMaxPrime Max prime which will be filed into the buckets
+ * @return None
+ */
+void BucketSieve::reset(uint32_t nMaxPrime)
+{
+    for(size_t i = 0, p = m_SlotsVc.size(); i < p; ++i)
+    {
+        m_Pool.put(m_SlotsVc[i]);
+        m_SlotsVc[i] = nullptr;
+    }
+
+    uint64_t nSlots(1);
+    while(nSlots < nMaxPrime / m_nSegmentSize + 2)
+    {
+        nSlots <<= 1;
+    }
+
+    if(nSlots > m_SlotsVc.size())
+    {
+        m_SlotsVc.resize(nSlots, nullptr);
+    }
+    m_nSlotsMask = nSlots - 1;
+}
+
+/**
+ * @brief Put the hit into the bucket of the segment
+ * @param nSegment Number of the segment
+ * @param nPrime Initial prime
+ * @param nOffset Position of the hit inside the segment
+ * @return None
+ */
+inline void BucketSieve::push(uint64_t nSegment, uint32_t nPrime, uint32_t nOffset)
+{
+    Bucket *&pHead = m_SlotsVc[nSegment & m_nSlotsMask];
+
+    if(!pHead || Bucket::m_nCapacity == pHead->m_nCount)
+    {
+        Bucket *pBucket = m_Pool.get();
+        pBucket->m_pNext = pHead;
+        pHead = pBucket;
+    }
+
+    BucketEntry &Entry = pHead->m_Entries[pHead->m_nCount++];
+    Entry.m_nPrime = nPrime;
+    Entry.m_nOffset = nOffset;
+}
+
+/**
+ * @brief File the prime into the bucket of the segment of its first hit
+ * @param nPrime Initial prime (must be not less than the segment size)
+ * @param nHit Position of the first hit from the beginning of the range
+ * @return None
+ */
+void BucketSieve::addPrime(uint32_t nPrime, uint64_t nHit)
+{
+    push(nHit / m_nSegmentSize, nPrime, nHit % m_nSegmentSize);
+}
+
+/**
+ * @brief Cross off all hits which have been filed for the segment and file every prime into the bucket of its next hit
+ * @param nSegment Number of the segment from the beginning of the range
+ * @param pWords Bits of the spoke
+ * @param nFirstBit Bit of the spoke which corresponds to the beginning of the segment
+ * @param nSegmentLen Number of bits in the segment (the last segment of the range may be shorter)
+ * @return None
+ */
+void BucketSieve::sieveSegment(uint64_t nSegment, uint64_t *pWords, uint64_t nFirstBit, uint32_t nSegmentLen)
+{
+    Bucket *pBucket = m_SlotsVc[nSegment & m_nSlotsMask];
+    m_SlotsVc[nSegment & m_nSlotsMask] = nullptr;
+
+    for(Bucket *pCur = pBucket; pCur; pCur = pCur->m_pNext)
+    {
+        for(uint32_t i = 0, p = pCur->m_nCount; i < p; ++i)
+        {
+            const BucketEntry &Entry = pCur->m_Entries[i];
+            if(Entry.m_nOffset < nSegmentLen)
+            {
+                setSieveBit(pWords, nFirstBit + Entry.m_nOffset);
+            }
+
+            uint64_t nNext = static_cast <uint64_t> (Entry.m_nOffset) + Entry.m_nPrime;    // Next hit is at least in the next segment
+            push(nSegment + nNext / m_nSegmentSize, Entry.m_nPrime, nNext % m_nSegmentSize);
+        }
+    }
+
+    m_Pool.put(pBucket);
+}
+
+/**
+ * @brief Give all hits which have been filed for the segment to the caller (to divide the numbers by the primes instead
+ *        of crossing off bits) and file every prime into the bucket of its next hit
+ * @param nSegment Number of the segment from the beginning of the range
+ * @param nSegmentLen Number of numbers in the segment (the last segment of the range may be shorter)
+ * @param HitsVc Container to write hits in (it is cleared before)
+ * @return None
+ */
+void BucketSieve::collectSegment(uint64_t nSegment, uint32_t nSegmentLen, std::vector <BucketEntry> &HitsVc)
+{
+    Bucket *pBucket = m_SlotsVc[nSegment & m_nSlotsMask];
+    m_SlotsVc[nSegment & m_nSlotsMask] = nullptr;
+
+    HitsVc.clear();
+    for(Bucket *pCur = pBucket; pCur; pCur = pCur->m_pNext)
+    {
+        for(uint32_t i = 0, p = pCur->m_nCount; i < p; ++i)
+        {
+            const BucketEntry &Entry = pCur->m_Entries[i];
+            if(Entry.m_nOffset < nSegmentLen)
+            {
+                HitsVc.push_back(Entry);
+            }
+
+            uint64_t nNext = static_cast <uint64_t> (Entry.m_nOffset) + Entry.m_nPrime;
+            push(nSegment + nNext / m_nSegmentSize, Entry.m_nPrime, nNext % m_nSegmentSize);
+        }
+    }
+
+    m_Pool.put(pBucket);
+}
+
+/**
+ * @brief Returns memory of the buckets and of the slots of the segments
+ * @param None
+ * @return Bytes
+ */
+size_t BucketSieve::getMemoryUsage() const
+{
+    return m_Pool.getMemoryUsage() + m_SlotsVc.capacity() * sizeof(Bucket*);
+}
+
+//*****************************************************************************************
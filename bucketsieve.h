@@ -0,0 +1,76 @@
+/**
+  *************************************************************************************************************************
+  * @file    bucketsieve.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Bucket sieve (T. Oliveira e Silva) for initial primes which are bigger than the segment of the spoke.
+  *          Such prime hits every segment at most once, so instead of looping over all of them for each segment,
+  *          every prime is filed into the bucket of the segment of its next hit. Buckets are taken from the pool
+  *          and returned into it after the segment has been sieved
+  **************************************************************************************************************************
+*/
+
+#ifndef BUCKETSIEVE_H
+#define BUCKETSIEVE_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+struct BucketEntry
+{
+    uint32_t m_nPrime;                                      // Initial prime
+    uint32_t m_nOffset;                                     // Position of the next hit inside the segment
+};
+
+struct Bucket
+{
+    static constexpr uint32_t m_nCapacity = 1024;           // Number of entries in one bucket
+
+    Bucket *m_pNext;                                        // Next bucket of the same segment
+    uint32_t m_nCount;                                      // Number of filled entries
+    BucketEntry m_Entries[m_nCapacity];
+};
+
+class BucketPool
+{
+public:
+    BucketPool();
+    ~BucketPool();
+
+    Bucket *get();                                          // Take empty bucket from the pool
+    void put(Bucket *pBucket);                              // Return the list of buckets into the pool
+    size_t getMemoryUsage() const;                          // Bytes of all allocated buckets
+
+private:
+    static constexpr uint32_t m_nBucketsPerBlock = 64;      // Number of buckets allocated at once
+
+    std::vector <Bucket*> m_BlocksVc;                       // Blocks of buckets taken from Arena
+    Bucket *m_pFree;                                        // List of free buckets
+};
+
+class BucketSieve
+{
+public:
+    BucketSieve(uint32_t nSegmentSize);
+    ~BucketSieve();
+
+    void reset(uint32_t nMaxPrime);                         // Drop pending hits and prepare slots for primes up to nMaxPrime
+    void addPrime(uint32_t nPrime, uint64_t nHit);          // File prime with the first hit nHit (from the range beginning)
+    void sieveSegment(uint64_t nSegment, uint64_t *pWords, uint64_t nFirstBit, uint32_t nSegmentLen);
+    void collectSegment(uint64_t nSegment, uint32_t nSegmentLen, std::vector <BucketEntry> &HitsVc);  // Hits are given back
+    size_t getMemoryUsage() const;                          // Bytes of the buckets and the slots
+
+private:
+    BucketPool m_Pool;                                      // Storage of the buckets
+    std::vector <Bucket*> m_SlotsVc;                        // Lists of buckets for the next segments (circular)
+    uint64_t m_nSlotsMask;                                  // Number of slots - 1 (number of slots is power of 2)
+    uint32_t m_nSegmentSize;                                // Number of bits in the segment
+
+    void push(uint64_t nSegment, uint32_t nPrime, uint32_t nOffset);
+};
+
+#endif // BUCKETSIEVE_H
+
+//*****************************************************************************************
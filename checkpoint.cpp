@@ -0,0 +1,181 @@
+/**
+  *************************************************************************************************************************
+  * @file    checkpoint.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class of the checkpoint of the pipelined search: number of chunks written, number of primes and size of the
+  *          output file, and the fingerprint of intervals and parameters. The file is replaced atomically: the new state
+  *          is written to the temporary file, synced to the disk and renamed, so it is never seen half-written
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "checkpoint.h"
+
+/**
+ * @brief Class Checkpoint constructor
+ * @param pFileName Name of the file of the checkpoint
+ * @param nFingerprint Hash of intervals and parameters which define the output
+ */
+Checkpoint::Checkpoint(const char *pFileName, uint64_t nFingerprint): m_sFileName(pFileName), m_nFingerprint(nFingerprint) {}
+
+/**
+ * @brief Class Checkpoint destructor
+ */
+Checkpoint::~Checkpoint() {}
+
+/**
+ * @brief Next value of the fingerprint: FNV-1a hash of bytes of the value
+ * @param nHash Current value (m_nHashSeed at first)
+ * @param nVal Value to add
+ * @return New value
+ */
+uint64_t Checkpoint::hash(uint64_t nHash, uint64_t nVal)
+{
+    for(uint32_t i = 0; i < 8; ++i, nVal >>= 8)
+    {
+        nHash = (nHash ^ (nVal & 0xFF)) * 1099511628211ULL;
+    }
+
+    return nHash;
+}
+
+/**
+ * @brief Read the checkpoint
+ * @param St State to fill
+ * @return true if the file exists, it is whole and it has the same fingerprint
+ */
+bool Checkpoint::load(State &St) const
+{
+    std::ifstream In(m_sFileName, std::ios::in | std::ios::binary);
+    char cMagic[8];
+    uint32_t nVersion(0);
+    uint64_t nFieldsVc[m_nFields];
+
+    if(!In || !In.read(cMagic, sizeof(cMagic)) || memcmp(cMagic, "PRMCHECK", 8) ||
+       !In.read(reinterpret_cast <char*> (&nVersion), sizeof(nVersion)) || nVersion != m_nVersion ||
+       !In.read(reinterpret_cast <char*> (nFieldsVc), sizeof(nFieldsVc)))
+    {
+        return false;
+    }
+
+    uint64_t nCheck(m_nHashSeed);
+    for(uint32_t i = 0; i + 1 < m_nFields; ++i)
+    {
+        nCheck = hash(nCheck, nFieldsVc[i]);
+    }
+
+    if(nCheck != nFieldsVc[m_nFields - 1] || nFieldsVc[0] != m_nFingerprint)
+    {
+        return false;                                                       // Damaged file or another search
+    }
+
+    St.m_nChunks = nFieldsVc[1];
+    St.m_nPrimes = nFieldsVc[2];
+    St.m_nOffset = nFieldsVc[3];
+    return true;
+}
+
+/**
+ * @brief Write the checkpoint atomically: the temporary file is written, synced and renamed to the checkpoint.
+ *        Data of the output must be synced before, so the checkpoint never points beyond the data on the disk
+ * @param St State to write
+ * @return None
+ */
+void Checkpoint::save(const State &St) const
+{
+    std::string sTmpName = m_sFileName + ".tmp";
+    uint64_t nFieldsVc[m_nFields] = { m_nFingerprint, St.m_nChunks, St.m_nPrimes, St.m_nOffset, m_nHashSeed };
+    uint32_t nVersion(m_nVersion);
+
+    for(uint32_t i = 0; i + 1 < m_nFields; ++i)
+    {
+        nFieldsVc[m_nFields - 1] = hash(nFieldsVc[m_nFields - 1], nFieldsVc[i]);
+    }
+
+    {
+        std::ofstream Out(sTmpName, std::ios::out | std::ios::binary | std::ios::trunc);
+        Out.write("PRMCHECK", 8);
+        Out.write(reinterpret_cast <const char*> (&nVersion), sizeof(nVersion));
+        Out.write(reinterpret_cast <const char*> (nFieldsVc), sizeof(nFieldsVc));
+
+        if(!Out.flush())
+        {
+            std::cerr << "Checkpoint writing error!\n";
+            exit(1);
+        }
+    }
+
+    syncFile(sTmpName.c_str());
+    if(std::rename(sTmpName.c_str(), m_sFileName.c_str()))
+    {
+        std::cerr << "Checkpoint writing error!\n";
+        exit(1);
+    }
+
+    size_t nSlash = m_sFileName.find_last_of('/');                          // The new name must be on the disk too
+    syncFile(nSlash == std::string::npos ? "." : m_sFileName.substr(0, nSlash ? nSlash : 1).c_str());
+}
+
+/**
+ * @brief Remove the checkpoint after the whole output has been written
+ * @param None
+ * @return None
+ */
+void Checkpoint::remove() const
+{
+    std::remove(m_sFileName.c_str());
+}
+
+/**
+ * @brief Write data of the file (or of the directory) to the disk. Streams must be flushed before
+ * @param pFileName Name of the file
+ * @return None
+ */
+void Checkpoint::syncFile(const char *pFileName)
+{
+#ifdef __linux__
+    int nFd = open(pFileName, O_RDONLY);
+
+    if(nFd >= 0)
+    {
+        fsync(nFd);
+        close(nFd);
+    }
+#else
+    (void)pFileName;
+#endif
+}
+
+/**
+ * @brief Cut the file to the size. Data after the checkpoint are written again, so without truncate() they are only
+ *        overwritten by the same bytes
+ * @param pFileName Name of the file
+ * @param nSize New size
+ * @return None
+ */
+void Checkpoint::truncateFile(const char *pFileName, uint64_t nSize)
+{
+#ifdef __linux__
+    if(truncate(pFileName, nSize))
+    {
+        std::cerr << "File truncating error!\n";
+        exit(1);
+    }
+#else
+    (void)pFileName;
+    (void)nSize;
+#endif
+}
+
+//*****************************************************************************************
@@ -0,0 +1,52 @@
+/**
+  *************************************************************************************************************************
+  * @file    checkpoint.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class of the checkpoint of the pipelined search: number of chunks written, number of primes and size of the
+  *          output file, and the fingerprint of intervals and parameters. The file is replaced atomically: the new state
+  *          is written to the temporary file, synced to the disk and renamed, so it is never seen half-written
+  **************************************************************************************************************************
+*/
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <stdint.h>
+
+class Checkpoint
+{
+public:
+    struct State
+    {
+        uint64_t m_nChunks;                                 // Chunks written completely
+        uint64_t m_nPrimes;                                 // Primes written
+        uint64_t m_nOffset;                                 // Bytes of the output file after these primes
+    };
+
+    Checkpoint(const char *pFileName, uint64_t nFingerprint);
+    ~Checkpoint();
+
+    bool load(State &St) const;                             // false if there is no right checkpoint of this fingerprint
+    void save(const State &St) const;
+    void remove() const;
+
+    static uint64_t hash(uint64_t nHash, uint64_t nVal);    // Next value of the fingerprint (FNV-1a)
+    static void syncFile(const char *pFileName);            // Write data of the file to the disk
+    static void truncateFile(const char *pFileName, uint64_t nSize);
+
+    static constexpr uint64_t m_nHashSeed = 14695981039346656037ULL;
+
+private:
+    static constexpr uint32_t m_nVersion = 1;               // Version of the file
+    static constexpr uint32_t m_nFields = 5;                // Fingerprint, state, checksum
+
+    std::string m_sFileName;
+    uint64_t m_nFingerprint;
+};
+
+#endif // CHECKPOINT_H
+
+//*****************************************************************************************
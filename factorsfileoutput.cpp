@@ -0,0 +1,150 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorsfileoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class FactorsOutput which writes records (n, factors) to the file.
+  *          Factors are prime factors with repetitions in ascending order, or the smallest prime factor only
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+
+#include "factorsfileoutput.h"
+#include "profiler.h"
+
+/**
+ * @brief Class FactorsFileOutput constructor
+ * @param pFileName Name of the file to write in
+ * @param fBinary Write the binary file instead of XML
+ */
+FactorsFileOutput::FactorsFileOutput(const char *pFileName, bool fBinary): FactorsOutput(), m_pFileName(pFileName),
+    m_fBinary(fBinary), m_nEmitted(0) {}
+
+/**
+ * @brief Class FactorsFileOutput destructor
+ */
+FactorsFileOutput::~FactorsFileOutput() {}
+
+/**
+ * @brief Open the file and write the beginning of the list of records
+ * @param fFull All factors of every number, otherwise the smallest one only
+ * @return None
+ */
+void FactorsFileOutput::begin(bool fFull)
+{
+    m_Out.open(m_pFileName, m_fBinary ? std::ios::out | std::ios::binary : std::ios::out);
+
+    if(!m_Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    m_nEmitted = 0;
+    if(m_fBinary)
+    {
+        uint32_t nHeader[2] = { m_nVersion, fFull ? 1u : 0u };
+
+        m_Out.write("PRMFACTS", 8);
+        m_Out.write(reinterpret_cast <const char*> (nHeader), sizeof(nHeader));
+    }
+    else
+    {
+        m_Out << "<root>\n<factors>\n";
+    }
+}
+
+/**
+ * @brief Write records of the next numbers
+ * @param Segment Factors of the next numbers
+ * @return None
+ */
+void FactorsFileOutput::write(const FactorsSegment &Segment)
+{
+    m_nEmitted += Segment.m_nCount;
+    if(m_fBinary)
+    {
+        writeBinary(Segment);
+    }
+    else
+    {
+        writeXml(Segment);
+    }
+}
+
+/**
+ * @brief Write the end of the list of records and close the file
+ * @param None
+ * @return None
+ */
+void FactorsFileOutput::end()
+{
+    if(!m_fBinary)
+    {
+        m_Out << "</factors>\n</root>";
+    }
+    m_Out.close();
+
+    Profiler::get().addCounter("factor_records", m_nEmitted);
+}
+
+/**
+ * @brief Write XML records of the numbers of the segment
+ * @param Segment Factors of the next numbers
+ * @return None
+ */
+void FactorsFileOutput::writeXml(const FactorsSegment &Segment)
+{
+    for(uint32_t i = 0; i < Segment.m_nCount; ++i)
+    {
+        m_Out << "  <number><value>" << Segment.m_nLow + i << "</value>";
+        if(!Segment.m_fFull)
+        {
+            m_Out << "<smallest>" << Segment.m_nSmallestVc[i] << "</smallest></number>\n";
+            continue;
+        }
+
+        m_Out << "<factors> ";
+        for(uint32_t j = Segment.m_nFirstVc[i]; j < Segment.m_nFirstVc[i + 1]; ++j)
+        {
+            for(uint32_t k = 0; k < Segment.m_nPowersVc[j]; ++k)
+            {
+                m_Out << Segment.m_nPrimesVc[j] << ' ';
+            }
+        }
+        m_Out << "</factors></number>\n";
+    }
+}
+
+/**
+ * @brief Write binary records of the numbers of the segment
+ * @param Segment Factors of the next numbers
+ * @return None
+ */
+void FactorsFileOutput::writeBinary(const FactorsSegment &Segment)
+{
+    m_nBufferVc.clear();
+    for(uint32_t i = 0; i < Segment.m_nCount; ++i)
+    {
+        m_nBufferVc.push_back(Segment.m_nLow + i);
+        if(!Segment.m_fFull)
+        {
+            m_nBufferVc.push_back(Segment.m_nSmallestVc[i]);
+            continue;
+        }
+
+        size_t nCountPos = m_nBufferVc.size();
+        m_nBufferVc.push_back(0);
+        for(uint32_t j = Segment.m_nFirstVc[i]; j < Segment.m_nFirstVc[i + 1]; ++j)
+        {
+            m_nBufferVc.insert(m_nBufferVc.end(), Segment.m_nPowersVc[j], Segment.m_nPrimesVc[j]);
+        }
+        m_nBufferVc[nCountPos] = m_nBufferVc.size() - nCountPos - 1;
+    }
+
+    m_Out.write(reinterpret_cast <const char*> (m_nBufferVc.data()), m_nBufferVc.size() * sizeof(uint64_t));
+}
+
+//*****************************************************************************************
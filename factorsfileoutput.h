@@ -0,0 +1,49 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorsfileoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class FactorsOutput which writes records (n, factors) to the file.
+  *          Factors are prime factors with repetitions in ascending order, or the smallest prime factor only.
+  *          The XML file is <root><factors><number><value>12</value><factors>2 2 3</factors></number>...</root>
+  *          (<smallest> instead of <factors> for the smallest factor). The binary file (numbers are uint64_t in the
+  *          byte order of the machine): magic "PRMFACTS", uint32_t version, uint32_t flags (1 - all factors), then
+  *          records: n, number of factors k, k factors (the smallest factor mode: n, the smallest factor)
+  **************************************************************************************************************************
+*/
+
+#ifndef FACTORSFILEOUTPUT_H
+#define FACTORSFILEOUTPUT_H
+
+#include <vector>
+#include <fstream>
+
+#include "factorsoutput.hpp"
+
+class FactorsFileOutput: public FactorsOutput
+{
+public:
+    FactorsFileOutput(const char *pFileName, bool fBinary = false);
+    virtual ~FactorsFileOutput() override;
+
+    void begin(bool fFull) override;
+    void write(const FactorsSegment &Segment) override;
+    void end() override;
+
+private:
+    static constexpr uint32_t m_nVersion = 1;               // Version of the binary file
+
+    const char *m_pFileName;
+    bool m_fBinary;                                         // Binary file instead of XML
+    std::ofstream m_Out;                                    // File of the stream
+    std::vector <uint64_t> m_nBufferVc;                     // Records of the binary file to write at once
+    uint64_t m_nEmitted;                                    // Number of records written in the stream
+
+    void writeXml(const FactorsSegment &Segment);
+    void writeBinary(const FactorsSegment &Segment);
+};
+
+#endif // FACTORSFILEOUTPUT_H
+
+//*****************************************************************************************
@@ -0,0 +1,287 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorsieve.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class for the factorisation of all numbers of given intervals by the segmented sieve of the smallest prime
+  *          factor. Initial primes up to square root of the max number are the same as in FindPrimes, primes smaller
+  *          than the segment hit it many times, larger ones are given by the bucket sieve. Every hit either sets the
+  *          smallest factor or divides the rest of the number, the rest bigger than 1 after all hits is the largest prime
+  *          factor. Segments take about the same memory as the segment of bits of FindPrimes and are written in order
+  **************************************************************************************************************************
+*/
+
+#include <algorithm>
+
+#include "factorsieve.h"
+#include "findprimes.h"
+#include "profiler.h"
+
+/**
+ * @brief Class FactorSieve constructor. Finds initial primes and the size of the segment: the segment of FindPrimes
+ *        has m_nSegmentSize bits, the segment of factors takes the same number of bytes
+ * @param pIntVc Sorted merged intervals
+ * @param Settings Size of the segment (zero is the default size), the rest is not used
+ * @param fFull Find all factors, otherwise the smallest one only
+ */
+FactorSieve::FactorSieve(const std::vector <Interval> *pIntVc, const SieveSettings &Settings, bool fFull):
+    m_pIntVc(pIntVc), m_fFull(fFull), m_pOutput(nullptr)
+{
+    uint32_t nSegmentSize = (Settings.m_nSegmentSize ? Settings.m_nSegmentSize : SieveSettings::m_nDefaultSegmentSize);
+    if(nSegmentSize > SieveSettings::m_nMaxSegmentSize)
+    {
+        nSegmentSize = SieveSettings::m_nMaxSegmentSize;
+    }
+
+    m_nSegmentNums = nSegmentSize / 8 / (m_fFull ? m_nFullBytes : m_nSmallestBytes);
+    if(m_nSegmentNums < m_nMinSegmentNums)
+    {
+        m_nSegmentNums = m_nMinSegmentNums;
+    }
+
+    Profiler::ScopedTimer Timer("base_primes");
+    FindPrimes::findInitialPrimes(m_pIntVc->empty() ? 0 : m_pIntVc->back().m_nHighIntervalSide, m_nPrimesVc);
+}
+
+/**
+ * @brief Class FactorSieve destructor
+ */
+FactorSieve::~FactorSieve()
+{
+    if(m_pOutput)
+    {
+        delete m_pOutput;
+    }
+}
+
+/**
+ * @brief Set specific derived class from the abstract class FactorsOutput to set the output method behaviour
+ * @param pOutput Pointer to the abstract class FactorsOutput, which points to the specific derived class
+ * @return None
+ */
+void FactorSieve::setOutput(FactorsOutput *pOutput)
+{
+    if(m_pOutput)
+    {
+        delete m_pOutput;
+    }
+
+    m_pOutput = pOutput;
+}
+
+/**
+ * @brief Returns number of numbers of one segment
+ * @param None
+ * @return Numbers
+ */
+uint32_t FactorSieve::getSegmentNums() const
+{
+    return m_nSegmentNums;
+}
+
+/**
+ * @brief Factors all intervals segment by segment and writes every segment as soon as it is ready
+ * @param None
+ * @return None
+ */
+void FactorSieve::output() const
+{
+    Profiler::ScopedTimer Timer("factor_sieve");
+    BucketSieve Buckets(m_nSegmentNums);                    // Buckets are reused for all intervals
+    FactorsSegment Segment;
+    uint64_t nNumbers(0);
+
+    Segment.m_fFull = m_fFull;
+    m_pOutput->begin(m_fFull);
+    for(const Interval &Int : *m_pIntVc)
+    {
+        factorInterval(Int, Buckets, Segment);
+        nNumbers += Int.m_nHighIntervalSide - Int.m_nLowIntervalSide + 1;
+    }
+    m_pOutput->end();
+
+    Profiler::get().addCounter("numbers_factored", nNumbers);
+}
+
+/**
+ * @brief Factors numbers of the interval segment by segment. Next hits of small primes are kept from the beginning
+ *        of the interval, large primes are filed into buckets by their first multiples in the interval
+ * @param Int Interval
+ * @param Buckets Bucket sieve for the large initial primes
+ * @param Segment Memory of the segment
+ * @return None
+ */
+void FactorSieve::factorInterval(const Interval &Int, BucketSieve &Buckets, FactorsSegment &Segment) const
+{
+    uint64_t nLow = Int.m_nLowIntervalSide, nHigh = Int.m_nHighIntervalSide;
+
+    // Only primes with the square not bigger than the max number of the interval are needed
+    uint32_t nEnd = std::upper_bound(m_nPrimesVc.begin(), m_nPrimesVc.end(), nHigh,
+    [] (uint64_t nMax, uint32_t nPrime)
+    {
+        return static_cast <uint64_t> (nPrime) * nPrime > nMax;
+    }) - m_nPrimesVc.begin();
+    uint32_t nSmallEnd = std::lower_bound(m_nPrimesVc.begin(), m_nPrimesVc.begin() + nEnd, m_nSegmentNums) - m_nPrimesVc.begin();
+    std::vector <uint64_t> nNextHitVc(nSmallEnd);
+    std::vector <BucketEntry> LargeVc;
+
+    Buckets.reset(nEnd > nSmallEnd ? m_nPrimesVc[nEnd - 1] : 0);
+    for(uint32_t i = 0; i < nEnd; ++i)                      // The first multiple of every prime from the beginning
+    {
+        uint64_t nHit = (m_nPrimesVc[i] - nLow % m_nPrimesVc[i]) % m_nPrimesVc[i];
+
+        if(i < nSmallEnd)
+        {
+            nNextHitVc[i] = nHit;
+        }
+        else if(nHit <= nHigh - nLow)
+        {
+            Buckets.addPrime(m_nPrimesVc[i], nHit);
+        }
+    }
+
+    for(uint64_t nSegment = 0, nSegLow = nLow; ; ++nSegment, nSegLow += m_nSegmentNums)
+    {
+        uint32_t nCount = (nHigh - nSegLow < m_nSegmentNums ? nHigh - nSegLow + 1 : m_nSegmentNums);
+
+        Buckets.collectSegment(nSegment, nCount, LargeVc);
+        factorSegment(nSegLow, nCount, nNextHitVc, nSmallEnd, LargeVc, Segment);
+        m_pOutput->write(Segment);
+
+        for(uint64_t &nHit : nNextHitVc)
+        {
+            nHit -= nCount;                                 // Hits are kept from the beginning of the next segment
+        }
+
+        if(nHigh - nSegLow < m_nSegmentNums)
+        {
+            break;                                          // nHigh may be the max number of uint64_t
+        }
+    }
+}
+
+/**
+ * @brief Factors numbers of the segment: every hit of the prime sets the smallest factor of the number or divides its
+ *        rest. In the full mode factors are collected as hits by primes and ordered by the counting sort of numbers:
+ *        small primes come in ascending order before large ones, only large primes of the same number are sorted
+ * @param nLow The first number of the segment
+ * @param nCount Number of numbers
+ * @param nNextHitVc Next hit of every small prime from the beginning of the segment (it is moved forward)
+ * @param nSmallEnd Number of small primes
+ * @param LargeVc Hits of large primes in the segment
+ * @param Segment Container to write factors in
+ * @return None
+ */
+void FactorSieve::factorSegment(uint64_t nLow, uint32_t nCount, std::vector <uint64_t> &nNextHitVc, uint32_t nSmallEnd,
+                                const std::vector <BucketEntry> &LargeVc, FactorsSegment &Segment) const
+{
+    Segment.m_nLow = nLow;
+    Segment.m_nCount = nCount;
+
+    if(!m_fFull)
+    {
+        std::vector <uint64_t> &nSmallestVc = Segment.m_nSmallestVc;
+
+        nSmallestVc.assign(nCount, 0);
+        for(uint32_t i = 0; i < nSmallEnd; ++i)             // Small primes come in ascending order, the first one is the smallest
+        {
+            uint64_t j = nNextHitVc[i];
+            for(; j < nCount; j += m_nPrimesVc[i])
+            {
+                nSmallestVc[j] = (nSmallestVc[j] ? nSmallestVc[j] : m_nPrimesVc[i]);
+            }
+            nNextHitVc[i] = j;
+        }
+
+        for(const BucketEntry &Entry : LargeVc)
+        {
+            uint64_t &nSmallest = nSmallestVc[Entry.m_nOffset];
+            nSmallest = (nSmallest && nSmallest < Entry.m_nPrime ? nSmallest : Entry.m_nPrime);
+        }
+
+        for(uint32_t j = 0; j < nCount; ++j)
+        {
+            nSmallestVc[j] = (nLow + j < 2 ? 0 : (nSmallestVc[j] ? nSmallestVc[j] : nLow + j));   // No factor up to the root - prime
+        }
+        return;
+    }
+
+    std::vector <uint64_t> nRestVc(nCount);
+    std::vector <Hit> HitsVc;
+    std::vector <uint32_t> &nFirstVc = Segment.m_nFirstVc;
+
+    for(uint32_t j = 0; j < nCount; ++j)
+    {
+        nRestVc[j] = (nLow + j < 2 ? 1 : nLow + j);         // 0 and 1 have no factors (0 can't be divided)
+    }
+
+    auto divide = [&nRestVc, &HitsVc] (uint32_t j, uint32_t nPrime)
+    {
+        Hit Cur = { j, nPrime, 0 };
+
+        for(; nRestVc[j] % nPrime == 0; nRestVc[j] /= nPrime)
+        {
+            ++Cur.m_nPower;
+        }
+        if(Cur.m_nPower)
+        {
+            HitsVc.push_back(Cur);
+        }
+    };
+
+    for(uint32_t i = 0; i < nSmallEnd; ++i)
+    {
+        uint64_t j = nNextHitVc[i];
+        for(; j < nCount; j += m_nPrimesVc[i])
+        {
+            divide(j, m_nPrimesVc[i]);
+        }
+        nNextHitVc[i] = j;
+    }
+
+    for(const BucketEntry &Entry : LargeVc)
+    {
+        divide(Entry.m_nOffset, Entry.m_nPrime);
+    }
+
+    nFirstVc.assign(nCount + 1, 0);
+    for(const Hit &Cur : HitsVc)
+    {
+        ++nFirstVc[Cur.m_nOffset + 1];
+    }
+    for(uint32_t j = 0; j < nCount; ++j)
+    {
+        nFirstVc[j + 1] += nFirstVc[j] + (nRestVc[j] > 1 ? 1 : 0);   // The rest is the largest prime factor
+    }
+
+    Segment.m_nPrimesVc.resize(nFirstVc[nCount]);
+    Segment.m_nPowersVc.resize(nFirstVc[nCount]);
+
+    std::vector <uint32_t> nPosVc(nFirstVc.begin(), nFirstVc.end() - 1);
+    for(const Hit &Cur : HitsVc)
+    {
+        Segment.m_nPrimesVc[nPosVc[Cur.m_nOffset]] = Cur.m_nPrime;
+        Segment.m_nPowersVc[nPosVc[Cur.m_nOffset]++] = Cur.m_nPower;
+    }
+
+    for(uint32_t j = 0; j < nCount; ++j)
+    {
+        for(uint32_t k = nFirstVc[j] + 1; k < nPosVc[j]; ++k) // Insertion sort of factors (only large primes may be out of order)
+        {
+            for(uint32_t m = k; m > nFirstVc[j] && Segment.m_nPrimesVc[m - 1] > Segment.m_nPrimesVc[m]; --m)
+            {
+                std::swap(Segment.m_nPrimesVc[m - 1], Segment.m_nPrimesVc[m]);
+                std::swap(Segment.m_nPowersVc[m - 1], Segment.m_nPowersVc[m]);
+            }
+        }
+
+        if(nRestVc[j] > 1)
+        {
+            Segment.m_nPrimesVc[nPosVc[j]] = nRestVc[j];
+            Segment.m_nPowersVc[nPosVc[j]] = 1;
+        }
+    }
+}
+
+//*****************************************************************************************
@@ -0,0 +1,61 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorsieve.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class for the factorisation of all numbers of given intervals by the segmented sieve of the smallest prime
+  *          factor. Initial primes up to square root of the max number are the same as in FindPrimes, primes smaller
+  *          than the segment hit it many times, larger ones are given by the bucket sieve. Every hit either sets the
+  *          smallest factor or divides the rest of the number, the rest bigger than 1 after all hits is the largest prime
+  *          factor. Segments take about the same memory as the segment of bits of FindPrimes and are written in order
+  **************************************************************************************************************************
+*/
+
+#ifndef FACTORSIEVE_H
+#define FACTORSIEVE_H
+
+#include <vector>
+
+#include "interval.hpp"
+#include "sievesettings.hpp"
+#include "factorsoutput.hpp"
+#include "bucketsieve.h"
+
+class FactorSieve
+{
+public:
+    FactorSieve(const std::vector <Interval> *pIntVc, const SieveSettings &Settings = SieveSettings(), bool fFull = true);
+    ~FactorSieve();
+
+    void setOutput(FactorsOutput *pOutput);
+    void output() const;                                    // Every call factors numbers again
+
+    uint32_t getSegmentNums() const;                        // Numbers of one segment
+
+private:
+    struct Hit                                              // Prime factor of the number of the segment
+    {
+        uint32_t m_nOffset;                                 // Number in the segment
+        uint32_t m_nPrime;
+        uint8_t m_nPower;
+    };
+
+    static constexpr uint32_t m_nMinSegmentNums = 64;
+    static constexpr uint32_t m_nSmallestBytes = 8;         // Memory of the number of the smallest factor mode
+    static constexpr uint32_t m_nFullBytes = 48;            // Memory of the number of the full mode (the rest, about 3 hits, the record)
+
+    const std::vector <Interval> *m_pIntVc;                 // Sorted merged intervals
+    bool m_fFull;                                           // All factors, otherwise the smallest one only
+    std::vector <uint32_t> m_nPrimesVc;                     // Initial primes up to square root of the max number
+    uint32_t m_nSegmentNums;                                // Numbers of one segment
+    FactorsOutput *m_pOutput;                               // Abstract class pointer to define the output method
+
+    void factorInterval(const Interval &Int, BucketSieve &Buckets, FactorsSegment &Segment) const;
+    void factorSegment(uint64_t nLow, uint32_t nCount, std::vector <uint64_t> &nNextHitVc, uint32_t nSmallEnd,
+                       const std::vector <BucketEntry> &LargeVc, FactorsSegment &Segment) const;
+};
+
+#endif // FACTORSIEVE_H
+
+//*****************************************************************************************
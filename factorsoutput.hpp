@@ -0,0 +1,46 @@
+/**
+  *************************************************************************************************************************
+  * @file    factorsoutput.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   The abstract class to output result of the factorisation of intervals. FactorSieve gives the stream of
+  *          segments of the next numbers (begin, write..., end), every segment keeps either the smallest prime factor
+  *          of every number or all prime factors with their powers
+  **************************************************************************************************************************
+*/
+
+#ifndef FACTORSOUTPUT_HPP
+#define FACTORSOUTPUT_HPP
+
+#include <vector>
+#include <stdint.h>
+
+struct FactorsSegment
+{
+    uint64_t m_nLow;                                        // The first number of the segment
+    uint32_t m_nCount;                                      // Number of numbers
+    bool m_fFull;                                           // All factors, otherwise the smallest one only
+    std::vector <uint64_t> m_nSmallestVc;                   // The smallest prime factor of every number (0 for 0 and 1)
+    std::vector <uint32_t> m_nFirstVc;                      // Factors of the number i are m_nFirstVc[i]...m_nFirstVc[i + 1] - 1
+    std::vector <uint64_t> m_nPrimesVc;                     // Prime factors of all numbers in ascending order of every number
+    std::vector <uint8_t> m_nPowersVc;                      // Power of every prime factor
+
+    FactorsSegment(): m_nLow(0), m_nCount(0), m_fFull(true) {}
+};
+
+class FactorsOutput
+{
+public:
+
+    FactorsOutput() {}
+    virtual ~FactorsOutput() {}
+
+    virtual void begin(bool fFull) = 0;                             // Start of the stream (all factors or the smallest one)
+    virtual void write(const FactorsSegment &Segment) = 0;          // Next numbers of the stream
+    virtual void end() = 0;                                         // End of the stream
+};
+
+#endif // FACTORSOUTPUT_HPP
+
+//**************************************************************************************************************************
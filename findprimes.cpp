@@ -1,286 +1,966 @@
-/**
-  *************************************************************************************************************************
-  * @file    findprimes.cpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    23-November-2018
-  * @brief   Class for searching prime numbers in given intervals
-  **************************************************************************************************************************
-*/
-
-
-#include <cmath>
-
-#include "findprimes.h"
-
-/**
- * @brief Class FindPrimes constructor
- * @param pIntVec Intervals vector pointer
- */
-FindPrimes::FindPrimes(std::vector<Interval> *pIntVc):
-   m_pPrimeNumVector(nullptr),
-    m_pIntVc(pIntVc),
-    m_pOutput(nullptr),
-    m_nPrimor(1)                                 // Init primorial with 1 to use in multiplication operations
-
-{
-    inputDataProcessing();                       // Count number of initial prime numbers, determine how many threads to make for intervals
-    findWheelSpokes();
-
-    if(m_nPrimor)                                // If searching limits are bigger than initial prime numbers
-    {
-        m_nNumOfSpokes = m_nSpokesVc.size();
-        multyThreadPrimesSearching();            //   find prime numbers
-        m_pPrimeNumVector = new PrimeNumbersVector(&m_fVc, m_pIntVc, &m_nPrimesVc, &m_nSpokesVc, m_nPrimor, m_nBegPrimesNum);
-    }
-}
-
-/**
- * @brief Class FindPrimes destructor
- */
-FindPrimes::~FindPrimes()
-{
-    if(m_pPrimeNumVector)
-    {
-        delete m_pPrimeNumVector;
-    }
-
-    if(m_pOutput)
-    {
-        delete m_pOutput;
-    }
-}
-
-/**
- * @brief Function to count number of initial prime numbers, determine how many threads to make for intervals
- * @param None
- * @return None
- */
-void FindPrimes::inputDataProcessing()
-{
-    m_nNumOfRanges = m_pIntVc->size();
-    if(!m_nNumOfRanges)
-    {
-        return;
-    }
-
-    m_nMin = m_pIntVc->front().m_nLowIntervalSide;        //
-    m_nMax = m_pIntVc->back().m_nHighIntervalSide;        // Get limits
-
-    m_nKernels = std::thread::hardware_concurrency();     // Get number of threads to work really parallel for current computer
-    m_nNumOfThreads = 2 * m_nKernels;                     // Maximum number of threads for effective work
-    if(m_nNumOfRanges < m_nNumOfThreads)
-    {
-        m_nNumOfThreads = m_nNumOfRanges;                 // Necessary number of threads for given ranges
-    }
-
-    if(m_nNumOfThreads > 0 && m_nNumOfThreads < 3)        //
-    {                                                     //
-        if(m_nMax < 100000)                               // Make decision how many initial primes we use for searching
-        {                                                 //   depends on searching limits and intervals guantity
-            m_nBegPrimesNum = 2;                          //
-        }                                                 //
-        else if(m_nMax < 1000000)                         //
-        {                                                 //
-            m_nBegPrimesNum = 3;                          //
-        }                                                 //
-        else                                              //
-        {                                                 //
-            m_nBegPrimesNum = 4;                          //
-        }                                                 //
-    }                                                     //
-    else if(m_nNumOfThreads < 9)                          //
-    {                                                     //
-        if(m_nMax < 2000000)                              //
-        {                                                 //
-            m_nBegPrimesNum = 3;                          //
-        }                                                 //
-        else                                              //
-        {                                                 //
-            m_nBegPrimesNum = 4;                          //
-        }                                                 //
-    }                                                     //
-    else if(m_nNumOfThreads < 49)                         //
-    {                                                     //
-        m_nBegPrimesNum = 4;                              //
-    }                                                     //
-    else
-    {
-        exit(1);                                          // If limits are wrong, close the program
-    }
-}
-
-/**
- * @brief Function to find prime number by the method of simple search, most quick for small intervals
- * @param None
- * @return None
- */
-void FindPrimes::findPrimesEnum()
-{
-    bool fPrime(true);                                           // Flag if the number is orime
-    uint32_t nQuant = 1 + sqrtf(m_nMax);                         // Limit for searchind
-    if(nQuant < m_nBegPrimesNum)
-    {
-        nQuant = m_nBegPrimesNum;                                // Processing situation for many intervals in small limit
-    }
-
-    for(uint32_t i  = 2, j = 0; j < nQuant && i < nQuant; ++i)   // For all numbers 2...limit
-    {
-        for(uint32_t k  = 0, m = 0, n = 1 + sqrtf(i); m < n && k < j; ++k)  // For each vector index 0...max
-        {
-            m = (j > 0 ? m_nPrimesVc[k] : 1);                    // If vector is not empty, get value from to m
-
-            if(!(i % m))                                         // And check i % m,
-            {
-                fPrime = false;                                  //   if i % m == 0, i is not prime number,
-                break;                                           //   so breack the loop
-            }
-        }
-        if(fPrime)                                               // If we check i fo all prime numbers 2...sqrt(i),
-        {                                                        //    i is the prime number,
-            m_nPrimesVc.push_back(i);                            //    so write it to vector,
-            ++j;                                                 //    increment prime numbers capasity variable
-            if(j == m_nBegPrimesNum)
-            {
-                m_nMaxBegPrime = i;                              //    Save max prime number for Wheel Factorisation
-            }
-        }
-        else
-        {
-            fPrime = true;
-        }
-    }
-}
-
-/**
- * @brief Function to find prime number by the method of Eratosthenes Sieve. Use it to find Wheel spokes
- * @param nMin Minimal value of spokes to find
- * @return None
- */
-void FindPrimes::eratosthenesSieve(uint32_t nMin)
-{
-    for(uint32_t i = 2, p = nMin + 1; i < p; ++i)
-    {
-        if(!(m_fVc[i]))
-        {
-            for(uint32_t j = i * i; j < m_nPrimor; j += i)
-            {
-                m_fVc[j] = true;
-            }
-        }
-    }
-    for(uint32_t i = 2; i < m_nPrimor; ++i)
-    {
-        if(!(m_fVc[i]) && i > nMin)
-        {
-            m_nSpokesVc.push_back(i);
-        }
-    }
-}
-
-/**
- * @brief Function to count primorial
- * @param None
- * @return None
- */
-void FindPrimes::countPrimorial()
-{
-    for(uint32_t i = 0; i < m_nBegPrimesNum; ++i)
-    {
-        m_nPrimor *= m_nPrimesVc[i];
-    }
-}
-
-/**
- * @brief Function to collect several operations: find initial primes, count primorial, and finally find wheel spokes
- * @param None
- * @return None
- */
-void FindPrimes::findWheelSpokes()
-{
-    findPrimesEnum();
-
-    if(m_nMaxBegPrime >= m_nMax)
-    {
-        m_nPrimor = 0;
-        return;
-    }
-
-    countPrimorial();
-    m_fVc.resize(m_nPrimor, 0);
-
-    m_nSpokesVc.push_back(1);
-    eratosthenesSieve(m_nMaxBegPrime);
-
-    m_fVc.assign(m_fVc.size(), false);
-
-    if(m_nMax > m_nPrimor)
-    {
-        m_fVc.resize(m_nMax, false);
-    }
-}
-
-/**
- * @brief Function to choose nesessary part of spokes for each thread and collect it to vector
- * @param nThreadNum Serial number of thread
- * @return nSpokesVc Vector with spokes
- */
-std::vector <uint32_t> FindPrimes::getSpokes(uint32_t nThreadNum)
-{
-    std::vector <uint32_t> nSpokesVc;
-    uint32_t nSpokesPerThread = m_nNumOfSpokes / m_nNumOfThreads;
-
-    for(uint32_t i = nThreadNum * nSpokesPerThread, p = (nThreadNum + 1) * nSpokesPerThread; i < p; ++i)
-    {
-        nSpokesVc.push_back(m_nSpokesVc[i]);
-    }
-
-    return nSpokesVc;
-}
-
-/**
- * @brief Function to create PrimeNumFunc objects, create threads, start threads and wait for their end
- * @param None
- * @return None
- */
-void FindPrimes::multyThreadPrimesSearching()
-{
-    for(uint32_t i = 0; i < m_nNumOfThreads; ++i)
-    {
-        m_PNSearchVc.emplace_back(&m_fVc, &m_nPrimesVc, getSpokes(i), m_pIntVc, m_nPrimor, m_nBegPrimesNum);
-        m_threadsVc.emplace_back(m_PNSearchVc[i]);
-    }
-
-    for(uint32_t i = 0; i < m_nNumOfThreads; ++i)
-    {
-        m_threadsVc[i].join();
-    }
-}
-
-/**
- * @brief Set specific derived class from the abstract class PrimesOutput to set the output method behaviour
- * @param pOutput Pointer to the abstract class PrimesOutput, which points to the specific derived class
- * @return None
- */
-void FindPrimes::setOutput(PrimesOutput *pOutput)
-{
-    if(m_pOutput)
-    {
-        delete m_pOutput;
-    }
-
-    m_pOutput = pOutput;
-}
-
-/**
- * @brief Method to output prime numbers by the way which has been set in the implementation of the derived class from
- *        the abstract class PrimesOutput
- * @param None
- * @return None
- */
-void FindPrimes::output() const
-{
-    m_pOutput->output(m_pPrimeNumVector);
-}
-
-//*******************************************************************************************************
+/**
+  *************************************************************************************************************************
+  * @file    findprimes.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    23-November-2018
+  * @brief   Class for searching prime numbers in given intervals
+  **************************************************************************************************************************
+*/
+
+
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+
+#include "findprimes.h"
+#include "sieveplanner.h"
+#include "millerrabin.h"
+#include "checkpoint.h"
+#include "simdkernels.h"
+#include "profiler.h"
+
+/**
+ * @brief Class FindPrimes constructor
+ * @param pIntVec Intervals vector pointer
+ * @param Settings Number of threads, size of the wheel and of the segment (zero values are chosen automatically)
+ */
+FindPrimes::FindPrimes(std::vector<Interval> *pIntVc, const SieveSettings &Settings):
+   m_pPrimeNumVector(nullptr),
+    m_pIntVc(pIntVc),
+    m_pOutput(nullptr),
+    m_Settings(Settings),
+    m_nCheckpointSec(m_nCheckpointPeriod),
+    m_nChunkBits(0),
+    m_nSlotsNum(0),
+    m_nPrimor(1)                                 // Init primorial with 1 to use in multiplication operations
+
+{
+    {
+        Profiler::ScopedTimer Timer("plan");
+        std::vector <bool> fSieveVc;
+        SievePlanner(m_pIntVc).plan(fSieveVc);   // Choose intervals for the sieve and for the direct test
+        for(size_t i = 0, p = m_pIntVc->size(); i < p; ++i)
+        {
+            m_BlocksVc.emplace_back((*m_pIntVc)[i], fSieveVc[i]);
+        }
+    }
+
+    inputDataProcessing();                       // Count number of initial prime numbers, determine how many threads to make for intervals
+    if(m_Settings.m_nMemoryBudget)
+    {
+        double fRoot = std::sqrt(static_cast <double> (m_nMax)) + 2;
+        checkMemoryBudget(static_cast <uint64_t> (fRoot / std::log(fRoot) * 1.2) * 2 * sizeof(uint32_t) +  // Initial primes and inverses
+                          m_Settings.m_nOutputMemory, true);
+    }
+    findWheelSpokes();
+
+    m_nNumOfSpokes = m_nSpokesVc.size();
+    m_nNumOfWords = 0;
+    planMemory();                                // The mode may become pipelined to fit the memory budget
+    if(m_Settings.m_fPipelined)
+    {
+        makeChunks();                            // Primes are found by output()
+        return;
+    }
+
+    m_nNumOfWords = placeBlocks(m_BlocksVc);
+    multyThreadPrimesSearching();                // Find prime numbers by the sieve
+    directPrimesSearching();                     // and by the direct test
+    m_pPrimeNumVector = new PrimeNumbersVector(&m_SieveVc, &m_BlocksVc, &m_nDirectPrimesVc, &m_nWheelPrimesVc, &m_nSpokesVc,
+                                               m_nPrimor, m_nBegPrimesNum);
+}
+
+/**
+ * @brief Class FindPrimes destructor
+ */
+FindPrimes::~FindPrimes()
+{
+    if(m_pPrimeNumVector)
+    {
+        delete m_pPrimeNumVector;
+    }
+
+    if(m_pOutput)
+    {
+        delete m_pOutput;
+    }
+}
+
+/**
+ * @brief Function to count number of initial prime numbers, determine how many threads to make for intervals
+ * @param None
+ * @return None
+ */
+void FindPrimes::inputDataProcessing()
+{
+    m_nNumOfRanges = 0;                                   // Only intervals for the sieve are processed by threads
+    m_nMin = m_nMax = 0;
+
+    for(size_t i = 0, p = m_BlocksVc.size(); i < p; ++i)
+    {
+        if(m_BlocksVc[i].m_fSieved)
+        {
+            m_nMin = (m_nNumOfRanges++ ? m_nMin : m_BlocksVc[i].m_Int.m_nLowIntervalSide);   //
+            m_nMax = m_BlocksVc[i].m_Int.m_nHighIntervalSide;                                 // Get limits
+        }
+    }
+
+    m_nKernels = std::thread::hardware_concurrency();     // Get number of threads to work really parallel for current computer
+    m_nNumOfThreads = 2 * m_nKernels;                     // Maximum number of threads for effective work
+    if(m_nNumOfRanges < m_nNumOfThreads)
+    {
+        m_nNumOfThreads = m_nNumOfRanges;                 // Necessary number of threads for given ranges
+    }
+    if(m_Settings.m_nThreads && m_nNumOfRanges)
+    {
+        m_nNumOfThreads = m_Settings.m_nThreads;          // Number of threads is given explicitly
+    }
+
+    if(m_nNumOfThreads > 0 && m_nNumOfThreads < 3)        //
+    {                                                     //
+        if(m_nMax < 100000)                               // Make decision how many initial primes we use for searching
+        {                                                 //   depends on searching limits and intervals guantity
+            m_nBegPrimesNum = 2;                          //
+        }                                                 //
+        else if(m_nMax < 1000000)                         //
+        {                                                 //
+            m_nBegPrimesNum = 3;                          //
+        }                                                 //
+        else                                              //
+        {                                                 //
+            m_nBegPrimesNum = 4;                          //
+        }                                                 //
+    }                                                     //
+    else if(m_nNumOfThreads < 9)                          //
+    {                                                     //
+        if(m_nMax < 2000000)                              //
+        {                                                 //
+            m_nBegPrimesNum = 3;                          //
+        }                                                 //
+        else                                              //
+        {                                                 //
+            m_nBegPrimesNum = 4;                          //
+        }                                                 //
+    }                                                     //
+    else                                                  //
+    {                                                     //
+        m_nBegPrimesNum = 4;                              //
+    }                                                     //
+
+    if(m_Settings.m_nWheelPrimes)                         // Size of the wheel is given explicitly
+    {
+        m_nBegPrimesNum = (m_Settings.m_nWheelPrimes < SieveSettings::m_nMaxWheelPrimes ?
+                           m_Settings.m_nWheelPrimes : SieveSettings::m_nMaxWheelPrimes);
+    }
+
+    m_nBegPrimesNum = std::max(m_nBegPrimesNum, progressionWheelPrimes());
+
+    if(!m_Settings.m_nSegmentSize)
+    {
+        m_Settings.m_nSegmentSize = SieveSettings::m_nDefaultSegmentSize;
+    }
+    else if(m_Settings.m_nSegmentSize < SieveSettings::m_nMinSegmentSize)
+    {
+        m_Settings.m_nSegmentSize = SieveSettings::m_nMinSegmentSize;
+    }
+    else if(m_Settings.m_nSegmentSize > SieveSettings::m_nMaxSegmentSize)
+    {
+        m_Settings.m_nSegmentSize = SieveSettings::m_nMaxSegmentSize;
+    }
+    m_Settings.m_nThreads = m_nNumOfThreads;
+    m_Settings.m_nWheelPrimes = m_nBegPrimesNum;
+}
+
+/**
+ * @brief Function to check the progression and to find how many initial primes the wheel needs, so the modulus divides
+ *        the widened primorial and every spoke lies in one residue class. The residue is reduced modulo the modulus
+ * @param None
+ * @return nNeeded Number of initial primes (the wrong progression stops the program)
+ */
+uint32_t FindPrimes::progressionWheelPrimes()
+{
+    static const uint32_t nWheelPrimes[SieveSettings::m_nMaxWheelPrimes] = { 2, 3, 5, 7, 11, 13 };
+    Progression &Prog = m_Settings.m_Progression;
+    uint32_t nRest = Prog.m_nModulus, nNeeded(0);
+
+    for(uint32_t i = 0; nRest > 1 && i < SieveSettings::m_nMaxWheelPrimes; ++i)
+    {
+        for(; !(nRest % nWheelPrimes[i]); nRest /= nWheelPrimes[i])
+        {
+            nNeeded = i + 1;
+        }
+    }
+
+    if(!Prog.m_nModulus || Prog.m_nModulus > Progression::m_nMaxModulus || nRest > 1)
+    {
+        std::cerr << "Wrong progression: the modulus must be 1..." << Progression::m_nMaxModulus
+                  << " without prime factors bigger than 13!\n";
+        exit(1);
+    }
+
+    Prog.m_nResidue %= Prog.m_nModulus;
+    return nNeeded;
+}
+
+/**
+ * @brief Integer square root. Squares are not computed: they overflow for values near 2^64
+ * @param nVal Value
+ * @return nRoot Max number which square is not bigger than nVal (not bigger than 0xFFFFFFFF)
+ */
+static uint64_t intSqrt(uint64_t nVal)
+{
+    uint64_t nRoot = std::min <long double> (sqrtl(nVal), 0xFFFFFFFFULL);
+
+    while(nRoot && nRoot > nVal / nRoot)
+    {
+        --nRoot;
+    }
+    while(nRoot < 0xFFFFFFFFULL && nRoot + 1 <= nVal / (nRoot + 1))
+    {
+        ++nRoot;
+    }
+
+    return nRoot;
+}
+
+/**
+ * @brief Function to find initial primes up to square root of the number by the odd-only Eratosthenes Sieve.
+ *        Simple search is too slow for limits up to 1e9 (for intervals near 1e18). The limit is 16 at least,
+ *        so all primes of the biggest wheel are found
+ * @param nMax Max number of intervals
+ * @param nPrimesVc Container to write primes in
+ * @return None
+ */
+void FindPrimes::findInitialPrimes(uint64_t nMax, std::vector <uint32_t> &nPrimesVc)
+{
+    uint64_t nQuant = intSqrt(nMax);                             // Limit for searchind
+    if(nQuant < 16)
+    {
+        nQuant = 16;                                             // Processing situation for many intervals in small limit
+    }
+
+    std::vector <bool> fCompositeVc(nQuant / 2 + 1, false);      // Bit i corresponds to the number 2 * i + 1
+
+    nPrimesVc.push_back(2);
+    for(uint64_t i = 3; i <= nQuant; i += 2)
+    {
+        if(!fCompositeVc[i / 2])
+        {
+            nPrimesVc.push_back(i);
+            for(uint64_t j = i * i; j <= nQuant; j += 2 * i)
+            {
+                fCompositeVc[j / 2] = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Function to find initial primes up to square root of the max number
+ * @param None
+ * @return None
+ */
+void FindPrimes::findPrimesEnum()
+{
+    Profiler::ScopedTimer Timer("base_primes");
+
+    findInitialPrimes(m_nMax, m_nPrimesVc);
+    m_nMaxBegPrime = m_nPrimesVc[m_nBegPrimesNum - 1];           // Save max prime number for Wheel Factorisation
+    Profiler::get().addCounter("base_primes", m_nPrimesVc.size());
+}
+
+/**
+ * @brief Function to find prime number by the method of Eratosthenes Sieve. Use it to find Wheel spokes
+ * @param nMin Minimal value of spokes to find
+ * @return None
+ */
+void FindPrimes::eratosthenesSieve(uint32_t nMin)
+{
+    for(uint32_t i = 2, p = nMin + 1; i < p; ++i)
+    {
+        if(!(m_fVc[i]))
+        {
+            for(uint32_t j = i * i; j < m_nPrimor; j += i)
+            {
+                m_fVc[j] = true;
+            }
+        }
+    }
+    for(uint32_t i = 2; i < m_nPrimor; ++i)
+    {
+        if(!(m_fVc[i]) && i > nMin && i % m_Settings.m_Progression.m_nModulus == m_Settings.m_Progression.m_nResidue)
+        {
+            m_nSpokesVc.push_back(i);
+        }
+    }
+}
+
+/**
+ * @brief Function to count primorial. It is widened to multiple of the modulus of the progression (prime factors of the
+ *        modulus are primes of the wheel, so only their powers are added)
+ * @param None
+ * @return None
+ */
+void FindPrimes::countPrimorial()
+{
+    for(uint32_t i = 0; i < m_nBegPrimesNum; ++i)
+    {
+        m_nPrimor *= m_nPrimesVc[i];
+    }
+
+    uint32_t nGcd = m_nPrimor, nRem = m_Settings.m_Progression.m_nModulus, nTmp;
+    while(nRem)
+    {
+        nTmp = nGcd % nRem; nGcd = nRem; nRem = nTmp;
+    }
+    m_nPrimor *= m_Settings.m_Progression.m_nModulus / nGcd;
+}
+
+/**
+ * @brief Function to count inverse of primorial modulo every initial prime (besides primes of the wheel) by the extended
+ *        Euclidean algorithm. It is used to find the first multiple of the prime in the spoke
+ * @param None
+ * @return None
+ */
+void FindPrimes::findInverses()
+{
+    m_nInvPrimorVc.assign(m_nPrimesVc.size(), 0);
+
+    for(size_t i = m_nBegPrimesNum, p = m_nPrimesVc.size(); i < p; ++i)
+    {
+        int64_t nOldR = m_nPrimor % m_nPrimesVc[i], nR = m_nPrimesVc[i];
+        int64_t nOldS = 1, nS = 0, nTmp, nQ;
+
+        while(nR)
+        {
+            nQ = nOldR / nR;
+            nTmp = nOldR - nQ * nR; nOldR = nR; nR = nTmp;
+            nTmp = nOldS - nQ * nS; nOldS = nS; nS = nTmp;
+        }
+
+        m_nInvPrimorVc[i] = (nOldS < 0 ? nOldS + m_nPrimesVc[i] : nOldS);
+    }
+}
+
+/**
+ * @brief Function to collect several operations: find initial primes, count primorial, find wheel spokes (only spokes
+ *        of the progression are kept), and finally prepare inverses and pre-sieved patterns for the sieve
+ * @param None
+ * @return None
+ */
+void FindPrimes::findWheelSpokes()
+{
+    findPrimesEnum();
+
+    Profiler::ScopedTimer Timer("wheel");
+    countPrimorial();
+    m_fVc.resize(m_nPrimor, 0);
+
+    const Progression &Prog = m_Settings.m_Progression;
+    if(1 % Prog.m_nModulus == Prog.m_nResidue)
+    {
+        m_nSpokesVc.push_back(1);
+    }
+    eratosthenesSieve(m_nMaxBegPrime);
+
+    for(uint32_t i = 0; i < m_nBegPrimesNum; ++i)
+    {
+        m_nWheelPrimesVc.push_back(m_nPrimesVc[i] % Prog.m_nModulus == Prog.m_nResidue ? m_nPrimesVc[i] : 0);
+    }
+
+    m_fVc.clear();
+    m_fVc.shrink_to_fit();
+
+    findInverses();
+    m_PreSieve.init(m_nPrimesVc, m_nSpokesVc, m_nPrimor, m_nBegPrimesNum);
+}
+
+/**
+ * @brief Function to place blocks of sieved intervals one after another in the words of every spoke. The block starts
+ *        from the word which contains the first number of the interval, so patterns of the pre-sieve keep their phase
+ * @param BlocksVc Blocks of intervals
+ * @return nNumOfWords Number of words of all blocks of one spoke
+ */
+size_t FindPrimes::placeBlocks(std::vector <SieveBlock> &BlocksVc) const
+{
+    size_t nNumOfWords(0);
+
+    for(size_t i = 0, p = BlocksVc.size(); i < p; ++i)
+    {
+        if(BlocksVc[i].m_fSieved)
+        {
+            uint64_t nFirstIdx = BlocksVc[i].m_Int.m_nLowIntervalSide / m_nPrimor;
+            uint64_t nLastIdx = BlocksVc[i].m_Int.m_nHighIntervalSide / m_nPrimor;
+
+            BlocksVc[i].m_nOrigin = nFirstIdx & ~static_cast <uint64_t> (63);
+            BlocksVc[i].m_nWordOffset = nNumOfWords;
+            nNumOfWords += (nLastIdx - BlocksVc[i].m_nOrigin) / 64 + 1;
+        }
+    }
+
+    return nNumOfWords;
+}
+
+/**
+ * @brief Function to choose nesessary part of spokes for each thread and collect their indices to vector.
+ *        Remainder of the division is spread among the first threads, so every spoke is sieved
+ * @param nThreadNum Serial number of thread
+ * @return nSpokesVc Vector with indices of spokes
+ */
+std::vector <uint32_t> FindPrimes::getSpokes(uint32_t nThreadNum)
+{
+    std::vector <uint32_t> nSpokesVc;
+    uint32_t nSpokesPerThread = m_nNumOfSpokes / m_nNumOfThreads;
+    uint32_t nRemainder = m_nNumOfSpokes % m_nNumOfThreads;
+    uint32_t nBegin = nThreadNum * nSpokesPerThread + (nThreadNum < nRemainder ? nThreadNum : nRemainder);
+
+    for(uint32_t i = nBegin, p = nBegin + nSpokesPerThread + (nThreadNum < nRemainder ? 1 : 0); i < p; ++i)
+    {
+        nSpokesVc.push_back(i);
+    }
+
+    return nSpokesVc;
+}
+
+/**
+ * @brief Function to create PrimeNumFunc objects, create threads, start threads and wait for their end
+ * @param None
+ * @return None
+ */
+void FindPrimes::multyThreadPrimesSearching()
+{
+    Profiler::ScopedTimer Timer("sieve");
+    m_SieveVc.assign(m_nNumOfSpokes, SieveWords(m_nNumOfWords, 0));
+    Profiler::get().addCounter("sieve_bytes", m_nNumOfSpokes * m_nNumOfWords * sizeof(uint64_t));
+    Profiler::get().addCounter("sieve_threads", m_nNumOfThreads);
+
+    m_PNSearchVc.reserve(m_nNumOfThreads);                  // Functors are given by reference, they must not move
+    for(uint32_t i = 0; i < m_nNumOfThreads; ++i)
+    {
+        m_PNSearchVc.emplace_back(&m_SieveVc, &m_nPrimesVc, &m_nInvPrimorVc, &m_nSpokesVc, getSpokes(i), &m_BlocksVc,
+                                  &m_PreSieve, m_nPrimor, m_nBegPrimesNum, m_Settings.m_nSegmentSize, i);
+        m_threadsVc.emplace_back(std::ref(m_PNSearchVc[i]));
+    }
+
+    for(uint32_t i = 0; i < m_nNumOfThreads; ++i)
+    {
+        m_threadsVc[i].join();
+    }
+}
+
+/**
+ * @brief Function to find prime numbers in the intervals chosen for the direct test: numbers of all spokes are checked
+ *        by the deterministic Miller-Rabin test (initial primes of the wheel are given by PrimeNumbersVector)
+ * @param None
+ * @return None
+ */
+void FindPrimes::directPrimesSearching()
+{
+    Profiler::ScopedTimer Timer("direct_test");
+    uint64_t nTested(0);
+
+    for(size_t i = 0, p = m_BlocksVc.size(); i < p; ++i)
+    {
+        if(!m_BlocksVc[i].m_fSieved)
+        {
+            nTested += testBlock(m_BlocksVc[i], m_nDirectPrimesVc);
+        }
+    }
+
+    Profiler::get().addCounter("numbers_tested", nTested);
+}
+
+/**
+ * @brief Function to test numbers of all spokes of the block by the Miller-Rabin test and to append primes to the
+ *        container. Positions of the primes are saved in the block
+ * @param Block Block of the direct test
+ * @param PrimesVc Container of primes of the direct test
+ * @return nTested Number of tested numbers
+ */
+uint64_t FindPrimes::testBlock(SieveBlock &Block, std::vector <uint64_t> &PrimesVc) const
+{
+    uint64_t nLow = Block.m_Int.m_nLowIntervalSide, nHigh = Block.m_Int.m_nHighIntervalSide;
+    uint64_t nTested(0);
+
+    Block.m_nDirectBegin = PrimesVc.size();
+    for(uint64_t k = nLow / m_nPrimor, q = nHigh / m_nPrimor; k <= q; ++k)
+    {
+        for(uint32_t j = 0; j < m_nNumOfSpokes; ++j)
+        {
+            uint64_t nNum = k * m_nPrimor + m_nSpokesVc[j];
+
+            if(nNum >= nLow && nNum <= nHigh)
+            {
+                ++nTested;
+                if(MillerRabin::isPrime(nNum))
+                {
+                    PrimesVc.push_back(nNum);
+                }
+            }
+        }
+    }
+    Block.m_nDirectEnd = PrimesVc.size();
+
+    return nTested;
+}
+
+/**
+ * @brief Function to choose sizes of the pipeline: the full chunk, slots of the ring and number of threads. Without
+ *        the memory budget they are fixed by the number of initial primes and threads. With the budget the whole
+ *        result is kept only if it fits, otherwise the mode becomes pipelined, and then slots of the ring, size of
+ *        the chunk and number of threads are reduced in this order until the pipeline fits. The program stops early
+ *        if the smallest pipeline doesn't fit
+ * @param None
+ * @return None
+ */
+void FindPrimes::planMemory()
+{
+    uint64_t nMinChunkBits = std::max <uint64_t> (64, (m_nPrimesVc.size() + 63) & ~static_cast <uint64_t> (63));
+    uint32_t nThreads = std::max <uint32_t> (1, m_nNumOfThreads), nSlotsPerThread = m_nSlotsPerThread;
+
+    m_nChunkBits = std::max <uint64_t> (m_nMinChunkBits, (4 * m_nPrimesVc.size() + 63) & ~static_cast <uint64_t> (63));
+    m_nSlotsNum = m_nSlotsPerThread * nThreads;
+    if(!m_Settings.m_nMemoryBudget)
+    {
+        return;
+    }
+
+    if(!m_Settings.m_fPipelined)
+    {
+        std::vector <SieveBlock> BlocksVc(m_BlocksVc);
+        uint64_t nWords = placeBlocks(BlocksVc);
+        uint64_t nFull = getMemoryUsage() + m_nNumOfSpokes * nWords * sizeof(uint64_t) + pipelineMemory(nThreads, 0, 0);
+
+        if(nFull <= m_Settings.m_nMemoryBudget)
+        {
+            return;
+        }
+
+        m_Settings.m_fPipelined = true;                                    // The whole result doesn't fit
+        Profiler::get().addCounter("budget_pipelined", 1);
+    }
+
+    for(;;)
+    {
+        if(pipelineMemory(nThreads, m_nChunkBits, nSlotsPerThread * nThreads) <= m_Settings.m_nMemoryBudget)
+        {
+            break;
+        }
+
+        if(nSlotsPerThread > 2)
+        {
+            --nSlotsPerThread;
+        }
+        else if(m_nChunkBits > nMinChunkBits)
+        {
+            m_nChunkBits = std::max(nMinChunkBits, (m_nChunkBits / 2 + 63) & ~static_cast <uint64_t> (63));
+        }
+        else if(nThreads > 1)
+        {
+            --nThreads;
+        }
+        else
+        {
+            checkMemoryBudget(pipelineMemory(nThreads, m_nChunkBits, nSlotsPerThread * nThreads));
+            break;
+        }
+    }
+
+    m_nSlotsNum = nSlotsPerThread * nThreads;
+    if(m_nNumOfThreads)
+    {
+        m_nNumOfThreads = m_Settings.m_nThreads = nThreads;
+    }
+}
+
+/**
+ * @brief Estimated memory of the search: initial primes, patterns and blocks, buckets of every thread, memory of the
+ *        output and, in the pipelined mode, words of the chunk of every thread and batches of the ring (every
+ *        position may be prime)
+ * @param nThreads Number of threads
+ * @param nChunkBits Bits of every spoke of the chunk (0 - the whole result is kept)
+ * @param nSlots Slots of the ring
+ * @return Bytes
+ */
+uint64_t FindPrimes::pipelineMemory(uint32_t nThreads, uint64_t nChunkBits, uint32_t nSlots) const
+{
+    uint64_t nBuckets = 2 * m_nPrimesVc.size() * sizeof(BucketEntry) + 64 * sizeof(Bucket);   // Entries and the first block of the pool
+    uint64_t nChunk = m_nNumOfSpokes * (nChunkBits / 64) * sizeof(uint64_t);
+
+    return (nChunkBits ? getMemoryUsage() : 0) + nThreads * (nBuckets + nChunk) + nSlots * m_nBatchPositions * sizeof(uint64_t) +
+           m_Settings.m_nOutputMemory;
+}
+
+/**
+ * @brief Stop the program if the memory budget is less than needed. The early check (before initial primes are found)
+ *        knows only a part of the smallest pipeline, so it doesn't report the number: it would be less than the one
+ *        of the full check
+ * @param nNeeded Bytes needed
+ * @param fEarly Only initial primes and the output are counted
+ * @return None
+ */
+void FindPrimes::checkMemoryBudget(uint64_t nNeeded, bool fEarly) const
+{
+    if(nNeeded > m_Settings.m_nMemoryBudget)
+    {
+        std::cerr << "Memory budget of " << (m_Settings.m_nMemoryBudget >> 20) << " MB is too small";
+        if(fEarly)
+        {
+            std::cerr << " even for initial primes!\n";
+        }
+        else
+        {
+            std::cerr << ", at least " << ((nNeeded >> 20) + 1) << " MB is needed!\n";
+        }
+        exit(1);
+    }
+}
+
+/**
+ * @brief Function to split blocks into chunks of the pipeline. Sieved blocks are cut where the work of the chunk
+ *        ends, blocks of the direct test are cut by the cost of the test, and small neighbour pieces are joined,
+ *        so every chunk has about the same work. The chunk must be much bigger than the number of initial primes,
+ *        because every piece finds the first hits of all of them again. The first chunks are smaller (but not less
+ *        than the number of initial primes in every spoke) and grow twice until the full size, so the first primes
+ *        come soon. Primes of the chunk go to the writer by batches of
+ *        m_nBatchPositions positions, so the ring stays small for any size of the chunk
+ * @param None
+ * @return None
+ */
+void FindPrimes::makeChunks()
+{
+    uint64_t nChunkBits = m_nChunkBits;
+    uint64_t nCurBits = std::max <uint64_t> (nChunkBits >> m_nChunkGrowthSteps, (m_nPrimesVc.size() + 63) & ~static_cast <uint64_t> (63));
+    uint64_t nBudget = nCurBits * m_nPrimor, nWeight(0);               // Numbers of the chunk
+    uint64_t nPositions(m_nBegPrimesNum);                               // Positions of PrimeNumbersVector of the chunk
+
+    m_nChunksVc.assign(1, 0);
+    m_nBatchesVc.assign(1, 0);
+    for(size_t i = 0, p = m_BlocksVc.size(); i < p; ++i)
+    {
+        uint64_t nLow = m_BlocksVc[i].m_Int.m_nLowIntervalSide, nHigh = m_BlocksVc[i].m_Int.m_nHighIntervalSide;
+        bool fSieved = m_BlocksVc[i].m_fSieved;
+
+        while(nLow <= nHigh)
+        {
+            uint64_t nPieceHigh;
+
+            if(fSieved)                                                   // Up to the end of the chunk of the spokes
+            {
+                uint64_t nEndIdx = nLow / m_nPrimor + (nBudget - nWeight + m_nPrimor - 1) / m_nPrimor;
+                nPieceHigh = (nEndIdx > nHigh / m_nPrimor ? nHigh : nEndIdx * m_nPrimor - 1);
+            }
+            else
+            {
+                uint64_t nWidth = nBudget / m_nDirectWeight;
+                nPieceHigh = (nHigh - nLow < nWidth ? nHigh : nLow + nWidth - 1);
+            }
+
+            m_PiecesVc.emplace_back(Interval(nLow, nPieceHigh), fSieved);
+            nWeight += (nPieceHigh - nLow + 1) * (fSieved ? 1 : m_nDirectWeight);
+            nPositions += (nPieceHigh / m_nPrimor - nLow / m_nPrimor + 1) * m_nNumOfSpokes;   // Not less than primes of the direct test
+            if(nWeight >= nBudget)
+            {
+                m_nChunksVc.push_back(m_PiecesVc.size());
+                m_nBatchesVc.push_back(m_nBatchesVc.back() + (nPositions + m_nBatchPositions - 1) / m_nBatchPositions);
+                nWeight = 0;
+                nPositions = m_nBegPrimesNum;
+                nCurBits = std::min(nChunkBits, 2 * nCurBits);
+                nBudget = nCurBits * m_nPrimor;
+            }
+
+            if(nPieceHigh == nHigh)
+            {
+                break;                                                    // nHigh may be the max number of uint64_t
+            }
+            nLow = nPieceHigh + 1;
+        }
+    }
+
+    if(m_nChunksVc.back() != m_PiecesVc.size())
+    {
+        m_nChunksVc.push_back(m_PiecesVc.size());
+        m_nBatchesVc.push_back(m_nBatchesVc.back() + (nPositions + m_nBatchPositions - 1) / m_nBatchPositions);
+    }
+}
+
+/**
+ * @brief Returns number of chunks of the pipelined mode
+ * @param None
+ * @return Number of chunks (0 if the mode is not pipelined)
+ */
+size_t FindPrimes::getChunksNum() const
+{
+    return (m_nChunksVc.empty() ? 0 : m_nChunksVc.size() - 1);
+}
+
+/**
+ * @brief Function to find primes of the chunk of the pipelined mode: words of its pieces are sieved in all spokes by
+ *        the same functor as in the usual mode, pieces of the direct test are tested. Chunks are independent, so they
+ *        may be sieved in any order and by any threads with their own buffers
+ * @param nChunk Index of the chunk
+ * @param Buffers Memory of the thread (it is reused for all chunks of the thread)
+ * @param nWorker Serial number of the thread (for the profiler)
+ * @return Primes of the chunk in order (it points to Buffers and is valid until the next chunk)
+ */
+PrimeNumbersVector FindPrimes::sieveChunk(size_t nChunk, ChunkBuffers &Buffers, uint32_t nWorker) const
+{
+    Buffers.m_BlocksVc.assign(m_PiecesVc.begin() + m_nChunksVc[nChunk], m_PiecesVc.begin() + m_nChunksVc[nChunk + 1]);
+    Buffers.m_DirectVc.clear();
+
+    size_t nWords = placeBlocks(Buffers.m_BlocksVc);
+    uint64_t nTested(0);
+
+    Buffers.m_SieveVc.resize(m_nNumOfSpokes);
+    for(SieveWords &Words : Buffers.m_SieveVc)                              // Words of the previous chunk are reused
+    {
+        Words.resize(nWords);
+        SimdKernels::get().m_pClear(Words.data(), nWords);
+    }
+
+    for(SieveBlock &Block : Buffers.m_BlocksVc)
+    {
+        if(!Block.m_fSieved)
+        {
+            nTested += testBlock(Block, Buffers.m_DirectVc);
+        }
+    }
+
+    if(nWords)
+    {
+        std::vector <uint32_t> nSpokesIdxVc(m_nNumOfSpokes);
+        for(uint32_t i = 0; i < m_nNumOfSpokes; ++i)
+        {
+            nSpokesIdxVc[i] = i;
+        }
+
+        PrimeNumFunc(&Buffers.m_SieveVc, &m_nPrimesVc, &m_nInvPrimorVc, &m_nSpokesVc, std::move(nSpokesIdxVc),
+                     &Buffers.m_BlocksVc, &m_PreSieve, m_nPrimor, m_nBegPrimesNum, m_Settings.m_nSegmentSize, nWorker)();
+    }
+
+    if(nTested)
+    {
+        Profiler::get().addCounter("numbers_tested", nTested);
+    }
+
+    return PrimeNumbersVector(&Buffers.m_SieveVc, &Buffers.m_BlocksVc, &Buffers.m_DirectVc, &m_nWheelPrimesVc, &m_nSpokesVc,
+                              m_nPrimor, m_nBegPrimesNum);
+}
+
+/**
+ * @brief Function to find and write primes in the pipelined mode. Threads take chunks in order and put batches of
+ *        their primes into the bounded ring, the calling thread writes batches in order as soon as they are ready.
+ *        Only bits of the chunks being sieved and batches in the ring are kept in memory, the first primes are written
+ *        after the first chunk has been sieved. If the checkpoint is set, the output is synced and the number of chunks
+ *        written is saved periodically, the next run with the same fingerprint continues from the checkpoint
+ * @param None
+ * @return None
+ */
+void FindPrimes::pipelinedOutput() const
+{
+    Profiler::ScopedTimer Timer("pipeline");
+    size_t nChunks = m_nChunksVc.size() - 1;
+    uint32_t nThreads = std::max <uint32_t> (1, m_nNumOfThreads);
+    PrimesRing Ring(m_nSlotsNum);
+    bool fCheckpoint = !m_sCheckpoint.empty();
+    Checkpoint Ckpt(m_sCheckpoint.c_str(), fCheckpoint ? getFingerprint() : 0);
+    Checkpoint::State St = { 0, 0, 0 };
+
+    if(fCheckpoint && Ckpt.load(St) && St.m_nChunks <= nChunks && m_pOutput->resume(St.m_nOffset, St.m_nPrimes))
+    {
+        Profiler::get().addCounter("resumed_chunks", St.m_nChunks);
+    }
+    else
+    {
+        St = { 0, 0, 0 };
+        m_pOutput->begin();
+    }
+
+    uint64_t nFirstBatch = m_nBatchesVc[St.m_nChunks];                  // Batches of the ring are counted from it
+    std::atomic <uint64_t> nNextChunk(St.m_nChunks);
+    std::vector <std::thread> ThreadsVc;
+
+    for(uint32_t i = 0; i < nThreads; ++i)
+    {
+        ThreadsVc.emplace_back([this, i, nChunks, nFirstBatch, &Ring, &nNextChunk] ()
+        {
+            ChunkBuffers Buffers;
+
+            for(uint64_t n; (n = nNextChunk.fetch_add(1)) < nChunks; )
+            {
+                PrimeNumbersVector Primes = sieveChunk(n, Buffers, i);
+
+                for(uint64_t b = m_nBatchesVc[n] - nFirstBatch, p = m_nBatchesVc[n + 1] - nFirstBatch, nPos(0); b < p;
+                    ++b, nPos += m_nBatchPositions)
+                {
+                    Primes.getPrimes(nPos, m_nBatchPositions, Ring.acquire(b));   // The last batches may be empty
+                    Ring.publish(b);
+                }
+            }
+        });
+    }
+
+    std::chrono::steady_clock::time_point Last = std::chrono::steady_clock::now();
+    for(uint64_t c = St.m_nChunks; c < nChunks; ++c)
+    {
+        for(uint64_t n = m_nBatchesVc[c] - nFirstBatch, p = m_nBatchesVc[c + 1] - nFirstBatch; n < p; ++n)
+        {
+            const std::vector <uint64_t> &PrimesVc = Ring.wait(n);
+
+            St.m_nPrimes += PrimesVc.size();
+            m_pOutput->write(PrimesVc);
+            Ring.release(n);
+        }
+
+        if(fCheckpoint && c + 1 < nChunks &&
+           std::chrono::steady_clock::now() - Last >= std::chrono::seconds(m_nCheckpointSec))
+        {
+            St.m_nChunks = c + 1;
+            if(m_pOutput->sync(St.m_nOffset))                             // Data first, then the checkpoint which points to them
+            {
+                Ckpt.save(St);
+                Profiler::get().addCounter("checkpoints", 1);
+            }
+            Last = std::chrono::steady_clock::now();
+        }
+    }
+    m_pOutput->end();
+
+    if(fCheckpoint)
+    {
+        Ckpt.remove();                                                  // The output is whole
+    }
+
+    for(std::thread &Thread : ThreadsVc)
+    {
+        Thread.join();
+    }
+
+    Profiler::get().addCounter("pipeline_chunks", nChunks);
+    Profiler::get().addCounter("pipeline_stalls", Ring.getStalls());
+}
+
+/**
+ * @brief Fingerprint of the pipelined output: hash of pieces of chunks, batches and parameters of the wheel and of the
+ *        progression. The same input and settings give the same chunks and the same output, so the checkpoint is valid
+ * @param None
+ * @return Hash
+ */
+uint64_t FindPrimes::getFingerprint() const
+{
+    uint64_t nHash = Checkpoint::hash(Checkpoint::m_nHashSeed, m_nBatchesVc.back());
+
+    nHash = Checkpoint::hash(nHash, m_nPrimor);
+    nHash = Checkpoint::hash(nHash, m_nNumOfSpokes);
+    nHash = Checkpoint::hash(nHash, m_nBegPrimesNum);
+    nHash = Checkpoint::hash(nHash, m_Settings.m_Progression.m_nModulus);
+    nHash = Checkpoint::hash(nHash, m_Settings.m_Progression.m_nResidue);
+    for(const SieveBlock &Piece : m_PiecesVc)
+    {
+        nHash = Checkpoint::hash(nHash, Piece.m_Int.m_nLowIntervalSide);
+        nHash = Checkpoint::hash(nHash, Piece.m_Int.m_nHighIntervalSide);
+        nHash = Checkpoint::hash(nHash, Piece.m_fSieved);
+    }
+    for(size_t nPiece : m_nChunksVc)
+    {
+        nHash = Checkpoint::hash(nHash, nPiece);
+    }
+
+    return nHash;
+}
+
+/**
+ * @brief Set the file of checkpoints of the pipelined output. The file is removed when the output is written completely
+ * @param pFileName Name of the file (nullptr - no checkpoints)
+ * @param nPeriod Seconds between checkpoints
+ * @return None
+ */
+void FindPrimes::setCheckpoint(const char *pFileName, uint32_t nPeriod)
+{
+    m_sCheckpoint = (pFileName ? pFileName : "");
+    m_nCheckpointSec = nPeriod;
+}
+
+/**
+ * @brief Set specific derived class from the abstract class PrimesOutput to set the output method behaviour
+ * @param pOutput Pointer to the abstract class PrimesOutput, which points to the specific derived class
+ * @return None
+ */
+void FindPrimes::setOutput(PrimesOutput *pOutput)
+{
+    if(m_pOutput)
+    {
+        delete m_pOutput;
+    }
+
+    m_pOutput = pOutput;
+}
+
+/**
+ * @brief Method to output prime numbers by the way which has been set in the implementation of the derived class from
+ *        the abstract class PrimesOutput
+ * @param None
+ * @return None
+ */
+void FindPrimes::output() const
+{
+    if(m_Settings.m_fPipelined)
+    {
+        pipelinedOutput();                                    // Every call finds primes again
+        return;
+    }
+
+    m_pOutput->output(m_pPrimeNumVector);
+}
+
+/**
+ * @brief Returns settings of the sieve really used: values which have been chosen automatically are filled
+ * @param None
+ * @return Settings
+ */
+const SieveSettings &FindPrimes::getSettings() const
+{
+    return m_Settings;
+}
+
+/**
+ * @brief Returns time of the sieve of every thread (to find imbalance of spokes between threads)
+ * @param None
+ * @return Nanoseconds of every thread
+ */
+std::vector <uint64_t> FindPrimes::getThreadTimes() const
+{
+    std::vector <uint64_t> nTimesVc;
+
+    for(const PrimeNumFunc &Func : m_PNSearchVc)
+    {
+        nTimesVc.push_back(Func.getBusyTime());
+    }
+
+    return nTimesVc;
+}
+
+/**
+ * @brief Returns memory of the search: bits of spokes, initial primes and their inverses, pre-sieved patterns, buckets
+ *        of all threads and primes of the direct test
+ * @param None
+ * @return Bytes
+ */
+size_t FindPrimes::getMemoryUsage() const
+{
+    size_t nBytes = m_nNumOfSpokes * m_nNumOfWords * sizeof(uint64_t) + m_PreSieve.getMemoryUsage() +
+                    (m_nPrimesVc.capacity() + m_nInvPrimorVc.capacity() + m_nSpokesVc.capacity()) * sizeof(uint32_t) +
+                    m_BlocksVc.capacity() * sizeof(SieveBlock) + m_nDirectPrimesVc.capacity() * sizeof(uint64_t);
+
+    for(const PrimeNumFunc &Func : m_PNSearchVc)
+    {
+        nBytes += Func.getBucketsMemory();
+    }
+
+    return nBytes;
+}
+
+//*******************************************************************************************************
@@ -1,66 +1,121 @@
-/**
-  *************************************************************************************************************************
-  * @file    findprimes.h
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    23-November-2018
-  * @brief   Class for searching prime numbers in given intervals
-  **************************************************************************************************************************
-*/
-
-#ifndef FINDPRIMES_H
-#define FINDPRIMES_H
-
-#include <iostream>
-#include <fstream>
-#include <vector>
-#include <thread>
-
-#include "primenumfunc.h"
-#include "interval.hpp"
-#include "primenumbersvector.h"
-#include "primesoutput.hpp"
-
-class FindPrimes
-{
-public:
-    FindPrimes(std::vector <Interval> *pIntVc);
-    ~FindPrimes();
-
-    void setOutput(PrimesOutput *pOutput);
-    void output() const;
-
-    PrimeNumbersVector *m_pPrimeNumVector;                  // Adapter for the bool vector to output the result of searching
-
-private:
-    std::vector <bool> m_fVc;                               // Bool vector to save result in it
-    std::vector <uint32_t> m_nPrimesVc;                     // Initial primes for searching another primes
-    std::vector <uint32_t> m_nSpokesVc;                     // Spokes of Wheel Factorisation container
-    std::vector <PrimeNumFunc> m_PNSearchVc;                // Functor container for threads
-    std::vector <std::thread> m_threadsVc;                  // Threads vector
-    std::vector <Interval> *m_pIntVc;                       // Vector of intervals for searching in
-
-    PrimesOutput *m_pOutput;                                // Abstract class pointer to define the output method
-
-    uint32_t m_nMax;                                        // Max number of all intervals
-    uint32_t m_nMin;                                        // Min number of all intervals
-    uint32_t m_nBegPrimesNum;                               // Number of initial primes of Wheel Factorisation
-    uint32_t m_nNumOfThreads;                               // Number of threads
-    uint32_t m_nNumOfRanges;                                // Number of intervals for searching
-    uint32_t m_nPrimor;                                     // Primorial of Wheel Factorisation
-    uint32_t m_nNumOfSpokes;                                // Number of spokes of Wheel Factorisation
-    uint32_t m_nKernels;                                    // Number of kernels (from std::thread::hardware_concurrency())
-    uint32_t m_nMaxBegPrime;                                // Max of initial primes
-
-    void inputDataProcessing();                             // Count number of initial prime numbers, determine how many threads to make for intervals
-    void findPrimesEnum();                                  // Finding initial primes
-    void eratosthenesSieve(uint32_t nMin);                  // Eratosthenes Sieve specified function for current application
-    void countPrimorial();
-    void findWheelSpokes();                                 // Finding Spokes of Wheel Factorisation
-    void multyThreadPrimesSearching();                      // Filling functor vector and threads vector. Starting threads
-    std::vector<uint32_t> getSpokes(uint32_t nThreadNum);   // Returns part of spokes (as vector) for each thresd
-};
-
-#endif // FINDPRIMES_H
-
-//*********************************************************************************************************
+/**
+  *************************************************************************************************************************
+  * @file    findprimes.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    23-November-2018
+  * @brief   Class for searching prime numbers in given intervals
+  **************************************************************************************************************************
+*/
+
+#ifndef FINDPRIMES_H
+#define FINDPRIMES_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <string>
+
+#include "primenumfunc.h"
+#include "interval.hpp"
+#include "sievewords.hpp"
+#include "presieve.h"
+#include "primenumbersvector.h"
+#include "primesoutput.hpp"
+#include "sievesettings.hpp"
+#include "primesring.h"
+
+class FindPrimes
+{
+public:
+    FindPrimes(std::vector <Interval> *pIntVc, const SieveSettings &Settings = SieveSettings());
+    ~FindPrimes();
+
+    void setOutput(PrimesOutput *pOutput);
+    void output() const;
+    void setCheckpoint(const char *pFileName, uint32_t nPeriod = m_nCheckpointPeriod);  // Checkpoints of the pipelined output (nullptr - none)
+
+    struct ChunkBuffers                                     // Memory of the sieving thread of the pipelined mode
+    {
+        VectorSieveWords m_SieveVc;
+        std::vector <SieveBlock> m_BlocksVc;
+        std::vector <uint64_t> m_DirectVc;
+    };
+
+    size_t getChunksNum() const;                            // Chunks of the pipelined mode
+    PrimeNumbersVector sieveChunk(size_t nChunk, ChunkBuffers &Buffers, uint32_t nWorker = 0) const;
+
+    const SieveSettings &getSettings() const;               // Settings really used (values chosen automatically are filled)
+    std::vector <uint64_t> getThreadTimes() const;          // Nanoseconds of the sieve of every thread
+    size_t getMemoryUsage() const;                          // Bytes of the sieve, initial primes, patterns and buckets
+
+    static void findInitialPrimes(uint64_t nMax, std::vector <uint32_t> &nPrimesVc);  // Primes up to square root of nMax
+
+    PrimeNumbersVector *m_pPrimeNumVector;                  // Adapter for the bool vector to output the result of searching (nullptr in the pipelined mode)
+
+private:
+    static constexpr uint32_t m_nMinChunkBits = 1 << 15;    // Min number of bits of every spoke in the chunk of the pipeline
+    static constexpr uint32_t m_nChunkGrowthSteps = 6;      // The first chunk is up to 2^6 times smaller than the full one
+    static constexpr uint32_t m_nDirectWeight = 32;         // Cost of the direct test of the number relative to the sieve
+    static constexpr uint32_t m_nBatchPositions = 1 << 18;  // Positions of PrimeNumbersVector of the chunk in one batch of the ring
+    static constexpr uint32_t m_nSlotsPerThread = 4;        // Batches of the pipeline ready before the writer takes them
+    static constexpr uint32_t m_nCheckpointPeriod = 60;     // Seconds between checkpoints of the pipelined output
+
+    std::vector <bool> m_fVc;                               // Bool vector to find Wheel spokes in it
+    VectorSieveWords m_SieveVc;                             // Bits of spokes to save result in it
+    std::vector <uint32_t> m_nPrimesVc;                     // Initial primes for searching another primes
+    std::vector <uint32_t> m_nInvPrimorVc;                  // Inverse of primorial modulo every initial prime
+    PreSieve m_PreSieve;                                    // Patterns of the smallest initial primes after the wheel
+    std::vector <uint32_t> m_nSpokesVc;                     // Spokes of Wheel Factorisation container
+    std::vector <uint32_t> m_nWheelPrimesVc;                // Initial primes of the wheel to output (0 if out of the progression)
+    std::vector <PrimeNumFunc> m_PNSearchVc;                // Functor container for threads
+    std::vector <std::thread> m_threadsVc;                  // Threads vector
+    std::vector <Interval> *m_pIntVc;                       // Vector of intervals for searching in
+    std::vector <SieveBlock> m_BlocksVc;                    // Block of every interval (sieved or tested directly)
+    std::vector <uint64_t> m_nDirectPrimesVc;               // Primes found by the direct test
+    std::vector <SieveBlock> m_PiecesVc;                    // Parts of blocks sieved together in the pipelined mode
+    std::vector <size_t> m_nChunksVc;                       // Chunk i is m_PiecesVc[m_nChunksVc[i]...m_nChunksVc[i + 1] - 1]
+    std::vector <uint64_t> m_nBatchesVc;                    // Batches of the chunk i are m_nBatchesVc[i]...m_nBatchesVc[i + 1] - 1
+
+    PrimesOutput *m_pOutput;                                // Abstract class pointer to define the output method
+    SieveSettings m_Settings;                               // Parameters of the sieve
+    std::string m_sCheckpoint;                              // File of the checkpoint of the pipelined output (empty - none)
+    uint32_t m_nCheckpointSec;                              // Seconds between checkpoints
+    uint64_t m_nChunkBits;                                  // Bits of every spoke of the full chunk of the pipeline
+    uint32_t m_nSlotsNum;                                   // Batches of the ring of the pipeline
+
+    uint64_t m_nMax;                                        // Max number of all intervals
+    uint64_t m_nMin;                                        // Min number of all intervals
+    uint32_t m_nBegPrimesNum;                               // Number of initial primes of Wheel Factorisation
+    uint32_t m_nNumOfThreads;                               // Number of threads
+    uint32_t m_nNumOfRanges;                                // Number of intervals for searching
+    uint32_t m_nPrimor;                                     // Primorial of Wheel Factorisation (multiple of the modulus of the progression)
+    uint32_t m_nNumOfSpokes;                                // Number of spokes of Wheel Factorisation
+    uint32_t m_nKernels;                                    // Number of kernels (from std::thread::hardware_concurrency())
+    uint32_t m_nMaxBegPrime;                                // Max of initial primes
+    size_t m_nNumOfWords;                                   // Number of words of all blocks of one spoke
+
+    void inputDataProcessing();                             // Count number of initial prime numbers, determine how many threads to make for intervals
+    uint32_t progressionWheelPrimes();                      // Number of initial primes of the wheel to contain prime factors of the modulus
+    void findPrimesEnum();                                  // Finding initial primes
+    void eratosthenesSieve(uint32_t nMin);                  // Eratosthenes Sieve specified function for current application
+    void countPrimorial();
+    void findInverses();                                    // Inverse of primorial modulo every initial prime
+    void findWheelSpokes();                                 // Finding Spokes of Wheel Factorisation
+    size_t placeBlocks(std::vector <SieveBlock> &BlocksVc) const;   // Place words of sieved intervals one after another
+    void multyThreadPrimesSearching();                      // Filling functor vector and threads vector. Starting threads
+    void directPrimesSearching();                           // Miller-Rabin test of the numbers which survive the wheel
+    uint64_t testBlock(SieveBlock &Block, std::vector <uint64_t> &PrimesVc) const;
+    void planMemory();                                      // Size of chunks, ring and number of threads within the memory budget
+    uint64_t pipelineMemory(uint32_t nThreads, uint64_t nChunkBits, uint32_t nSlots) const;
+    void checkMemoryBudget(uint64_t nNeeded, bool fEarly = false) const;   // Stop the program if the budget is less than nNeeded
+    void makeChunks();                                      // Split blocks into chunks of the pipeline
+    void pipelinedOutput() const;                           // Sieve chunks in threads and write them in order
+    uint64_t getFingerprint() const;                        // Hash of chunks and parameters which define the output
+    std::vector<uint32_t> getSpokes(uint32_t nThreadNum);   // Returns indices of part of spokes (as vector) for each thresd
+};
+
+#endif // FINDPRIMES_H
+
+//*********************************************************************************************************
@@ -0,0 +1,251 @@
+/**
+  *************************************************************************************************************************
+  * @file    groupedoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which writes primes grouped by intervals as they are
+  *          given (not merged). The merged union is sieved once, primes are written once by disjoint regions (pieces
+  *          of IntervalPieces), and every interval refers to its regions by their ids, so overlaps are not copied
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+
+#include "groupedoutput.h"
+#include "profiler.h"
+
+/**
+ * @brief Class GroupedOutput constructor
+ * @param pFileName Name of the file to write in
+ * @param pOrigVc Intervals as they are given (IntervalsOutput fills them besides merged ones)
+ * @param fBinary Write the binary file instead of XML
+ */
+GroupedOutput::GroupedOutput(const char *pFileName, const std::vector <Interval> *pOrigVc, bool fBinary):
+    PrimesOutput(), m_pFileName(pFileName), m_pOrigVc(pOrigVc), m_fBinary(fBinary), m_Pieces(pOrigVc),
+    m_nRegion(0), m_fOpen(false), m_nEmitted(0) {}
+
+/**
+ * @brief Class GroupedOutput destructor
+ */
+GroupedOutput::~GroupedOutput() {}
+
+/**
+ * @brief Implementation of the abstract function to output prime numbers grouped by regions from PrimeNumbersVector
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void GroupedOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("output");
+    std::vector <uint64_t> PrimesVc;
+
+    begin();
+    for(size_t i = 0, p = pPrimeNumVc->size(); i < p; i += m_nChunkSize)
+    {
+        pPrimeNumVc->getPrimes(i, m_nChunkSize, PrimesVc);
+        write(PrimesVc);
+    }
+    end();
+}
+
+/**
+ * @brief Open the file, split intervals into regions and write the header
+ * @param None
+ * @return None
+ */
+void GroupedOutput::begin()
+{
+    m_Out.open(m_pFileName, m_fBinary ? std::ios::out | std::ios::binary : std::ios::out);
+
+    if(!m_Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    m_Pieces.make();
+    m_nRegionFirstVc.assign(m_Pieces.getPieces().size() + 1, 0);
+    m_nRegion = 0;
+    m_fOpen = false;
+    m_nEmitted = 0;
+
+    if(m_fBinary)
+    {
+        uint32_t nHeader[2] = { m_nVersion, 0 };
+
+        m_Out.write("PRMGROUP", 8);
+        m_Out.write(reinterpret_cast <const char*> (nHeader), sizeof(nHeader));
+    }
+    else
+    {
+        m_Out << "<root>\n<regions>\n";
+    }
+}
+
+/**
+ * @brief Write next primes of the stream into their regions
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void GroupedOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    size_t nRegions = m_Pieces.getPieces().size();
+
+    for(uint64_t nPrime : PrimesVc)
+    {
+        size_t nRegion = m_nRegion;
+
+        if(m_Pieces.findPiece(nPrime, nRegion) == nRegions)
+        {
+            continue;                                       // Every sieved number is in some region, but be safe
+        }
+
+        moveTo(nRegion);
+        ++m_nEmitted;
+        if(m_fBinary)
+        {
+            m_nBufferVc.push_back(nPrime);
+        }
+        else
+        {
+            m_Out << nPrime << ' ';
+        }
+    }
+
+    if(m_fBinary)
+    {
+        m_Out.write(reinterpret_cast <const char*> (m_nBufferVc.data()), m_nBufferVc.size() * sizeof(uint64_t));
+        m_nBufferVc.clear();
+    }
+}
+
+/**
+ * @brief Finish all regions, write tables of regions and intervals and close the file
+ * @param None
+ * @return None
+ */
+void GroupedOutput::end()
+{
+    moveTo(m_Pieces.getPieces().size());
+    writeTables();
+    m_Out.close();
+
+    Profiler::get().setCounter("primes_emitted", m_nEmitted);
+}
+
+/**
+ * @brief Finishes regions before the given one (empty ones are written too) and starts it
+ * @param nRegion Region of the next prime (the number of regions to finish all)
+ * @return None
+ */
+void GroupedOutput::moveTo(size_t nRegion)
+{
+    for(; m_nRegion < nRegion; ++m_nRegion)
+    {
+        if(!m_fOpen)
+        {
+            openRegion(m_nRegion);
+        }
+        closeRegion();
+    }
+
+    if(nRegion < m_Pieces.getPieces().size() && !m_fOpen)
+    {
+        openRegion(nRegion);
+    }
+}
+
+/**
+ * @brief Starts the region: its first prime is the next one
+ * @param nRegion Index of the region
+ * @return None
+ */
+void GroupedOutput::openRegion(size_t nRegion)
+{
+    const Interval &Region = m_Pieces.getPieces()[nRegion];
+
+    m_nRegionFirstVc[nRegion] = m_nEmitted;
+    m_fOpen = true;
+    if(!m_fBinary)
+    {
+        m_Out << "  <region>\n    <id>" << nRegion << "</id>\n    <low>" << Region.m_nLowIntervalSide << "</low>\n    <high>"
+              << Region.m_nHighIntervalSide << "</high>\n    <primes> ";
+    }
+}
+
+/**
+ * @brief Finishes the current region
+ * @param None
+ * @return None
+ */
+void GroupedOutput::closeRegion()
+{
+    m_fOpen = false;
+    if(!m_fBinary)
+    {
+        m_Out << "</primes>\n  </region>\n";
+    }
+}
+
+/**
+ * @brief Writes the number to the binary file
+ * @param nVal Number
+ * @return None
+ */
+void GroupedOutput::writeUint(uint64_t nVal)
+{
+    m_Out.write(reinterpret_cast <const char*> (&nVal), sizeof(nVal));
+}
+
+/**
+ * @brief Writes tables of regions (binary file only) and intervals with references to their regions
+ * @param None
+ * @return None
+ */
+void GroupedOutput::writeTables()
+{
+    const std::vector <Interval> &RegionsVc = m_Pieces.getPieces();
+
+    m_nRegionFirstVc.back() = m_nEmitted;
+    if(m_fBinary)
+    {
+        uint64_t nOffset = 16 + m_nEmitted * sizeof(uint64_t);     // Header and primes
+
+        for(size_t j = 0, q = RegionsVc.size(); j < q; ++j)
+        {
+            writeUint(RegionsVc[j].m_nLowIntervalSide);
+            writeUint(RegionsVc[j].m_nHighIntervalSide);
+            writeUint(m_nRegionFirstVc[j]);
+            writeUint(m_nRegionFirstVc[j + 1] - m_nRegionFirstVc[j]);
+        }
+
+        for(size_t i = 0, p = m_pOrigVc->size(); i < p; ++i)
+        {
+            writeUint((*m_pOrigVc)[i].m_nLowIntervalSide);
+            writeUint((*m_pOrigVc)[i].m_nHighIntervalSide);
+            writeUint(m_Pieces.getFirstPiece(i));
+            writeUint(m_Pieces.getPiecesNum(i));
+        }
+
+        writeUint(RegionsVc.size());
+        writeUint(m_pOrigVc->size());
+        writeUint(nOffset);
+        return;
+    }
+
+    m_Out << "</regions>\n<intervals>\n";
+    for(size_t i = 0, p = m_pOrigVc->size(); i < p; ++i)
+    {
+        m_Out << "  <interval>\n    <id>" << i << "</id>\n    <low>" << (*m_pOrigVc)[i].m_nLowIntervalSide
+              << "</low>\n    <high>" << (*m_pOrigVc)[i].m_nHighIntervalSide << "</high>\n    <regions> ";
+        for(size_t j = m_Pieces.getFirstPiece(i), q = j + m_Pieces.getPiecesNum(i); j < q; ++j)
+        {
+            m_Out << j << ' ';
+        }
+        m_Out << "</regions>\n  </interval>\n";
+    }
+    m_Out << "</intervals>\n</root>";
+}
+
+//*****************************************************************************************
@@ -0,0 +1,65 @@
+/**
+  *************************************************************************************************************************
+  * @file    groupedoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which writes primes grouped by intervals as they are
+  *          given (not merged). The merged union is sieved once, primes are written once by disjoint regions (pieces
+  *          of IntervalPieces), and every interval refers to its regions by their ids, so overlaps are not copied.
+  *          The XML file is <root><regions><region>...</regions><intervals><interval>...</intervals></root>.
+  *          The binary file (numbers are uint64_t in the byte order of the machine):
+  *          header   - magic "PRMGROUP", uint32_t version, uint32_t reserved (0)
+  *          primes   - primes of all regions in ascending order
+  *          regions  - low, high, index of the first prime, number of primes of every region
+  *          intervals- low, high, the first region, number of regions of every interval (the index is the id)
+  *          footer   - number of regions, number of intervals, offset of the table of regions in bytes
+  **************************************************************************************************************************
+*/
+
+#ifndef GROUPEDOUTPUT_H
+#define GROUPEDOUTPUT_H
+
+#include <vector>
+#include <fstream>
+
+#include "primesoutput.hpp"
+#include "interval.hpp"
+#include "intervalpieces.h"
+
+class GroupedOutput: public PrimesOutput
+{
+public:
+    GroupedOutput(const char *pFileName, const std::vector <Interval> *pOrigVc, bool fBinary = false);
+    virtual ~GroupedOutput() override;
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+private:
+    static constexpr uint32_t m_nVersion = 1;               // Version of the binary file
+
+    const char *m_pFileName;
+    const std::vector <Interval> *m_pOrigVc;                // Intervals as they are given, the index is the id
+    bool m_fBinary;                                         // Binary file instead of XML
+    IntervalPieces m_Pieces;                                // Regions: disjoint pieces of intervals
+    std::ofstream m_Out;                                    // File of the stream
+    std::vector <uint64_t> m_nRegionFirstVc;                // Index of the first prime of every region
+    std::vector <uint64_t> m_nBufferVc;                     // Primes of the binary file to write at once
+    size_t m_nRegion;                                       // Region of the last prime
+    bool m_fOpen;                                           // Region m_nRegion has been started
+    uint64_t m_nEmitted;                                    // Number of primes written in the stream
+
+    void moveTo(size_t nRegion);                            // Finish regions before nRegion and start it
+    void openRegion(size_t nRegion);
+    void closeRegion();
+    void writeUint(uint64_t nVal);
+    void writeTables();
+};
+
+#endif // GROUPEDOUTPUT_H
+
+//*****************************************************************************************
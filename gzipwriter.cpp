@@ -0,0 +1,360 @@
+/**
+  *************************************************************************************************************************
+  * @file    gzipwriter.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to write the gzip file compressed by worker threads. Data are cut into blocks, every block is
+  *          compressed independently into the complete gzip member and members are written in order, so the file is
+  *          the standard concatenation of members (RFC 1952) which any gunzip reads. The file may be synced and
+  *          continued after any member, so the stream supports checkpoints
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <zlib.h>
+
+#include "gzipwriter.h"
+#include "checkpoint.h"
+
+/**
+ * @brief Class GzipWriter constructor. With the memory limit blocks are reduced to 1/4 of the largest size, then
+ *        threads are reduced, then blocks are reduced to the smallest size
+ * @param pFileName Name of the file to write in
+ * @param nThreads Number of compressing threads (0 - one per core)
+ * @param nLevel Level of compression 1...9
+ * @param nMemory Bytes for blocks, members and states of zlib (0 - no limit)
+ */
+GzipWriter::GzipWriter(const char *pFileName, uint32_t nThreads, int nLevel, uint64_t nMemory): m_pFileName(pFileName),
+    m_nThreads(nThreads ? nThreads : std::thread::hardware_concurrency()), m_nLevel(nLevel), m_nBlockSize(m_nMaxBlockSize),
+    m_nSlots(0), m_nSubmitted(0), m_nTaken(0), m_nWritten(0), m_nRawBytes(0), m_nPackedBytes(0), m_fStop(false)
+{
+    if(!m_nThreads)
+    {
+        m_nThreads = 1;                                                     // Number of cores is unknown
+    }
+
+    while(nMemory && getMemory(m_nThreads, m_nBlockSize) > nMemory)
+    {
+        if(m_nBlockSize > m_nMaxBlockSize / 4 || (m_nThreads == 1 && m_nBlockSize > m_nMinBlockSize))
+        {
+            m_nBlockSize /= 2;
+        }
+        else if(m_nThreads > 1)
+        {
+            --m_nThreads;
+        }
+        else
+        {
+            break;                                                          // The smallest writer, the budget is checked by FindPrimes
+        }
+    }
+
+    m_nSlots = m_nThreads * m_nSlotsPerThread;
+    m_pSlots.reset(new Slot[m_nSlots]);
+}
+
+/**
+ * @brief Class GzipWriter destructor. Data given to the writer are written if the file is still open
+ */
+GzipWriter::~GzipWriter()
+{
+    if(m_Out.is_open())
+    {
+        close();
+    }
+}
+
+/**
+ * @brief Open the file and start compressing threads. The file written before is cut after the offset, which must
+ *        be the end of the member, and continued
+ * @param nOffset Size of the file to continue (0 - the new file)
+ * @return false if the file can't be opened or it is shorter than the offset
+ */
+bool GzipWriter::open(uint64_t nOffset)
+{
+    if(nOffset)
+    {
+        std::ifstream In(m_pFileName, std::ios::in | std::ios::binary | std::ios::ate);
+
+        if(!In || static_cast <uint64_t> (In.tellg()) < nOffset)
+        {
+            return false;
+        }
+        In.close();
+
+        Checkpoint::truncateFile(m_pFileName, nOffset);
+        m_Out.open(m_pFileName, std::ios::in | std::ios::out | std::ios::binary);
+        m_Out.seekp(nOffset);
+    }
+    else
+    {
+        m_Out.open(m_pFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    }
+
+    if(!m_Out)
+    {
+        return false;
+    }
+
+    m_sBlock.clear();
+    m_sBlock.reserve(m_nBlockSize);
+    for(size_t i = 0; i < m_nSlots; ++i)
+    {
+        m_pSlots[i].m_eState = STATE_FREE;
+    }
+    m_nSubmitted = m_nTaken = m_nWritten = 0;
+    m_nRawBytes = m_nPackedBytes = 0;
+    m_fStop = false;
+
+    for(uint32_t i = 0; i < m_nThreads; ++i)
+    {
+        m_ThreadsVc.emplace_back(&GzipWriter::work, this);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Add data to the block, the filled block is given to threads
+ * @param pData Data
+ * @param nSize Number of bytes
+ * @return None
+ */
+void GzipWriter::write(const char *pData, size_t nSize)
+{
+    m_nRawBytes += nSize;
+    while(nSize)
+    {
+        size_t nPart = m_nBlockSize - m_sBlock.size();
+        if(nPart > nSize)
+        {
+            nPart = nSize;
+        }
+
+        m_sBlock.append(pData, nPart);
+        pData += nPart;
+        nSize -= nPart;
+
+        if(m_sBlock.size() == m_nBlockSize)
+        {
+            submit();
+        }
+    }
+}
+
+/**
+ * @brief Give the block to threads. If all slots are busy, the oldest member is awaited and written first. Members
+ *        which are ready are written at once, so the file grows while the data are given
+ * @param None
+ * @return None
+ */
+void GzipWriter::submit()
+{
+    std::unique_lock <std::mutex> Lock(m_Mutex);
+
+    while(m_nSubmitted - m_nWritten == m_nSlots)
+    {
+        writeNext(Lock);
+    }
+
+    Slot &Free = m_pSlots[m_nSubmitted % m_nSlots];
+    Free.m_sInput.swap(m_sBlock);
+    Free.m_eState = STATE_QUEUED;
+    ++m_nSubmitted;
+    m_Queued.notify_one();
+
+    while(m_nWritten < m_nSubmitted && m_pSlots[m_nWritten % m_nSlots].m_eState == STATE_DONE)
+    {
+        writeNext(Lock);
+    }
+
+    m_sBlock.clear();                                                       // Input of the slot freed before
+    m_sBlock.reserve(m_nBlockSize);
+}
+
+/**
+ * @brief Wait for the member of the block m_nWritten and write it. The file is written without the lock, so threads
+ *        keep compressing other blocks
+ * @param Lock Lock of m_Mutex taken by the caller
+ * @return None
+ */
+void GzipWriter::writeNext(std::unique_lock <std::mutex> &Lock)
+{
+    Slot &Next = m_pSlots[m_nWritten % m_nSlots];
+
+    m_Done.wait(Lock, [&Next] { return Next.m_eState == STATE_DONE; });
+
+    Lock.unlock();
+    m_Out.write(Next.m_sOutput.data(), Next.m_sOutput.size());
+    m_nPackedBytes += Next.m_sOutput.size();
+    Lock.lock();
+
+    Next.m_eState = STATE_FREE;
+    ++m_nWritten;
+}
+
+/**
+ * @brief Function of the compressing thread: take blocks in order until the writer stops
+ * @param None
+ * @return None
+ */
+void GzipWriter::work()
+{
+    std::unique_lock <std::mutex> Lock(m_Mutex);
+
+    for(;;)
+    {
+        m_Queued.wait(Lock, [this] { return m_fStop || m_nTaken < m_nSubmitted; });
+        if(m_nTaken == m_nSubmitted)
+        {
+            return;                                                         // The writer stops and all blocks are taken
+        }
+
+        Slot &Block = m_pSlots[m_nTaken++ % m_nSlots];                      // The writer waits until it's done
+
+        Lock.unlock();
+        compress(Block.m_sInput, Block.m_sOutput);
+        Lock.lock();
+
+        Block.m_eState = STATE_DONE;
+        m_Done.notify_all();
+    }
+}
+
+/**
+ * @brief Compress the block into the complete gzip member
+ * @param sInput Block
+ * @param sOutput String to write the member in
+ * @return None
+ */
+void GzipWriter::compress(const std::string &sInput, std::string &sOutput) const
+{
+    z_stream Stream;
+
+    Stream.zalloc = Z_NULL;
+    Stream.zfree = Z_NULL;
+    Stream.opaque = Z_NULL;
+    if(deflateInit2(&Stream, m_nLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)     // Window of 32 KB, gzip wrapper
+    {
+        std::cerr << "Compression error!\n";
+        exit(1);
+    }
+
+    sOutput.resize(deflateBound(&Stream, sInput.size()));
+    Stream.next_in = reinterpret_cast <Bytef*> (const_cast <char*> (sInput.data()));
+    Stream.avail_in = sInput.size();
+    Stream.next_out = reinterpret_cast <Bytef*> (&sOutput[0]);
+    Stream.avail_out = sOutput.size();
+
+    if(deflate(&Stream, Z_FINISH) != Z_STREAM_END)                          // The bound is enough for one call
+    {
+        std::cerr << "Compression error!\n";
+        exit(1);
+    }
+
+    sOutput.resize(Stream.total_out);
+    deflateEnd(&Stream);
+}
+
+/**
+ * @brief Give the last block to threads and write all members
+ * @param None
+ * @return None
+ */
+void GzipWriter::drain()
+{
+    if(!m_sBlock.empty())
+    {
+        submit();
+    }
+
+    std::unique_lock <std::mutex> Lock(m_Mutex);
+    while(m_nWritten < m_nSubmitted)
+    {
+        writeNext(Lock);
+    }
+}
+
+/**
+ * @brief Compress and write all data given, then write the file to the disk. The file ends with the complete member,
+ *        so it may be continued after this size
+ * @param nOffset Size of the file
+ * @return true if the file is good
+ */
+bool GzipWriter::flush(uint64_t &nOffset)
+{
+    drain();
+    m_Out.flush();
+    nOffset = m_Out.tellp();
+    Checkpoint::syncFile(m_pFileName);
+
+    return m_Out.good();
+}
+
+/**
+ * @brief Write all data, stop threads and close the file
+ * @param None
+ * @return true if the file is good
+ */
+bool GzipWriter::close()
+{
+    drain();
+
+    {
+        std::lock_guard <std::mutex> Lock(m_Mutex);
+        m_fStop = true;
+    }
+    m_Queued.notify_all();
+
+    for(std::thread &Thread : m_ThreadsVc)
+    {
+        Thread.join();
+    }
+    m_ThreadsVc.clear();
+    m_Out.close();
+
+    return !m_Out.fail();
+}
+
+/**
+ * @brief Estimated memory of the writer: blocks and members of all slots, the block being filled and states of zlib
+ *        of all threads
+ * @param nThreads Number of compressing threads (0 - one per core)
+ * @param nBlockSize Input of one member
+ * @return Bytes
+ */
+uint64_t GzipWriter::getMemory(uint32_t nThreads, size_t nBlockSize)
+{
+    if(!nThreads)
+    {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    return nThreads * (m_nSlotsPerThread * (nBlockSize + compressBound(nBlockSize) + m_nWrapperSize) + m_nDeflateMemory) +
+           nBlockSize;
+}
+
+/**
+ * @brief Returns number of bytes given to write() since the file has been opened
+ * @param None
+ * @return Number of bytes
+ */
+uint64_t GzipWriter::getRawBytes() const
+{
+    return m_nRawBytes;
+}
+
+/**
+ * @brief Returns number of bytes of members written since the file has been opened
+ * @param None
+ * @return Number of bytes
+ */
+uint64_t GzipWriter::getPackedBytes() const
+{
+    return m_nPackedBytes;
+}
+
+//*****************************************************************************************
@@ -0,0 +1,93 @@
+/**
+  *************************************************************************************************************************
+  * @file    gzipwriter.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to write the gzip file compressed by worker threads. Data are cut into blocks, every block is
+  *          compressed independently into the complete gzip member and members are written in order, so the file is
+  *          the standard concatenation of members (RFC 1952) which any gunzip reads. The file may be synced and
+  *          continued after any member, so the stream supports checkpoints
+  **************************************************************************************************************************
+*/
+
+#ifndef GZIPWRITER_H
+#define GZIPWRITER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <fstream>
+#include <stdint.h>
+
+class GzipWriter
+{
+public:
+    static constexpr int m_nDefaultLevel = 6;               // Level of zlib
+    static constexpr size_t m_nMaxBlockSize = 1 << 20;      // Input of one member
+    static constexpr size_t m_nMinBlockSize = 1 << 16;      // Blocks are reduced to it by the memory limit
+
+    GzipWriter(const char *pFileName, uint32_t nThreads = 0, int nLevel = m_nDefaultLevel, uint64_t nMemory = 0);
+    ~GzipWriter();
+
+    static uint64_t getMemory(uint32_t nThreads, size_t nBlockSize);   // Bytes of blocks, members and zlib (0 threads - one per core)
+
+    bool open(uint64_t nOffset = 0);                        // Create the file, or continue it after nOffset bytes (0 - new file)
+    void write(const char *pData, size_t nSize);
+    bool flush(uint64_t &nOffset);                          // Compress and write all data to the disk, get size of the file
+    bool close();
+
+    uint64_t getRawBytes() const;                           // Bytes given to write() since open()
+    uint64_t getPackedBytes() const;                        // Bytes of members written since open()
+
+private:
+    static constexpr uint32_t m_nSlotsPerThread = 2;        // Blocks queued or compressed at once by every thread
+    static constexpr size_t m_nDeflateMemory = (1 << 18) + (1 << 14);  // State of zlib: window, hash and small objects
+    static constexpr size_t m_nWrapperSize = 18;            // Header and trailer of the gzip member
+
+    enum State
+    {
+        STATE_FREE,
+        STATE_QUEUED,
+        STATE_DONE
+    };
+
+    struct Slot
+    {
+        State m_eState;
+        std::string m_sInput;                               // Block
+        std::string m_sOutput;                              // Member of the block
+    };
+
+    const char *m_pFileName;
+    uint32_t m_nThreads;
+    int m_nLevel;
+    size_t m_nBlockSize;                                    // Input of one member
+    std::ofstream m_Out;
+    std::string m_sBlock;                                   // Block being filled
+    std::unique_ptr <Slot []> m_pSlots;                     // Block n is in slot n % m_nSlots
+    size_t m_nSlots;
+    uint64_t m_nSubmitted;                                  // Number of blocks given to threads
+    uint64_t m_nTaken;                                      // Number of blocks taken by threads
+    uint64_t m_nWritten;                                    // Number of members written to the file
+    uint64_t m_nRawBytes;
+    uint64_t m_nPackedBytes;
+    bool m_fStop;
+    std::mutex m_Mutex;
+    std::condition_variable m_Queued;                       // Block is given to threads or the writer stops
+    std::condition_variable m_Done;                         // Block is compressed
+    std::vector <std::thread> m_ThreadsVc;
+
+    void submit();                                          // Give the filled block to threads
+    void drain();                                           // Give the last block and write all members
+    void writeNext(std::unique_lock <std::mutex> &Lock);    // Wait for the next member in order and write it
+    void work();                                            // Function of the compressing thread
+    void compress(const std::string &sInput, std::string &sOutput) const;
+};
+
+#endif // GZIPWRITER_H
+
+//*****************************************************************************************
@@ -0,0 +1,134 @@
+/**
+  *************************************************************************************************************************
+  * @file    intervalpieces.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to split numbers of intervals as they are given (not merged, they may overlap) into disjoint pieces
+  *          by ends of all intervals. The union of intervals is sieved once, and results of every piece are found once,
+  *          every given interval is the sequence of the next pieces, so shared numbers are referenced, not copied
+  **************************************************************************************************************************
+*/
+
+#include <algorithm>
+
+#include "intervalpieces.h"
+
+/**
+ * @brief Class IntervalPieces constructor
+ * @param pOrigVc Intervals as they are given (IntervalsOutput fills them besides merged ones)
+ */
+IntervalPieces::IntervalPieces(const std::vector <Interval> *pOrigVc): m_pOrigVc(pOrigVc) {}
+
+/**
+ * @brief Class IntervalPieces destructor
+ */
+IntervalPieces::~IntervalPieces() {}
+
+/**
+ * @brief Splits numbers of all intervals into disjoint pieces by ends of intervals: every interval is a sequence
+ *        of pieces, and every piece is covered by at least one interval
+ * @param None
+ * @return None
+ */
+void IntervalPieces::make()
+{
+    std::vector <std::pair <uint64_t, int> > EventsVc;      // Number and change of the number of intervals which cover it
+
+    for(const Interval &Int : *m_pOrigVc)
+    {
+        EventsVc.emplace_back(Int.m_nLowIntervalSide, 1);
+        if(Int.m_nHighIntervalSide != ~static_cast <uint64_t> (0))
+        {
+            EventsVc.emplace_back(Int.m_nHighIntervalSide + 1, -1);
+        }
+    }
+    std::sort(EventsVc.begin(), EventsVc.end());
+
+    m_PiecesVc.clear();
+    int nCover(0);
+    for(size_t i = 0, p = EventsVc.size(); i < p; )
+    {
+        uint64_t nLow = EventsVc[i].first;
+
+        for(; i < p && EventsVc[i].first == nLow; ++i)
+        {
+            nCover += EventsVc[i].second;
+        }
+
+        if(nCover > 0)
+        {
+            m_PiecesVc.emplace_back(nLow, i < p ? EventsVc[i].first - 1 : ~static_cast <uint64_t> (0));
+        }
+    }
+
+    m_nFirstVc.resize(m_pOrigVc->size());
+    m_nNumVc.resize(m_pOrigVc->size());
+    for(size_t i = 0, p = m_pOrigVc->size(); i < p; ++i)
+    {
+        const Interval &Int = (*m_pOrigVc)[i];
+        std::vector <Interval>::const_iterator First = std::lower_bound(m_PiecesVc.begin(), m_PiecesVc.end(), Int,
+        [] (const Interval &Piece, const Interval &Cur)
+        {
+            return Piece.m_nLowIntervalSide < Cur.m_nLowIntervalSide;
+        });
+        std::vector <Interval>::const_iterator Last = First;
+
+        while(Last != m_PiecesVc.end() && Last->m_nLowIntervalSide <= Int.m_nHighIntervalSide)
+        {
+            ++Last;
+        }
+
+        m_nFirstVc[i] = First - m_PiecesVc.begin();
+        m_nNumVc[i] = Last - First;
+    }
+}
+
+/**
+ * @brief Returns disjoint pieces of intervals
+ * @param None
+ * @return Pieces in ascending order
+ */
+const std::vector <Interval> &IntervalPieces::getPieces() const
+{
+    return m_PiecesVc;
+}
+
+/**
+ * @brief Returns the first piece of the interval
+ * @param nInt Index of the interval as it is given
+ * @return Index of the piece
+ */
+size_t IntervalPieces::getFirstPiece(size_t nInt) const
+{
+    return m_nFirstVc[nInt];
+}
+
+/**
+ * @brief Returns the number of pieces of the interval
+ * @param nInt Index of the interval as it is given
+ * @return Number of pieces
+ */
+size_t IntervalPieces::getPiecesNum(size_t nInt) const
+{
+    return m_nNumVc[nInt];
+}
+
+/**
+ * @brief Moves the piece forward to the piece of the number. Numbers are given in ascending order, so the piece
+ *        is never moved back
+ * @param nNum Number
+ * @param nPiece Piece of the previous number (it is moved forward)
+ * @return nPiece if the number is in it, otherwise the number of pieces
+ */
+size_t IntervalPieces::findPiece(uint64_t nNum, size_t &nPiece) const
+{
+    while(nPiece < m_PiecesVc.size() && m_PiecesVc[nPiece].m_nHighIntervalSide < nNum)
+    {
+        ++nPiece;
+    }
+
+    return (nPiece < m_PiecesVc.size() && m_PiecesVc[nPiece].m_nLowIntervalSide <= nNum ? nPiece : m_PiecesVc.size());
+}
+
+//*****************************************************************************************
@@ -0,0 +1,43 @@
+/**
+  *************************************************************************************************************************
+  * @file    intervalpieces.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to split numbers of intervals as they are given (not merged, they may overlap) into disjoint pieces
+  *          by ends of all intervals. The union of intervals is sieved once, and results of every piece are found once,
+  *          every given interval is the sequence of the next pieces, so shared numbers are referenced, not copied
+  **************************************************************************************************************************
+*/
+
+#ifndef INTERVALPIECES_H
+#define INTERVALPIECES_H
+
+#include <vector>
+#include <cstddef>
+
+#include "interval.hpp"
+
+class IntervalPieces
+{
+public:
+    IntervalPieces(const std::vector <Interval> *pOrigVc);
+    ~IntervalPieces();
+
+    void make();                                            // Split intervals again (they may be read after construction)
+
+    const std::vector <Interval> &getPieces() const;        // Disjoint pieces in ascending order
+    size_t getFirstPiece(size_t nInt) const;                // The first piece of the given interval nInt
+    size_t getPiecesNum(size_t nInt) const;                 // Number of pieces of the given interval nInt
+    size_t findPiece(uint64_t nNum, size_t &nPiece) const;  // Moves nPiece forward to the piece of the number
+
+private:
+    const std::vector <Interval> *m_pOrigVc;                // Intervals as they are given, the index is the interval's id
+    std::vector <Interval> m_PiecesVc;                      // Disjoint pieces in ascending order
+    std::vector <size_t> m_nFirstVc;                        // The first piece of every interval
+    std::vector <size_t> m_nNumVc;                          // Number of pieces of every interval
+};
+
+#endif // INTERVALPIECES_H
+
+//*****************************************************************************************
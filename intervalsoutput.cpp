@@ -1,102 +1,102 @@
-/**
-  ******************************************************************************************************************************
-  * @file    intervalsoutput.cpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    18-December-2018
-  * @brief   Derived class from the abstract class Xml_output.hpp which implements getting numeric intervals from the parsed xml file
-  ******************************************************************************************************************************
-*/
-
-#include <algorithm>
-
-#include "intervalsoutput.h"
-
-/**
- * @brief Class IntervalsOutput constructor
- * @param IntVc Container to fill intervals in
- */
-IntervalsOutput::IntervalsOutput(std::vector<Interval> *pIntVc): XML_output(), m_pIntVc(pIntVc) {}
-
-/**
- * @brief Class IntervalsOutput destructor
- */
-IntervalsOutput::~IntervalsOutput() {}
-
-/**
- * @brief Implementation of the abstract function to get intervals from tags
- * @param IntVc Container to fill intervals in
- * @return None
- */
-void IntervalsOutput::output(const ReadXml &ParserXml)
-{
-    size_t nCurPos(0);
-
-    for(Tag tag = ParserXml.getTag(nCurPos, "intervals"); tag.getName() != "EMPTY_TAG"; tag = ParserXml.getTag(nCurPos, "intervals"))
-    {
-        getIntervals(tag.getInternalTags());
-    }
-}
-
-/**
- * @brief Function to get intervals from tags, arrange them (sort and merge, if them intersect)
- * @param TagShVc Container of tags which contains intervals data
- * @return None
- */
-void IntervalsOutput::getIntervals(VectorTagShared TagShVc)
-{
-    uint32_t nLowIntervalSide(0), nHighIntervalSide(0);
-    bool fAdd(true);
-
-    for(size_t i = 0, p = TagShVc.size(); i < p; ++i)
-    {
-        nLowIntervalSide = (TagShVc[i]->getTag("low")).getValue();      //
-        nHighIntervalSide = (TagShVc[i]->getTag("high")).getValue();    // Get values
-
-        if(nLowIntervalSide > nHighIntervalSide)                          // If Low and High are mixed, swap them
-        {
-            uint32_t nTmp = nLowIntervalSide;
-            nLowIntervalSide = nHighIntervalSide;
-            nHighIntervalSide = nTmp;
-        }
-
-        for(size_t j = 0, q = m_pIntVc->size(); j < q; ++j)                // If intervals intersect, merge them
-        {
-            if(nLowIntervalSide < (*m_pIntVc)[j].m_nLowIntervalSide)
-            {
-                if(nHighIntervalSide > (*m_pIntVc)[j].m_nHighIntervalSide)
-                {
-                    (*m_pIntVc)[j].m_nLowIntervalSide = nLowIntervalSide;
-                    (*m_pIntVc)[j].m_nHighIntervalSide = nHighIntervalSide;
-                    fAdd = false;
-                }
-                else if(nHighIntervalSide > (*m_pIntVc)[j].m_nLowIntervalSide)
-                {
-                    (*m_pIntVc)[j].m_nLowIntervalSide = nLowIntervalSide;
-                    fAdd = false;
-                }
-            }
-            else if(nLowIntervalSide <= (*m_pIntVc)[j].m_nHighIntervalSide)
-            {
-                if(nHighIntervalSide > (*m_pIntVc)[j].m_nHighIntervalSide)
-                {
-                    (*m_pIntVc)[j].m_nHighIntervalSide = nHighIntervalSide;
-                }
-                fAdd = false;
-            }
-        }
-
-        if(fAdd)
-        {
-            m_pIntVc->emplace_back(nLowIntervalSide, nHighIntervalSide);    // Result write into vector
-        }
-        else
-        {
-            fAdd = true;
-        }
-    }
-    std::sort(m_pIntVc->begin(), m_pIntVc->end());                           // Sorting
-}
-
-//*******************************************************************************************************
-
+/**
+  ******************************************************************************************************************************
+  * @file    intervalsoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    18-December-2018
+  * @brief   Derived class from the abstract class Xml_output.hpp which implements getting numeric intervals from the parsed xml file
+  ******************************************************************************************************************************
+*/
+
+#include <algorithm>
+
+#include "intervalsoutput.h"
+#include "profiler.h"
+
+/**
+ * @brief Class IntervalsOutput constructor
+ * @param IntVc Container to fill intervals in
+ * @param pOrigVc Container to fill intervals in as they are read, before sorting and merging (nullptr if not needed)
+ */
+IntervalsOutput::IntervalsOutput(std::vector<Interval> *pIntVc, std::vector <Interval> *pOrigVc): XML_output(), m_pIntVc(pIntVc),
+    m_pOrigVc(pOrigVc) {}
+
+/**
+ * @brief Class IntervalsOutput destructor
+ */
+IntervalsOutput::~IntervalsOutput() {}
+
+/**
+ * @brief Implementation of the abstract function to get intervals from tags
+ * @param IntVc Container to fill intervals in
+ * @return None
+ */
+void IntervalsOutput::output(const ReadXml &ParserXml)
+{
+    size_t nCurPos(0);
+
+    for(Tag tag = ParserXml.getTag(nCurPos, "intervals"); tag.getName() != "EMPTY_TAG"; tag = ParserXml.getTag(nCurPos, "intervals"))
+    {
+        getIntervals(tag.getInternalTags());
+    }
+}
+
+/**
+ * @brief Function to get intervals from tags, arrange them (sort and merge, if them intersect or adjoin).
+ *        Every number belongs to one interval at most, so the intervals can be sieved separately
+ * @param TagShVc Container of tags which contains intervals data
+ * @return None
+ */
+void IntervalsOutput::getIntervals(VectorTagShared TagShVc)
+{
+    Profiler::ScopedTimer Timer("merge_intervals");
+    uint64_t nLowIntervalSide(0), nHighIntervalSide(0);
+
+    for(size_t i = 0, p = TagShVc.size(); i < p; ++i)
+    {
+        nLowIntervalSide = (TagShVc[i]->getTag("low")).getValue();      //
+        nHighIntervalSide = (TagShVc[i]->getTag("high")).getValue();    // Get values
+
+        if(nLowIntervalSide > nHighIntervalSide)                          // If Low and High are mixed, swap them
+        {
+            uint64_t nTmp = nLowIntervalSide;
+            nLowIntervalSide = nHighIntervalSide;
+            nHighIntervalSide = nTmp;
+        }
+
+        m_pIntVc->emplace_back(nLowIntervalSide, nHighIntervalSide);      // Result write into vector
+        if(m_pOrigVc)
+        {
+            m_pOrigVc->emplace_back(nLowIntervalSide, nHighIntervalSide);
+        }
+    }
+
+    std::sort(m_pIntVc->begin(), m_pIntVc->end());                        // Sorting
+
+    size_t nLast(0);
+    for(size_t i = 1, p = m_pIntVc->size(); i < p; ++i)                   // Merging
+    {
+        Interval &Last = (*m_pIntVc)[nLast];
+
+        uint64_t nLow = (*m_pIntVc)[i].m_nLowIntervalSide;
+
+        if(nLow <= Last.m_nHighIntervalSide || nLow - 1 == Last.m_nHighIntervalSide)
+        {
+            Last.m_nHighIntervalSide = std::max(Last.m_nHighIntervalSide, (*m_pIntVc)[i].m_nHighIntervalSide);
+        }
+        else
+        {
+            (*m_pIntVc)[++nLast] = (*m_pIntVc)[i];
+        }
+    }
+
+    if(!m_pIntVc->empty())
+    {
+        m_pIntVc->resize(nLast + 1);
+    }
+
+    Profiler::get().addCounter("intervals_read", TagShVc.size());
+}
+
+//*******************************************************************************************************
+
@@ -1,34 +1,350 @@
-#include <iostream>
-#include <vector>
-
-#include "readxml.h"
-#include "interval.hpp"
-#include "intervalsoutput.h"
-#include "findprimes.h"
-#include "primesconsoleoutput.h"
-#include "primesfileoutput.h"
-
-int main()
-{
-    const char *pFileName1 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/test.xml";
-    const char *pFileName2 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/primes.xml";
-    std::vector <Interval> IntVc;
-
-    ReadXml xml1(pFileName1, { "root" });
-    xml1.setOutput(new IntervalsOutput(&IntVc));
-    xml1.output();
-
-    for(uint32_t i = 0, p = IntVc.size(); i < p; ++i)
-        std::cout << "Low: " << IntVc[i].m_nLowIntervalSide << ", High: " << IntVc[i].m_nHighIntervalSide << '\n';
-    std::cout << '\n';
-
-    FindPrimes PrimeNumbers(&IntVc);
-
-    PrimeNumbers.setOutput(new PrimesConsoleOutput());
-    PrimeNumbers.output();
-
-    PrimeNumbers.setOutput(new PrimesFileOutput(pFileName2));
-    PrimeNumbers.output();
-
-    return 0;
-}
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "readxml.h"
+#include "interval.hpp"
+#include "intervalsoutput.h"
+#include "numbersoutput.h"
+#include "progressionoutput.h"
+#include "batchprimality.h"
+#include "findprimes.h"
+#include "primesconsoleoutput.h"
+#include "primesfileoutput.h"
+#include "primesgzipoutput.h"
+#include "primesteeoutput.h"
+#include "tuplesoutput.h"
+#include "tuplefinder.h"
+#include "statisticsoutput.h"
+#include "groupedoutput.h"
+#include "factorsieve.h"
+#include "factorsfileoutput.h"
+#include "shardcoordinator.h"
+#include "primesindex.h"
+#include "sharedprimesexport.h"
+#include "arena.h"
+#include "profiler.h"
+
+int main(int argc, char *argv[])
+{
+    const char *pReportName = nullptr;
+    bool fPerf(false);
+    bool fPipelined(false);
+    bool fTuplesList(false);
+    bool fStats(false);
+    const char *pGrouped = nullptr;
+    const char *pFactors = nullptr;
+    bool fSmallest(false);
+    uint32_t nShards(0);
+    const char *pLauncher = nullptr;
+    const char *pWorkerIn = nullptr;
+    const char *pWorkerOut = nullptr;
+    const char *pCheckpoint = nullptr;
+    const char *pShared = nullptr;
+    bool fGzip(false);
+    uint64_t nBudget(0);
+    Arena::HugePages eHugePages(Arena::HUGE_PAGES_NONE);
+    bool fPrefault(false);
+    std::vector <TuplePattern> PatternsVc;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--report") && i + 1 < argc)
+        {
+            pReportName = argv[++i];                         // JSON report of the phases' timing
+        }
+        else if(!strcmp(argv[i], "--perf"))
+        {
+            fPerf = true;                                    // Hardware counters in the report
+        }
+        else if(!strcmp(argv[i], "--pipelined"))
+        {
+            fPipelined = true;                               // Write primes while sieving
+        }
+        else if(!strcmp(argv[i], "--gzip"))
+        {
+            fGzip = true;                                    // File of primes is compressed by worker threads
+        }
+        else if(!strcmp(argv[i], "--checkpoint") && i + 1 < argc)
+        {
+            pCheckpoint = argv[++i];                         // File of checkpoints of the file of primes, the run is resumed from it
+            fPipelined = true;
+        }
+        else if(!strcmp(argv[i], "--memory-budget") && i + 1 < argc)
+        {
+            nBudget = strtoull(argv[++i], nullptr, 10) << 20;  // Megabytes of memory for the search
+            if(!nBudget)
+            {
+                std::cerr << "Wrong memory budget: " << argv[i] << '\n';
+                return 1;
+            }
+        }
+        else if(!strcmp(argv[i], "--huge-pages") && i + 1 < argc)
+        {
+            ++i;                                             // Buffers of the sieve and of files: "thp" or "explicit"
+            if(!strcmp(argv[i], "thp") || !strcmp(argv[i], "explicit"))
+            {
+                eHugePages = (!strcmp(argv[i], "thp") ? Arena::HUGE_PAGES_TRANSPARENT : Arena::HUGE_PAGES_EXPLICIT);
+            }
+            else
+            {
+                std::cerr << "Wrong kind of huge pages: " << argv[i] << '\n';
+                return 1;
+            }
+        }
+        else if(!strcmp(argv[i], "--prefault"))
+        {
+            fPrefault = true;                                // Pages of big buffers are touched by several threads at once
+        }
+        else if(!strcmp(argv[i], "--tuple") && i + 1 < argc)
+        {
+            PatternsVc.emplace_back();                       // Name of the k-tuple or its offsets, e.g. "0,2,6"
+            if(!TupleFinder::parsePattern(argv[++i], PatternsVc.back()))
+            {
+                std::cerr << "Wrong pattern of the tuple: " << argv[i] << '\n';
+                return 1;
+            }
+        }
+        else if(!strcmp(argv[i], "--tuples-list"))
+        {
+            fTuplesList = true;                              // First members of tuples, not only their number
+        }
+        else if(!strcmp(argv[i], "--stats"))
+        {
+            fStats = true;                                   // Count, sum and gaps of primes of every read interval
+        }
+        else if(!strcmp(argv[i], "--grouped") && i + 1 < argc)
+        {
+            pGrouped = argv[++i];                            // Primes by read intervals: "xml" or "bin"
+            if(strcmp(pGrouped, "xml") && strcmp(pGrouped, "bin"))
+            {
+                std::cerr << "Wrong format of grouped primes: " << pGrouped << '\n';
+                return 1;
+            }
+        }
+        else if(!strcmp(argv[i], "--factors") && i + 1 < argc)
+        {
+            pFactors = argv[++i];                            // Factors of every number of intervals: "xml" or "bin"
+            if(strcmp(pFactors, "xml") && strcmp(pFactors, "bin"))
+            {
+                std::cerr << "Wrong format of factors: " << pFactors << '\n';
+                return 1;
+            }
+        }
+        else if(!strcmp(argv[i], "--smallest"))
+        {
+            fSmallest = true;                                // Only the smallest prime factor of every number
+        }
+        else if(!strcmp(argv[i], "--shards") && i + 1 < argc)
+        {
+            nShards = strtoul(argv[++i], nullptr, 10);       // Primes are searched by worker processes
+            if(!nShards)
+            {
+                std::cerr << "Wrong number of shards: " << argv[i] << '\n';
+                return 1;
+            }
+        }
+        else if(!strcmp(argv[i], "--launcher") && i + 1 < argc)
+        {
+            pLauncher = argv[++i];                           // Command to start workers, e.g. "ssh node /path/PrimesProject"
+        }
+        else if(!strcmp(argv[i], "--shared") && i + 1 < argc)
+        {
+            pShared = argv[++i];                             // Name of POSIX shared memory to publish the result in
+        }
+        else if(!strcmp(argv[i], "--worker") && i + 2 < argc)
+        {
+            pWorkerIn = argv[++i];                           // Worker of the shard: xml file of intervals, binary file of primes
+            pWorkerOut = argv[++i];
+        }
+    }
+    Arena::get().configure(eHugePages, fPrefault);
+
+    if(pWorkerIn)
+    {
+        std::cout << ShardCoordinator::runWorker(pWorkerIn, pWorkerOut) << '\n';  // Status for the coordinator
+        return 0;
+    }
+
+    Profiler::get().setEnabled(pReportName != nullptr);
+    if(pReportName && fPerf && !Profiler::get().setPerfEnabled(true))
+    {
+        std::cerr << "Hardware counters are unavailable, only timers are reported\n";
+    }
+
+    const char *pFileName1 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/test.xml";
+    const char *pFileName2 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/primes.xml";
+    const char *pFileName3 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/tuples.xml";
+    const char *pFileName4 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/statistics.xml";
+    const char *pFileName5 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/grouped.xml";
+    const char *pFileName6 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/grouped.bin";
+    const char *pFileName7 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/factors.xml";
+    const char *pFileName8 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/factors.bin";
+    const char *pFileName9 = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/primes.xml.gz";
+    const char *pShardPrefix = "C:/Users/Workstation/Documents/CPP/PrimesProject 2/primes";
+    std::vector <Interval> IntVc, OrigVc;
+    std::vector <uint64_t> NumVc;
+    SieveSettings Settings(0, 0, 0, fPipelined);
+
+    Settings.m_nMemoryBudget = nBudget;
+    uint64_t nGzipMemory(0);                                 // Bytes of the compressing writer in the budget
+    if(fGzip && nBudget)
+    {
+        nGzipMemory = std::max(std::min(GzipWriter::getMemory(0, GzipWriter::m_nMaxBlockSize), nBudget / 4),   // A quarter of the budget at most
+                               GzipWriter::getMemory(1, GzipWriter::m_nMinBlockSize));
+        Settings.m_nOutputMemory = (nShards ? 0 : nGzipMemory);               // Shards are stitched after workers have finished
+    }
+    if(nBudget && ReadXml::estimateMemory(pFileName1) > nBudget)
+    {
+        std::cerr << "Memory budget of " << (nBudget >> 20) << " MB is too small to read " << pFileName1 << '\n';
+        return 1;
+    }
+
+    ReadXml xml1(pFileName1, { "root" });
+    xml1.setOutput(new IntervalsOutput(&IntVc, &OrigVc));
+    xml1.output();
+    xml1.setOutput(new NumbersOutput(&NumVc));
+    xml1.output();
+    xml1.setOutput(new ProgressionOutput(&Settings.m_Progression));
+    xml1.output();
+
+    if(!PatternsVc.empty() && Settings.m_Progression.m_nModulus != 1)
+    {
+        std::cerr << "Tuples need all primes, they can't be found in the progression\n";
+        return 1;
+    }
+
+    BatchPrimality Batch(&NumVc);
+    for(size_t i = 0, p = NumVc.size(); i < p; ++i)
+        std::cout << NumVc[i] << (Batch.getResult()[i] ? " is prime\n" : " is composite\n");
+    std::cout << '\n';
+
+    for(uint32_t i = 0, p = IntVc.size(); i < p; ++i)
+        std::cout << "Low: " << IntVc[i].m_nLowIntervalSide << ", High: " << IntVc[i].m_nHighIntervalSide << '\n';
+    std::cout << '\n';
+
+    if(pCheckpoint && (!PatternsVc.empty() || fStats || pGrouped))
+    {
+        std::cerr << "Checkpoint resumes only the file of primes\n";
+        return 1;
+    }
+
+    if(nShards)
+    {
+        if(!PatternsVc.empty() || fStats || pGrouped || pFactors || pShared)
+        {
+            std::cerr << "Shards write only the file of primes\n";
+            return 1;
+        }
+
+        ShardCoordinator Shards(&IntVc, nShards, pShardPrefix, Settings, pLauncher);    // Workers are started before any thread
+        if(fGzip)
+        {
+            Shards.setOutput(new PrimesGzipOutput(pFileName9, false, 0, GzipWriter::m_nDefaultLevel, nGzipMemory));
+        }
+        else
+        {
+            Shards.setOutput(new PrimesFileOutput(pFileName2));
+        }
+        Shards.output();
+        std::cout << "Number of primes: " << Shards.getPrimesNum() << " (" << Shards.getShards().size() << " shards)\n\n";
+
+        if(pReportName && !Profiler::get().writeJson(pReportName))
+        {
+            std::cerr << "Report writing error!\n";
+        }
+
+        return 0;
+    }
+
+    FindPrimes PrimeNumbers(&IntVc, Settings);
+    if(!PrimeNumbers.getSettings().m_fPipelined)             // The memory budget may make the search pipelined
+    {
+        std::cout << "Number of primes: " << PrimeNumbers.m_pPrimeNumVector->count() << "\n\n";
+    }
+
+    if(pShared)
+    {
+        if(PrimeNumbers.getSettings().m_fPipelined)
+        {
+            std::cerr << "Pipelined search doesn't keep the result to publish it\n";
+            return 1;
+        }
+
+        PrimesIndex Index(PrimeNumbers.m_pPrimeNumVector);
+        std::cout << "Shared generation: " << SharedPrimesExport(pShared).publish(PrimeNumbers.m_pPrimeNumVector, Index) << "\n\n";
+    }
+
+    std::vector <PrimesOutput*> OutputsVc;
+
+    if(!pCheckpoint)
+    {
+        OutputsVc.push_back(new PrimesConsoleOutput());     // The checkpointed file must be the only pass, it isn't printed
+    }
+
+    if(fGzip)
+    {
+        OutputsVc.push_back(new PrimesGzipOutput(pFileName9, false, 0, GzipWriter::m_nDefaultLevel, nGzipMemory));
+    }
+    else
+    {
+        OutputsVc.push_back(new PrimesFileOutput(pFileName2));
+    }
+
+    if(!PatternsVc.empty())
+    {
+        OutputsVc.push_back(new TuplesOutput(pFileName3, &IntVc, PatternsVc, fTuplesList));
+    }
+
+    if(fStats)
+    {
+        OutputsVc.push_back(new StatisticsOutput(pFileName4, &OrigVc));
+    }
+
+    if(pGrouped)
+    {
+        bool fBinary = !strcmp(pGrouped, "bin");
+
+        OutputsVc.push_back(new GroupedOutput(fBinary ? pFileName6 : pFileName5, &OrigVc, fBinary));
+    }
+
+    PrimeNumbers.setCheckpoint(pCheckpoint);
+    if(PrimeNumbers.getSettings().m_fPipelined && OutputsVc.size() > 1)
+    {
+        PrimesTeeOutput *pTee = new PrimesTeeOutput();      // Every pass of the pipelined mode sieves again, so there is one pass
+
+        for(PrimesOutput *pOutput : OutputsVc)
+        {
+            pTee->add(pOutput);
+        }
+        PrimeNumbers.setOutput(pTee);
+        PrimeNumbers.output();
+    }
+    else
+    {
+        for(PrimesOutput *pOutput : OutputsVc)
+        {
+            PrimeNumbers.setOutput(pOutput);
+            PrimeNumbers.output();
+        }
+    }
+    PrimeNumbers.setCheckpoint(nullptr);
+
+    if(pFactors)
+    {
+        bool fBinary = !strcmp(pFactors, "bin");
+        FactorSieve Factors(&IntVc, Settings, !fSmallest);
+
+        Factors.setOutput(new FactorsFileOutput(fBinary ? pFileName8 : pFileName7, fBinary));
+        Factors.output();
+    }
+
+    if(pReportName && !Profiler::get().writeJson(pReportName))
+    {
+        std::cerr << "Report writing error!\n";
+    }
+
+    return 0;
+}
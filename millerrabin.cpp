@@ -0,0 +1,235 @@
+/**
+  *************************************************************************************************************************
+  * @file    millerrabin.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Deterministic Miller-Rabin primality test for 64-bit numbers with Montgomery multiplication.
+  *          The set of 7 bases (J. Sinclair) gives the exact answer for every number less than 2^64
+  **************************************************************************************************************************
+*/
+
+#include "millerrabin.h"
+
+/**
+ * @brief Class MillerRabin constructor for the unused lane of the batch
+ * @param None
+ */
+MillerRabin::MillerRabin(): m_nMod(1), m_nInv(1), m_nOne(0), m_nMinusOne(0), m_nR2(0) {}
+
+/**
+ * @brief Class MillerRabin constructor. Prepares constants of Montgomery multiplication for the odd modulus
+ * @param nMod Odd modulus
+ */
+MillerRabin::MillerRabin(uint64_t nMod): m_nMod(nMod), m_nInv(nMod)
+{
+    for(uint32_t i = 0; i < 5; ++i)                                         // Newton's iterations: 3 -> 6 -> ... -> 96 bits
+    {
+        m_nInv *= 2 - nMod * m_nInv;
+    }
+
+    m_nOne = (0 - nMod) % nMod;
+    m_nR2 = static_cast <unsigned __int128> (m_nOne) * m_nOne % nMod;
+    m_nMinusOne = nMod - m_nOne;
+}
+
+/**
+ * @brief Montgomery reduction: returns nVal / 2^64 modulo m_nMod. Low words of nVal and of m * m_nMod are equal,
+ *        so only high words are subtracted and the sum never overflows
+ * @param nVal Value less than m_nMod * 2^64
+ * @return nRes Reduced value less than m_nMod
+ */
+inline uint64_t MillerRabin::reduce(unsigned __int128 nVal) const
+{
+    uint64_t m = static_cast <uint64_t> (nVal) * m_nInv;
+    uint64_t nHigh = nVal >> 64;
+    uint64_t nMulHigh = (static_cast <unsigned __int128> (m) * m_nMod) >> 64;
+    uint64_t nRes = nHigh - nMulHigh;
+
+    return (nHigh < nMulHigh ? nRes + m_nMod : nRes);
+}
+
+/**
+ * @brief Product of two numbers in Montgomery form
+ * @param nA First number
+ * @param nB Second number
+ * @return Product in Montgomery form
+ */
+inline uint64_t MillerRabin::mul(uint64_t nA, uint64_t nB) const
+{
+    return reduce(static_cast <unsigned __int128> (nA) * nB);
+}
+
+/**
+ * @brief Convert the number into Montgomery form
+ * @param nVal Number less than m_nMod
+ * @return Number in Montgomery form
+ */
+inline uint64_t MillerRabin::toMontgomery(uint64_t nVal) const
+{
+    return mul(nVal, m_nR2);
+}
+
+/**
+ * @brief Strong probable prime test of m_nMod = nOdd * 2^nPow + 1 to the base nBase
+ * @param nBase Base of the test
+ * @param nOdd Odd part of m_nMod - 1
+ * @param nPow Power of 2 in m_nMod - 1
+ * @return true if m_nMod is strong probable prime to the base nBase
+ */
+bool MillerRabin::isStrongProbablePrime(uint64_t nBase, uint64_t nOdd, uint32_t nPow) const
+{
+    nBase %= m_nMod;
+    if(!nBase)
+    {
+        return true;                                                        // The base is multiple of the number, skip it
+    }
+
+    uint64_t nRes = m_nOne, nCur = toMontgomery(nBase);
+    for(; nOdd; nOdd >>= 1)
+    {
+        if(nOdd & 1)
+        {
+            nRes = mul(nRes, nCur);
+        }
+        nCur = mul(nCur, nCur);
+    }
+
+    if(nRes == m_nOne || nRes == m_nMinusOne)
+    {
+        return true;
+    }
+
+    for(uint32_t i = 1; i < nPow; ++i)
+    {
+        nRes = mul(nRes, nRes);
+        if(nRes == m_nMinusOne)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Check the number by small divisors
+ * @param nVal Number to check
+ * @return 1 if nVal is prime, 0 if it is composite, -1 if the Miller-Rabin test is needed
+ */
+int MillerRabin::checkSmall(uint64_t nVal)
+{
+    static const uint32_t nSmallPrimes[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+    if(nVal < 2)
+    {
+        return 0;
+    }
+
+    for(uint32_t nPrime : nSmallPrimes)                                     // Small divisors are checked directly
+    {
+        if(!(nVal % nPrime))
+        {
+            return (nVal == nPrime ? 1 : 0);
+        }
+    }
+
+    return (nVal < 37 * 37 ? 1 : -1);
+}
+
+/**
+ * @brief Deterministic primality test for any 64-bit number
+ * @param nVal Number to test
+ * @return true if nVal is prime
+ */
+bool MillerRabin::isPrime(uint64_t nVal)
+{
+    static const uint64_t nBases[] = { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+
+    int nSmall = checkSmall(nVal);
+    if(nSmall >= 0)
+    {
+        return nSmall;
+    }
+
+    uint64_t nOdd = nVal - 1;
+    uint32_t nPow = __builtin_ctzll(nOdd);
+    nOdd >>= nPow;
+
+    MillerRabin Test(nVal);
+    for(uint64_t nBase : nBases)
+    {
+        if(!Test.isStrongProbablePrime(nBase, nOdd, nPow))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Batch primality test. Numbers are screened by the base 2 in groups of m_nLanes: exponentiations of the
+ *        group run in one loop, so independent Montgomery multiplications of different lanes overlap in the CPU
+ *        pipeline. Most composites fail here, survivors go to the full deterministic test
+ * @param pVals Numbers to test
+ * @param nCount Number of numbers
+ * @param pRes Array to write results in (1 - prime, 0 - composite)
+ * @return None
+ */
+void MillerRabin::isPrime(const uint64_t *pVals, size_t nCount, uint8_t *pRes)
+{
+    for(size_t i = 0; i < nCount; i += m_nLanes)
+    {
+        MillerRabin Tests[m_nLanes];
+        uint64_t nOdd[m_nLanes] = { 0 }, nRes[m_nLanes] = { 0 }, nCur[m_nLanes] = { 0 };
+        uint32_t nPow[m_nLanes] = { 0 };
+        uint32_t nLanes = (nCount - i < m_nLanes ? nCount - i : m_nLanes);
+        uint64_t nMaxOdd(0);
+
+        for(uint32_t j = 0; j < nLanes; ++j)
+        {
+            int nSmall = checkSmall(pVals[i + j]);
+            pRes[i + j] = (nSmall > 0 ? 1 : 0);
+
+            if(nSmall < 0)                                                  // The lane takes part in the screening
+            {
+                Tests[j] = MillerRabin(pVals[i + j]);
+                nPow[j] = __builtin_ctzll(pVals[i + j] - 1);
+                nOdd[j] = (pVals[i + j] - 1) >> nPow[j];
+                nRes[j] = Tests[j].m_nOne;
+                nCur[j] = Tests[j].toMontgomery(2);
+                nMaxOdd |= nOdd[j];
+            }
+        }
+
+        for(uint64_t nBit = 1; nBit && nBit <= nMaxOdd; nBit <<= 1)        // Interleaved exponentiation 2^nOdd
+        {
+            for(uint32_t j = 0; j < m_nLanes; ++j)
+            {
+                uint64_t nMul = Tests[j].mul(nRes[j], nCur[j]);
+                nRes[j] = (nOdd[j] & nBit ? nMul : nRes[j]);
+                nCur[j] = Tests[j].mul(nCur[j], nCur[j]);
+            }
+        }
+
+        for(uint32_t j = 0; j < nLanes; ++j)
+        {
+            if(!nOdd[j])
+            {
+                continue;                                                   // The lane has been decided by small divisors
+            }
+
+            bool fProbable = (nRes[j] == Tests[j].m_nOne || nRes[j] == Tests[j].m_nMinusOne);
+            for(uint32_t k = 1; !fProbable && k < nPow[j]; ++k)
+            {
+                nRes[j] = Tests[j].mul(nRes[j], nRes[j]);
+                fProbable = (nRes[j] == Tests[j].m_nMinusOne);
+            }
+
+            pRes[i + j] = (fProbable && isPrime(pVals[i + j]) ? 1 : 0);
+        }
+    }
+}
+
+//*****************************************************************************************
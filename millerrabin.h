@@ -0,0 +1,46 @@
+/**
+  *************************************************************************************************************************
+  * @file    millerrabin.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Deterministic Miller-Rabin primality test for 64-bit numbers with Montgomery multiplication.
+  *          The set of 7 bases (J. Sinclair) gives the exact answer for every number less than 2^64
+  **************************************************************************************************************************
+*/
+
+#ifndef MILLERRABIN_H
+#define MILLERRABIN_H
+
+#include <cstddef>
+#include <stdint.h>
+
+class MillerRabin
+{
+public:
+    static bool isPrime(uint64_t nVal);
+    static void isPrime(const uint64_t *pVals, size_t nCount, uint8_t *pRes);   // Batch test, lanes are interleaved
+
+private:
+    static constexpr uint32_t m_nLanes = 4;                 // Number of numbers tested together in the batch
+
+    uint64_t m_nMod;                                        // Odd modulus
+    uint64_t m_nInv;                                        // Inverse of the modulus modulo 2^64
+    uint64_t m_nOne;                                        // 2^64 mod m_nMod (1 in Montgomery form)
+    uint64_t m_nMinusOne;                                   // m_nMod - 1 in Montgomery form
+    uint64_t m_nR2;                                         // 2^128 mod m_nMod (to convert into Montgomery form)
+
+    MillerRabin();
+    explicit MillerRabin(uint64_t nMod);
+
+    static int checkSmall(uint64_t nVal);                   // 1 - prime, 0 - composite, -1 - needs the test
+
+    uint64_t reduce(unsigned __int128 nVal) const;          // nVal / 2^64 mod m_nMod
+    uint64_t mul(uint64_t nA, uint64_t nB) const;           // Product in Montgomery form
+    uint64_t toMontgomery(uint64_t nVal) const;
+    bool isStrongProbablePrime(uint64_t nBase, uint64_t nOdd, uint32_t nPow) const;
+};
+
+#endif // MILLERRABIN_H
+
+//*****************************************************************************************
@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************************************************************
+  * @file    numbersoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class Xml_output.hpp which implements getting the list of separate numbers
+  *          from the parsed xml file
+  ******************************************************************************************************************************
+*/
+
+#include "numbersoutput.h"
+
+/**
+ * @brief Class NumbersOutput constructor
+ * @param pNumVc Container to fill numbers in
+ */
+NumbersOutput::NumbersOutput(std::vector <uint64_t> *pNumVc): XML_output(), m_pNumVc(pNumVc) {}
+
+/**
+ * @brief Class NumbersOutput destructor
+ */
+NumbersOutput::~NumbersOutput() {}
+
+/**
+ * @brief Implementation of the abstract function to get numbers from tags. Order of numbers is kept, so the result
+ *        of the batch test corresponds to the input list
+ * @param ParserXml Parsed xml file
+ * @return None
+ */
+void NumbersOutput::output(const ReadXml &ParserXml)
+{
+    size_t nCurPos(0);
+
+    for(Tag tag = ParserXml.getTag(nCurPos, "numbers"); tag.getName() != "EMPTY_TAG"; tag = ParserXml.getTag(nCurPos, "numbers"))
+    {
+        VectorTagShared TagShVc = tag.getInternalTags();
+
+        for(size_t i = 0, p = TagShVc.size(); i < p; ++i)
+        {
+            if(TagShVc[i]->getName() == "number")
+            {
+                m_pNumVc->push_back(TagShVc[i]->getValue());
+            }
+        }
+    }
+}
+
+//*******************************************************************************************************
@@ -0,0 +1,34 @@
+/**
+  ******************************************************************************************************************************
+  * @file    numbersoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class Xml_output which implements getting the list of separate numbers
+  *          (<numbers> <number> 97 </number> ... </numbers>) from the parsed xml file
+  ******************************************************************************************************************************
+*/
+
+#ifndef NUMBERSOUTPUT_H
+#define NUMBERSOUTPUT_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "xml_output.hpp"
+
+class NumbersOutput: public XML_output
+{
+public:
+    NumbersOutput(std::vector <uint64_t> *pNumVc);
+    ~NumbersOutput() override;
+
+    void output(const ReadXml &ParserXml) override;
+
+private:
+    std::vector <uint64_t> *m_pNumVc;
+};
+
+#endif // NUMBERSOUTPUT_H
+
+//*****************************************************************************************
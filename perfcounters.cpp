@@ -0,0 +1,168 @@
+/**
+  *************************************************************************************************************************
+  * @file    perfcounters.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Hardware performance counters of the calling thread (cycles, instructions, L1D/LLC misses, branch misses,
+  *          dTLB misses) opened by perf_event_open. Counters are opened once per thread and read at the beginning and
+  *          the end of every phase. Where perf events are unavailable (not Linux, perf_event_paranoid, containers),
+  *          the counters are marked as invalid and the program works as before
+  **************************************************************************************************************************
+*/
+
+#include <cstring>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "perfcounters.h"
+
+#ifdef __linux__
+
+/**
+ * @brief Open the counting event for the calling thread on any CPU. Only user space is counted, so it works
+ *        with perf_event_paranoid up to 2
+ * @param nType Type of the event
+ * @param nConfig Configuration of the event
+ * @return Descriptor or -1
+ */
+static int openEvent(uint32_t nType, uint64_t nConfig)
+{
+    struct perf_event_attr Attr;
+
+    memset(&Attr, 0, sizeof(Attr));
+    Attr.size = sizeof(Attr);
+    Attr.type = nType;
+    Attr.config = nConfig;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    Attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(__NR_perf_event_open, &Attr, 0, -1, -1, 0);
+}
+
+/**
+ * @brief Configuration of the cache event
+ * @param nCache Cache
+ * @param nOp Operation
+ * @param nResult Result
+ * @return Configuration
+ */
+static uint64_t cacheConfig(uint64_t nCache, uint64_t nOp, uint64_t nResult)
+{
+    return nCache | (nOp << 8) | (nResult << 16);
+}
+
+#endif
+
+/**
+ * @brief Class PerfCounters constructor. Opens all events, unavailable ones stay closed
+ */
+PerfCounters::PerfCounters()
+{
+    for(int &nFd : m_nFd)
+    {
+        nFd = -1;
+    }
+
+#ifdef __linux__
+    m_nFd[CYCLES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    m_nFd[INSTRUCTIONS] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    m_nFd[L1D_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                                                  PERF_COUNT_HW_CACHE_RESULT_MISS));
+    m_nFd[LLC_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    m_nFd[BRANCH_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    m_nFd[DTLB_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                                                   PERF_COUNT_HW_CACHE_RESULT_MISS));
+#endif
+}
+
+/**
+ * @brief Class PerfCounters destructor. Closes events when the thread ends
+ */
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for(int nFd : m_nFd)
+    {
+        if(nFd >= 0)
+        {
+            close(nFd);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Counters of the calling thread. They are opened at the first call in the thread
+ * @param None
+ * @return Counters
+ */
+PerfCounters &PerfCounters::forThread()
+{
+    static thread_local PerfCounters Counters;
+
+    return Counters;
+}
+
+/**
+ * @brief Name of the event for the report
+ * @param nEvent Event
+ * @return Name
+ */
+const char *PerfCounters::getName(uint32_t nEvent)
+{
+    static const char *pNames[EVENTS_NUM] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+                                              "dtlb_misses" };
+
+    return (nEvent < EVENTS_NUM ? pNames[nEvent] : "");
+}
+
+/**
+ * @brief Check whether any counter is available
+ * @param None
+ * @return true if at least one event is opened
+ */
+bool PerfCounters::isAvailable() const
+{
+    for(int nFd : m_nFd)
+    {
+        if(nFd >= 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Read all counters. If the kernel multiplexes events, counts are scaled by the part of time the event was running
+ * @param Val Values to write in
+ * @return None
+ */
+void PerfCounters::read(Values &Val) const
+{
+    for(uint32_t i = 0; i < EVENTS_NUM; ++i)
+    {
+        Val.m_nCount[i] = 0;
+        Val.m_fValid[i] = false;
+
+#ifdef __linux__
+        uint64_t nData[3];                                                  // Value, time enabled, time running
+
+        if(m_nFd[i] >= 0 && ::read(m_nFd[i], nData, sizeof(nData)) == sizeof(nData))
+        {
+            Val.m_nCount[i] = (nData[2] && nData[2] < nData[1] ?
+                               static_cast <uint64_t> (static_cast <double> (nData[0]) * nData[1] / nData[2]) : nData[0]);
+            Val.m_fValid[i] = true;
+        }
+#endif
+    }
+}
+
+//*****************************************************************************************
@@ -0,0 +1,47 @@
+/**
+  *************************************************************************************************************************
+  * @file    perfcounters.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Hardware performance counters of the calling thread (cycles, instructions, L1D/LLC misses, branch misses,
+  *          dTLB misses) opened by perf_event_open. Counters are opened once per thread and read at the beginning and
+  *          the end of every phase. Where perf events are unavailable (not Linux, perf_event_paranoid, containers),
+  *          the counters are marked as invalid and the program works as before
+  **************************************************************************************************************************
+*/
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <stdint.h>
+
+class PerfCounters
+{
+public:
+    enum Event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES, EVENTS_NUM };
+
+    struct Values
+    {
+        uint64_t m_nCount[EVENTS_NUM];                      // Counts scaled by the multiplexing
+        bool m_fValid[EVENTS_NUM];                          // Counter has been opened and read
+    };
+
+    static PerfCounters &forThread();                       // Counters of the calling thread
+    static const char *getName(uint32_t nEvent);
+
+    bool isAvailable() const;                               // At least one counter is opened
+    void read(Values &Val) const;
+
+private:
+    int m_nFd[EVENTS_NUM];                                  // Descriptors of events, -1 if the event is unavailable
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator = (const PerfCounters &) = delete;
+};
+
+#endif // PERFCOUNTERS_H
+
+//*****************************************************************************************
@@ -0,0 +1,145 @@
+/**
+  *************************************************************************************************************************
+  * @file    presieve.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Pre-sieved patterns of the smallest initial primes after the primes of Wheel Factorisation.
+  *          Multiples of these primes repeat in every spoke with the period equal to the product of the primes,
+  *          so instead of crossing them off bit by bit, the segment is initialised by copying the pattern at the
+  *          right phase
+  **************************************************************************************************************************
+*/
+
+#include <algorithm>
+
+#include "presieve.h"
+#include "simdkernels.h"
+
+/**
+ * @brief Class PreSieve constructor
+ * @param None
+ */
+PreSieve::PreSieve(): m_nPrimesNum(0), m_nPeriod(1) {}
+
+/**
+ * @brief Class PreSieve destructor
+ */
+PreSieve::~PreSieve() {}
+
+/**
+ * @brief Choose primes next to the primes of the wheel while the patterns of all spokes fit the limit and build
+ *        the patterns. The pattern has 64 * m_nPeriod bits, it is multiple of every prime, so it repeats word by word
+ * @param nPrimesVc Initial primes
+ * @param nSpokesVc Spokes of Wheel Factorisation
+ * @param nPrimor Primorial of Wheel Factorisation
+ * @param nBegPrimesNum Number of initial primes of Wheel Factorisation
+ * @return None
+ */
+void PreSieve::init(const std::vector <uint32_t> &nPrimesVc, const std::vector <uint32_t> &nSpokesVc, uint32_t nPrimor,
+                    uint32_t nBegPrimesNum)
+{
+    uint32_t nNumOfSpokes = nSpokesVc.size();
+    uint32_t nEnd = nBegPrimesNum;
+
+    m_nPeriod = 1;
+    for(size_t p = nPrimesVc.size(); nNumOfSpokes && nEnd < p && m_nPeriod * nPrimesVc[nEnd] * nNumOfSpokes <= m_nMaxPatternsWords; ++nEnd)
+    {
+        m_nPeriod *= nPrimesVc[nEnd];
+    }
+
+    m_PatternsVc.assign(nNumOfSpokes, SieveWords(m_nPeriod, 0));
+    m_nPrimesSpokeVc.clear();
+    m_nPrimesBitVc.clear();
+    m_nPrimesNum = nEnd - nBegPrimesNum;
+
+    for(uint32_t i = nBegPrimesNum; i < nEnd; ++i)
+    {
+        uint64_t nVal = nPrimesVc[i];
+
+        for(uint32_t j = 0; j < nNumOfSpokes; ++j)
+        {
+            uint64_t k = 0;
+            while((k * nPrimor + nSpokesVc[j]) % nVal)                  // First multiple of the prime in the spoke
+            {
+                ++k;
+            }
+
+            for(uint64_t p = 64 * m_nPeriod; k < p; k += nVal)
+            {
+                setSieveBit(m_PatternsVc[j].data(), k);
+            }
+        }
+
+        // The prime itself is crossed off by the pattern too, so remember its bit to restore it (spokes of the progression
+        // may not contain it)
+        std::vector <uint32_t>::const_iterator Iter = std::lower_bound(nSpokesVc.begin(), nSpokesVc.end(), nVal % nPrimor);
+        if(Iter != nSpokesVc.end() && *Iter == nVal % nPrimor)
+        {
+            m_nPrimesSpokeVc.push_back(Iter - nSpokesVc.begin());
+            m_nPrimesBitVc.push_back(nVal / nPrimor);
+        }
+    }
+}
+
+/**
+ * @brief Returns number of initial primes (next to the primes of the wheel) which are crossed off by the patterns
+ * @param None
+ * @return Number of primes
+ */
+uint32_t PreSieve::getPrimesNum() const
+{
+    return m_nPrimesNum;
+}
+
+/**
+ * @brief Returns memory of the patterns of all spokes
+ * @param None
+ * @return Bytes
+ */
+size_t PreSieve::getMemoryUsage() const
+{
+    return m_PatternsVc.size() * m_nPeriod * sizeof(uint64_t);
+}
+
+/**
+ * @brief Cross off multiples of the pre-sieved primes in bits nLow...nHigh of the spoke. Words are combined with
+ *        the pattern by runs with the vector kernel. Interior words are empty, so it is the copy of the pattern,
+ *        and boundary words shared with the neighbour ranges keep their bits
+ * @param nSpokeIdx Index of the spoke
+ * @param pWords Bits of the block of the spoke
+ * @param nOrigin Index k of the first bit of the block (multiple of 64)
+ * @param nLow First bit of the range
+ * @param nHigh Last bit of the range
+ * @return None
+ */
+void PreSieve::apply(uint32_t nSpokeIdx, uint64_t *pWords, uint64_t nOrigin, uint64_t nLow, uint64_t nHigh) const
+{
+    if(!m_nPrimesNum)
+    {
+        return;
+    }
+
+    const uint64_t *pPattern = m_PatternsVc[nSpokeIdx].data();
+    const SimdKernels::Variant &Kernels = SimdKernels::get();
+    uint64_t nFirst = nLow >> 6, nLast = nHigh >> 6, nBase = nOrigin >> 6;          // Word w is pWords[w - nBase]
+
+    for(uint64_t w = nFirst; w <= nLast; )
+    {
+        uint64_t nPhase = w % m_nPeriod;
+        uint64_t nRun = std::min(m_nPeriod - nPhase, nLast - w + 1);
+
+        Kernels.m_pOr(pWords + (w - nBase), pPattern + nPhase, nRun);
+        w += nRun;
+    }
+
+    for(size_t i = 0, p = m_nPrimesBitVc.size(); i < p; ++i)                    // Restore the pre-sieved primes in all touched words
+    {
+        if(m_nPrimesSpokeVc[i] == nSpokeIdx && (m_nPrimesBitVc[i] >> 6) >= nFirst && (m_nPrimesBitVc[i] >> 6) <= nLast)
+        {
+            pWords[(m_nPrimesBitVc[i] >> 6) - nBase] &= ~(static_cast <uint64_t> (1) << (m_nPrimesBitVc[i] & 63));
+        }
+    }
+}
+
+//*****************************************************************************************
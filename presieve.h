@@ -0,0 +1,46 @@
+/**
+  *************************************************************************************************************************
+  * @file    presieve.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Pre-sieved patterns of the smallest initial primes after the primes of Wheel Factorisation.
+  *          Multiples of these primes repeat in every spoke with the period equal to the product of the primes,
+  *          so instead of crossing them off bit by bit, the segment is initialised by copying the pattern at the
+  *          right phase
+  **************************************************************************************************************************
+*/
+
+#ifndef PRESIEVE_H
+#define PRESIEVE_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "sievewords.hpp"
+
+class PreSieve
+{
+public:
+    PreSieve();
+    ~PreSieve();
+
+    void init(const std::vector <uint32_t> &nPrimesVc, const std::vector <uint32_t> &nSpokesVc, uint32_t nPrimor,
+              uint32_t nBegPrimesNum);
+    uint32_t getPrimesNum() const;                          // Number of initial primes crossed off by the patterns
+    size_t getMemoryUsage() const;                          // Bytes of the patterns
+    void apply(uint32_t nSpokeIdx, uint64_t *pWords, uint64_t nOrigin, uint64_t nLow, uint64_t nHigh) const;
+
+private:
+    static constexpr uint32_t m_nMaxPatternsWords = 1 << 18;   // Limit of the patterns size for all spokes (2 MB)
+
+    std::vector <SieveWords> m_PatternsVc;                  // Pattern of every spoke, m_nPeriod words
+    std::vector <uint32_t> m_nPrimesSpokeVc;                // Index of the spoke of every pre-sieved prime
+    std::vector <uint64_t> m_nPrimesBitVc;                  // Bit of the spoke of every pre-sieved prime
+    uint32_t m_nPrimesNum;                                  // Number of pre-sieved primes (some may be out of all spokes)
+    uint64_t m_nPeriod;                                     // Product of the pre-sieved primes (period of the pattern in words)
+};
+
+#endif // PRESIEVE_H
+
+//*****************************************************************************************
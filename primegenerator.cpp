@@ -0,0 +1,184 @@
+/**
+  *************************************************************************************************************************
+  * @file    primegenerator.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Pull-based generator of primes in given intervals. Intervals are cut into chunks as in the pipelined mode,
+  *          the next chunk is sieved only when the consumer takes all primes of the current one, so the consumer which
+  *          stops early does not pay for the rest of intervals. Initial primes up to square root of the highest number
+  *          are found in the constructor, so the high side of intervals should not be much greater than needed
+  **************************************************************************************************************************
+*/
+
+#include "primegenerator.h"
+
+/**
+ * @brief Class PrimeGenerator constructor. Finds initial primes and cuts intervals into chunks, nothing is sieved yet
+ * @param pIntVc Vector of intervals
+ * @param Settings Parameters of the sieve (threads are not used, chunks are sieved by the consumer's thread)
+ */
+PrimeGenerator::PrimeGenerator(std::vector <Interval> *pIntVc, const SieveSettings &Settings):
+    m_FindPrimes(pIntVc, pipelined(Settings)), m_nNextChunk(0), m_nChunkPos(0), m_nBatchPos(0) {}
+
+/**
+ * @brief Class PrimeGenerator destructor
+ */
+PrimeGenerator::~PrimeGenerator() {}
+
+/**
+ * @brief Settings of the sieve with the pipelined mode on: only this mode cuts intervals into independent chunks
+ * @param Settings Parameters of the sieve
+ * @return Parameters of the sieve in the pipelined mode
+ */
+SieveSettings PrimeGenerator::pipelined(const SieveSettings &Settings)
+{
+    SieveSettings Res(Settings);
+
+    Res.m_fPipelined = true;
+    return Res;
+}
+
+/**
+ * @brief Takes the next batch of primes of the current chunk, sieves the next chunk if the current one is exhausted.
+ *        Chunks may have no primes, so chunks are sieved until a prime is found or there are no chunks
+ * @param None
+ * @return true if the batch has primes
+ */
+bool PrimeGenerator::fillBatch()
+{
+    m_nBatchVc.clear();
+    m_nBatchPos = 0;
+    while(m_nBatchVc.empty())
+    {
+        if(!m_pChunkPrimes || m_nChunkPos >= m_pChunkPrimes->size())
+        {
+            if(m_nNextChunk >= m_FindPrimes.getChunksNum())
+            {
+                m_pChunkPrimes.reset();
+                return false;
+            }
+
+            m_pChunkPrimes.reset(new PrimeNumbersVector(m_FindPrimes.sieveChunk(m_nNextChunk++, m_Buffers)));
+            m_nChunkPos = 0;
+        }
+
+        m_pChunkPrimes->getPrimes(m_nChunkPos, m_nBatchPositions, m_nBatchVc);
+        m_nChunkPos += m_nBatchPositions;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Gives the next prime in ascending order
+ * @param nPrime Variable to write the prime in
+ * @return false if there are no more primes (nPrime is not changed)
+ */
+bool PrimeGenerator::next(uint64_t &nPrime)
+{
+    if(m_nBatchPos >= m_nBatchVc.size() && !fillBatch())
+    {
+        return false;
+    }
+
+    nPrime = m_nBatchVc[m_nBatchPos++];
+    return true;
+}
+
+/**
+ * @brief Iterator on the first prime which is not taken yet. Primes are taken from the generator itself,
+ *        so the second range-based for continues after the first one
+ * @param None
+ * @return Iterator
+ */
+PrimeGenerator::Iterator PrimeGenerator::begin()
+{
+    return Iterator(this);
+}
+
+/**
+ * @brief Iterator after the last prime
+ * @param None
+ * @return Iterator
+ */
+PrimeGenerator::Iterator PrimeGenerator::end()
+{
+    return Iterator(nullptr);
+}
+
+/**
+ * @brief Returns number of chunks sieved until now
+ * @param None
+ * @return Number of chunks
+ */
+size_t PrimeGenerator::getChunksSieved() const
+{
+    return m_nNextChunk;
+}
+
+/**
+ * @brief Returns number of chunks of all intervals
+ * @param None
+ * @return Number of chunks
+ */
+size_t PrimeGenerator::getChunksNum() const
+{
+    return m_FindPrimes.getChunksNum();
+}
+
+/**
+ * @brief Class PrimeGenerator::Iterator constructor. Takes the prime from the generator at once
+ * @param pGenerator Generator (nullptr for the end)
+ */
+PrimeGenerator::Iterator::Iterator(PrimeGenerator *pGenerator): m_pGenerator(pGenerator), m_nPrime(0)
+{
+    ++(*this);
+}
+
+/**
+ * @brief Current prime
+ * @param None
+ * @return Prime
+ */
+uint64_t PrimeGenerator::Iterator::operator*() const
+{
+    return m_nPrime;
+}
+
+/**
+ * @brief Takes the next prime from the generator, the iterator becomes equal to end() if there are no more primes
+ * @param None
+ * @return The iterator
+ */
+PrimeGenerator::Iterator &PrimeGenerator::Iterator::operator++()
+{
+    if(m_pGenerator && !m_pGenerator->next(m_nPrime))
+    {
+        m_pGenerator = nullptr;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Iterators are equal if both are ends or both take primes from the same generator
+ * @param It Other iterator
+ * @return true if iterators are equal
+ */
+bool PrimeGenerator::Iterator::operator==(const Iterator &It) const
+{
+    return m_pGenerator == It.m_pGenerator;
+}
+
+/**
+ * @brief Iterators are not equal if one of them is the end and the other one is not
+ * @param It Other iterator
+ * @return true if iterators are not equal
+ */
+bool PrimeGenerator::Iterator::operator!=(const Iterator &It) const
+{
+    return !(*this == It);
+}
+
+//*****************************************************************************************
@@ -0,0 +1,79 @@
+/**
+  *************************************************************************************************************************
+  * @file    primegenerator.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Pull-based generator of primes in given intervals. Intervals are cut into chunks as in the pipelined mode,
+  *          the next chunk is sieved only when the consumer takes all primes of the current one, so the consumer which
+  *          stops early does not pay for the rest of intervals. Initial primes up to square root of the highest number
+  *          are found in the constructor, so the high side of intervals should not be much greater than needed
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMEGENERATOR_H
+#define PRIMEGENERATOR_H
+
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+#include <stdint.h>
+
+#include "findprimes.h"
+
+class PrimeGenerator
+{
+public:
+    class Iterator                                          // Input iterator for the range-based for
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef uint64_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const uint64_t *pointer;
+        typedef uint64_t reference;                         // Primes are returned by value
+
+        Iterator(PrimeGenerator *pGenerator);
+
+        uint64_t operator*() const;
+        Iterator &operator++();
+        bool operator==(const Iterator &It) const;
+        bool operator!=(const Iterator &It) const;
+
+    private:
+        PrimeGenerator *m_pGenerator;                       // nullptr after the last prime
+        uint64_t m_nPrime;                                  // Current prime
+    };
+
+    PrimeGenerator(std::vector <Interval> *pIntVc, const SieveSettings &Settings = SieveSettings());
+    ~PrimeGenerator();
+
+    PrimeGenerator(const PrimeGenerator &) = delete;
+    PrimeGenerator &operator=(const PrimeGenerator &) = delete;
+
+    bool next(uint64_t &nPrime);                            // false if there are no more primes
+    Iterator begin();                                       // Takes the first prime which is not taken yet
+    Iterator end();
+
+    size_t getChunksSieved() const;                         // Chunks sieved until now
+    size_t getChunksNum() const;
+
+private:
+    static constexpr uint32_t m_nBatchPositions = 1 << 14;  // Positions of PrimeNumbersVector of the chunk taken at once
+
+    FindPrimes m_FindPrimes;                                // Sieve in the pipelined mode (chunks only, it has no threads)
+    FindPrimes::ChunkBuffers m_Buffers;                     // Memory of the current chunk
+    std::unique_ptr <PrimeNumbersVector> m_pChunkPrimes;    // Primes of the current chunk
+    size_t m_nNextChunk;                                    // Chunk to sieve when the current one is exhausted
+    size_t m_nChunkPos;                                     // Next position of the current chunk to take
+    std::vector <uint64_t> m_nBatchVc;                      // Primes taken from the current chunk
+    size_t m_nBatchPos;                                     // Next prime of m_nBatchVc to give
+
+    static SieveSettings pipelined(const SieveSettings &Settings);
+    bool fillBatch();
+};
+
+#endif // PRIMEGENERATOR_H
+
+//*****************************************************************************************
@@ -1,120 +1,382 @@
-/**
-  ******************************************************************************************************************************
-  * @file    primenumbersvector.cpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    25-December-2018
-  * @brief   Сlass-adapter for bool vector to simplify getting prime numbers from it
-  ******************************************************************************************************************************
-*/
-
-#include <algorithm>
-#include <numeric>
-
-#include "primenumbersvector.h"
-#include "interval.hpp"
-
-/**
- * @brief Class PrimeNumbersVector constructor
- * @param p_fVector     Pointer to vector with result in it
- * @param pIntVector    Pointer to vector of intervals in which prime numbers has been searched
- * @param pPrimesVector Pointer to vector of initial prime numbers
- * @param pSpokesVector Pointer to vector of spokes of Wheel Factorisation container
- * @param nPrimor       Primorial of Wheel Factorisation
- * @param nBegPrimesNum Number of spokes of Wheel Factorisation
- */
-PrimeNumbersVector::PrimeNumbersVector(std::vector <bool> *p_fVector, std::vector <Interval> *pIntVector,
-                                       std::vector <uint32_t> *pPrimesVector, std::vector <uint32_t> *pSpokesVector,
-                                       uint32_t &nPrimor, uint32_t &nBegPrimesNum):
-    m_pfVector(p_fVector),
-    m_pIntVector(pIntVector),
-    m_pPrimesVector(pPrimesVector),
-    m_pSpokesVector(pSpokesVector),
-    m_nPrimor(nPrimor),
-    m_nNumOfSpokes(m_pSpokesVector->size()),
-    m_nBegPrimesNum(nBegPrimesNum),
-    m_nMax(m_pIntVector->back().m_nHighIntervalSide)
-{
-    countEffectiveSize();
-}
-
-/**
- * @brief Class PrimeNumbersVector destructor
- */
-PrimeNumbersVector::~PrimeNumbersVector() {}
-
-/**
- * @brief Counts effective size of the bool vector
- * @param None
- * @return None
- */
-void PrimeNumbersVector::countEffectiveSize()
-{
-    // Counting the part of common size which contains the Wheel Factorization Series
-    float fitSizeCoeff = 1 - std::accumulate(m_pPrimesVector->begin(), m_pPrimesVector->begin() + m_nBegPrimesNum, 0.0,
-    [] (float fitResult, uint32_t nPrime)
-    {
-        return fitResult = fitResult + 1.0/nPrime - fitResult/nPrime;
-    });
-
-    m_nSize = m_nMax * fitSizeCoeff + 1;
-}
-
-/**
- * @brief Retuns the effective size of the bool vector
- * @param None
- * @return m_nSize The effective size of the bool vector
- */
-size_t PrimeNumbersVector::size() const
-{
-    return m_nSize;
-}
-
-/**
- * @brief Returns the value of the element at specified location pos, with bounds checking
- * @param nPos Position of the element to return
- * @return nCurNum The value of the element
- * @exceptions OutOfRange if !(nPos < m_nSize()).
- */
-uint32_t PrimeNumbersVector::at(size_t nPos) const
-{
-    uint32_t nCurNum(0);
-
-    if(nPos < m_nSize)
-    {
-        if(nPos < m_pPrimesVector->size())                                     // If nPos belongs to initial primes
-        {
-            nCurNum = (*m_pPrimesVector)[nPos];                                //   get the value from vector of initial primes
-        }
-        else
-        {
-            uint32_t nCurSpoke = nPos % m_nNumOfSpokes;                        // Else count nVal's spoke number,
-            uint32_t nCurIndex = nPos / m_nNumOfSpokes;                        //  the value of index,
-            nCurNum = nCurIndex * m_nPrimor + (*m_pSpokesVector)[nCurSpoke];   //  and result: the value, which corresponds to nPos
-
-            if(true == (*m_pfVector)[nCurNum])                                 // If nCurNum is not prime number
-            {
-                nCurNum = 0;
-            }
-        }
-
-        //Check whether nCurNum belongs to any interval
-        bool fBelongIntervals = std::any_of(m_pIntVector->begin(), m_pIntVector->end(), [ nCurNum ] (Interval Int)
-        {
-             return ((nCurNum >= Int.m_nLowIntervalSide) && (nCurNum <= Int.m_nHighIntervalSide));
-        });
-
-        if(!fBelongIntervals)
-        {
-            nCurNum = 0;
-        }
-    }
-    else
-    {
-        throw OutOfRange();
-    }
-
-    return nCurNum;
-}
-
-//*******************************************************************************************************
+/**
+  ******************************************************************************************************************************
+  * @file    primenumbersvector.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    25-December-2018
+  * @brief   Сlass-adapter for bool vector to simplify getting prime numbers from it
+  ******************************************************************************************************************************
+*/
+
+#include <algorithm>
+
+#include "primenumbersvector.h"
+#include "interval.hpp"
+#include "simdkernels.h"
+
+/**
+ * @brief Class PrimeNumbersVector constructor
+ * @param pSieveVector  Pointer to bits of spokes with result in it
+ * @param pBlocksVector Pointer to vector of blocks of intervals in which prime numbers has been searched
+ * @param pDirectVector Pointer to vector of primes found by the direct test
+ * @param pPrimesVector Pointer to vector of initial primes of the wheel (0 if the prime is out of the progression)
+ * @param pSpokesVector Pointer to vector of spokes of Wheel Factorisation container
+ * @param nPrimor       Primorial of Wheel Factorisation
+ * @param nBegPrimesNum Number of spokes of Wheel Factorisation
+ */
+PrimeNumbersVector::PrimeNumbersVector(const VectorSieveWords *pSieveVector, const std::vector <SieveBlock> *pBlocksVector,
+                                       const std::vector <uint64_t> *pDirectVector, const std::vector <uint32_t> *pPrimesVector,
+                                       const std::vector <uint32_t> *pSpokesVector, uint32_t nPrimor, uint32_t nBegPrimesNum):
+    m_pSieveVector(pSieveVector),
+    m_pBlocksVector(pBlocksVector),
+    m_pDirectVector(pDirectVector),
+    m_pPrimesVector(pPrimesVector),
+    m_pSpokesVector(pSpokesVector),
+    m_nPrimor(nPrimor),
+    m_nNumOfSpokes(m_pSpokesVector->size()),
+    m_nBegPrimesNum(nBegPrimesNum)
+{
+    countEffectiveSize();
+}
+
+/**
+ * @brief Class PrimeNumbersVector destructor
+ */
+PrimeNumbersVector::~PrimeNumbersVector() {}
+
+/**
+ * @brief Counts effective size: initial primes of Wheel Factorisation followed by positions of all blocks in order of
+ *        intervals. The sieved block has positions for all spokes of indices low / m_nPrimor...high / m_nPrimor,
+ *        the block of the direct test has positions of its primes. The size depends on widths of intervals only
+ * @param None
+ * @return None
+ */
+void PrimeNumbersVector::countEffectiveSize()
+{
+    m_nSize = m_nBegPrimesNum;
+    m_nBlockPosVc.resize(m_pBlocksVector->size());
+
+    for(size_t i = 0, p = m_pBlocksVector->size(); i < p; ++i)
+    {
+        const SieveBlock &Block = (*m_pBlocksVector)[i];
+
+        m_nBlockPosVc[i] = m_nSize;
+        if(Block.m_fSieved)
+        {
+            m_nSize += (Block.m_Int.m_nHighIntervalSide / m_nPrimor - Block.m_Int.m_nLowIntervalSide / m_nPrimor + 1) * m_nNumOfSpokes;
+        }
+        else
+        {
+            m_nSize += Block.m_nDirectEnd - Block.m_nDirectBegin;
+        }
+    }
+}
+
+/**
+ * @brief Retuns the effective size of the bool vector
+ * @param None
+ * @return m_nSize The effective size of the bool vector
+ */
+size_t PrimeNumbersVector::size() const
+{
+    return m_nSize;
+}
+
+/**
+ * @brief Check whether the number belongs to any interval (intervals are sorted, so the binary search is used)
+ * @param nNum Number to check
+ * @return true if the number belongs to an interval
+ */
+bool PrimeNumbersVector::belongsIntervals(uint64_t nNum) const
+{
+    std::vector <SieveBlock>::const_iterator Iter = std::upper_bound(m_pBlocksVector->begin(), m_pBlocksVector->end(), nNum,
+    [] (uint64_t nVal, const SieveBlock &Block)
+    {
+        return nVal < Block.m_Int.m_nLowIntervalSide;
+    });
+
+    return (Iter != m_pBlocksVector->begin() && nNum <= (Iter - 1)->m_Int.m_nHighIntervalSide);
+}
+
+/**
+ * @brief Returns the value of the element at specified location pos, with bounds checking
+ * @param nPos Position of the element to return
+ * @return nCurNum The value of the element (0 if it is not prime or doesn't belong to intervals)
+ * @exceptions OutOfRange if !(nPos < m_nSize()).
+ */
+uint64_t PrimeNumbersVector::at(size_t nPos) const
+{
+    uint64_t nCurNum(0);
+
+    if(nPos >= m_nSize)
+    {
+        throw OutOfRange();
+    }
+
+    if(nPos < m_nBegPrimesNum)                                                 // If nPos belongs to initial primes of the wheel
+    {
+        nCurNum = (*m_pPrimesVector)[nPos];                                    //   get the value from vector of initial primes
+        return (belongsIntervals(nCurNum) ? nCurNum : 0);
+    }
+
+    size_t nBlock = std::upper_bound(m_nBlockPosVc.begin(), m_nBlockPosVc.end(), nPos) - m_nBlockPosVc.begin() - 1;
+    const SieveBlock &Block = (*m_pBlocksVector)[nBlock];
+
+    nPos -= m_nBlockPosVc[nBlock];
+    if(!Block.m_fSieved)                                                       // If nPos belongs to primes of the direct test
+    {
+        return (*m_pDirectVector)[Block.m_nDirectBegin + nPos];
+    }
+
+    uint32_t nCurSpoke = nPos % m_nNumOfSpokes;                                // Else count nVal's spoke number,
+    uint64_t nCurIndex = Block.m_Int.m_nLowIntervalSide / m_nPrimor + nPos / m_nNumOfSpokes;   //  the value of index,
+    nCurNum = nCurIndex * m_nPrimor + (*m_pSpokesVector)[nCurSpoke];           //  and result: the value, which corresponds to nPos
+
+    const uint64_t *pWords = (*m_pSieveVector)[nCurSpoke].data() + Block.m_nWordOffset;
+    if(nCurNum < Block.m_Int.m_nLowIntervalSide || nCurNum > Block.m_Int.m_nHighIntervalSide ||
+       testSieveBit(pWords, nCurIndex - Block.m_nOrigin))                     // If nCurNum is not prime number or out of interval
+    {
+        nCurNum = 0;
+    }
+
+    return nCurNum;
+}
+
+/**
+ * @brief Mask of bits of the row which have indices nFirst...nLast
+ * @param nFirst First index
+ * @param nLast Last index
+ * @param nBase Index of the first bit of the row
+ * @return Mask
+ */
+uint64_t PrimeNumbersVector::rowMask(uint64_t nFirst, uint64_t nLast, uint64_t nBase)
+{
+    if(nLast < nBase || nFirst > nBase + 63)
+    {
+        return 0;
+    }
+
+    uint64_t nMask = ~static_cast <uint64_t> (0);
+    if(nFirst > nBase)
+    {
+        nMask <<= nFirst - nBase;
+    }
+    if(nLast < nBase + 63)
+    {
+        nMask &= ~static_cast <uint64_t> (0) >> (63 - (nLast - nBase));
+    }
+
+    return nMask;
+}
+
+/**
+ * @brief Indices of the spoke which belong to the interval of the block (bits out of the interval have not been sieved)
+ * @param Block Sieved block
+ * @param nSpoke Index of the spoke
+ * @param nFirst Variable to write the first index in
+ * @param nLast Variable to write the last index in
+ * @return false if the spoke has no numbers in the interval
+ */
+bool PrimeNumbersVector::getSpokeRange(const SieveBlock &Block, uint32_t nSpoke, uint64_t &nFirst, uint64_t &nLast) const
+{
+    uint64_t nSpokeVal = (*m_pSpokesVector)[nSpoke];
+    uint64_t nLow = Block.m_Int.m_nLowIntervalSide, nHigh = Block.m_Int.m_nHighIntervalSide;
+
+    nFirst = nLow / m_nPrimor + (nSpokeVal < nLow % m_nPrimor ? 1 : 0);
+    nLast = nHigh / m_nPrimor;
+    if(nSpokeVal > nHigh % m_nPrimor)
+    {
+        if(!nLast)
+        {
+            return false;
+        }
+        --nLast;
+    }
+
+    return (nFirst <= nLast);
+}
+
+/**
+ * @brief Counts set bits nLow...nHigh of the spoke: whole words by the vector kernel, boundary words by masks
+ * @param pWords Bits of the spoke
+ * @param nLow First bit
+ * @param nHigh Last bit
+ * @return Number of composites
+ */
+uint64_t PrimeNumbersVector::countComposites(const uint64_t *pWords, uint64_t nLow, uint64_t nHigh) const
+{
+    uint64_t nFirst = nLow >> 6, nLast = nHigh >> 6;
+    uint64_t nLowMask = ~static_cast <uint64_t> (0) << (nLow & 63);
+    uint64_t nHighMask = ~static_cast <uint64_t> (0) >> (63 - (nHigh & 63));
+
+    if(nFirst == nLast)
+    {
+        return __builtin_popcountll(pWords[nFirst] & nLowMask & nHighMask);
+    }
+
+    return __builtin_popcountll(pWords[nFirst] & nLowMask) + __builtin_popcountll(pWords[nLast] & nHighMask) +
+           SimdKernels::get().m_pPopcount(pWords + nFirst + 1, nLast - nFirst - 1);
+}
+
+/**
+ * @brief Counts prime numbers in all intervals without getting them one by one
+ * @param None
+ * @return nCount Number of primes
+ */
+uint64_t PrimeNumbersVector::count() const
+{
+    uint64_t nCount(m_pDirectVector->size());
+
+    for(uint32_t i = 0; i < m_nBegPrimesNum; ++i)
+    {
+        nCount += (at(i) ? 1 : 0);
+    }
+
+    for(size_t j = 0, p = m_pBlocksVector->size(); j < p; ++j)
+    {
+        const SieveBlock &Block = (*m_pBlocksVector)[j];
+
+        if(!Block.m_fSieved)
+        {
+            continue;
+        }
+
+        for(uint32_t i = 0; i < m_nNumOfSpokes; ++i)
+        {
+            uint64_t nLowIdx, nHighIdx;
+
+            if(getSpokeRange(Block, i, nLowIdx, nHighIdx))
+            {
+                nCount += nHighIdx - nLowIdx + 1 - countComposites((*m_pSieveVector)[i].data() + Block.m_nWordOffset,
+                                                                   nLowIdx - Block.m_nOrigin, nHighIdx - Block.m_nOrigin);
+            }
+        }
+    }
+
+    return nCount;
+}
+
+/**
+ * @brief Collects prime numbers at positions nPos...nPos + nCount - 1 in ascending order. Positions are the same as for
+ *        at(), but only blocks which contain the positions are visited
+ * @param nPos First position
+ * @param nCount Number of positions
+ * @param PrimesVc Container to write primes in (it is cleared before)
+ * @return None
+ */
+void PrimeNumbersVector::getPrimes(size_t nPos, size_t nCount, std::vector <uint64_t> &PrimesVc) const
+{
+    size_t nEnd = std::min(nPos + nCount, m_nSize);
+
+    PrimesVc.clear();
+    for(; nPos < nEnd && nPos < m_nBegPrimesNum; ++nPos)                       // Initial primes of the wheel
+    {
+        if(at(nPos))
+        {
+            PrimesVc.push_back(at(nPos));
+        }
+    }
+
+    if(nPos >= nEnd)
+    {
+        return;
+    }
+
+    size_t nBlock = std::upper_bound(m_nBlockPosVc.begin(), m_nBlockPosVc.end(), nPos) - m_nBlockPosVc.begin() - 1;
+
+    for(size_t p = m_pBlocksVector->size(); nPos < nEnd && nBlock < p; ++nBlock)
+    {
+        const SieveBlock &Block = (*m_pBlocksVector)[nBlock];
+        size_t nBlockEnd = std::min(nEnd, nBlock + 1 < p ? m_nBlockPosVc[nBlock + 1] : m_nSize);
+
+        if(Block.m_fSieved)
+        {
+            getSievedPrimes(nBlock, nPos, nBlockEnd, PrimesVc);
+        }
+        else
+        {
+            PrimesVc.insert(PrimesVc.end(), m_pDirectVector->begin() + Block.m_nDirectBegin + (nPos - m_nBlockPosVc[nBlock]),
+                            m_pDirectVector->begin() + Block.m_nDirectBegin + (nBlockEnd - m_nBlockPosVc[nBlock]));
+        }
+        nPos = nBlockEnd;
+    }
+}
+
+/**
+ * @brief Appends prime numbers of the sieved block at positions nPos...nEnd - 1 in ascending order. Zero bits of every
+ *        spoke are extracted by the vector kernel instead of checking them one by one, and primes are ordered by the
+ *        counting sort of their indices: spokes are taken in ascending order, so primes of the same index are in order
+ * @param nBlock Index of the block
+ * @param nPos First position
+ * @param nEnd Position after the last one (not bigger than the end of the block)
+ * @param PrimesVc Container to write primes in
+ * @return None
+ */
+void PrimeNumbersVector::getSievedPrimes(size_t nBlock, size_t nPos, size_t nEnd, std::vector <uint64_t> &PrimesVc) const
+{
+    const SieveBlock &Block = (*m_pBlocksVector)[nBlock];
+    uint64_t nLow = Block.m_Int.m_nLowIntervalSide, nHigh = Block.m_Int.m_nHighIntervalSide;
+    uint64_t nBaseIdx = nLow / m_nPrimor;                                       // Index of the first position of the block
+
+    nPos -= m_nBlockPosVc[nBlock];                                              //
+    nEnd -= m_nBlockPosVc[nBlock];                                              // Positions inside the block
+
+    uint64_t nFirstIdx = nBaseIdx + nPos / m_nNumOfSpokes, nLastIdx = nBaseIdx + (nEnd - 1) / m_nNumOfSpokes;
+    uint64_t nFirstWord = (nFirstIdx - Block.m_nOrigin) >> 6, nWords = ((nLastIdx - Block.m_nOrigin) >> 6) - nFirstWord + 1;
+    uint64_t nWordIdx = Block.m_nOrigin + 64 * nFirstWord;                      // Index of the first bit of the words
+    std::vector <uint32_t> nBitsVc(64 * nWords), nStartVc(64 * nWords + 1, 0), nSpokesVc;
+
+    for(uint32_t i = 0; i < m_nNumOfSpokes; ++i)                               // Number of primes of every index
+    {
+        const uint64_t *pWords = (*m_pSieveVector)[i].data() + Block.m_nWordOffset + nFirstWord;
+        size_t nBits = SimdKernels::get().m_pExtractZeros(pWords, nWords, nBitsVc.data());
+
+        for(size_t j = 0; j < nBits; ++j)
+        {
+            ++nStartVc[nBitsVc[j] + 1];
+        }
+    }
+
+    for(size_t j = 1, p = nStartVc.size(); j < p; ++j)
+    {
+        nStartVc[j] += nStartVc[j - 1];
+    }
+
+    nSpokesVc.resize(nStartVc.back());
+    for(uint32_t i = 0; i < m_nNumOfSpokes; ++i)                               // Spokes of primes in order of indices
+    {
+        const uint64_t *pWords = (*m_pSieveVector)[i].data() + Block.m_nWordOffset + nFirstWord;
+        size_t nBits = SimdKernels::get().m_pExtractZeros(pWords, nWords, nBitsVc.data());
+
+        for(size_t j = 0; j < nBits; ++j)
+        {
+            nSpokesVc[nStartVc[nBitsVc[j]]++] = i;
+        }
+    }
+
+    for(uint64_t nBit = 0, nSlot = 0, p = 64 * nWords; nBit < p; ++nBit)     // nStartVc[nBit] is the end of the index now
+    {
+        uint64_t nCurIndex = nWordIdx + nBit;
+
+        for(; nSlot < nStartVc[nBit]; ++nSlot)
+        {
+            uint32_t i = nSpokesVc[nSlot];
+
+            if(nCurIndex < nBaseIdx)
+            {
+                continue;
+            }
+
+            size_t nCurPos = (nCurIndex - nBaseIdx) * m_nNumOfSpokes + i;
+            uint64_t nCurNum = nCurIndex * m_nPrimor + (*m_pSpokesVector)[i];
+
+            // Bits out of the interval has not been sieved
+            if(nCurPos >= nPos && nCurPos < nEnd && nCurNum >= nLow && nCurNum <= nHigh)
+            {
+                PrimesVc.push_back(nCurNum);
+            }
+        }
+    }
+}
+
+//*******************************************************************************************************
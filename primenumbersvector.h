@@ -1,47 +1,60 @@
-/**
-  ******************************************************************************************************************************
-  * @file    primenumbersvector.h
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    25-December-2018
-  * @brief   Сlass-adapter for bool vector to simplify getting prime numbers from it
-  ******************************************************************************************************************************
-*/
-
-#ifndef VECTORPRIMES_H
-#define VECTORPRIMES_H
-
-#include <vector>
-#include <iostream>
-
-
-class Interval;
-class OutOfRange {};                            // Class for throwing exception when given index to PrimeNumbersVector is out of range
-
-class PrimeNumbersVector
-{
-public:
-    PrimeNumbersVector(std::vector <bool> *p_fVector, std::vector <Interval> *pIntVector, std::vector <uint32_t> *pPrimesVector,
-                       std::vector <uint32_t> *pSpokesVector, uint32_t &nPrimor, uint32_t &nBegPrimesNum);
-    ~PrimeNumbersVector();
-
-    size_t size() const;
-    uint32_t at(size_t nPos) const;
-
-private:
-    std::vector <bool> *m_pfVector;             // Pointer to vector with result in it
-    std::vector <Interval> *m_pIntVector;       // Intervals in which prime numbers has been searched
-    std::vector <uint32_t> *m_pPrimesVector;    // Initial prime numbers
-    std::vector <uint32_t> *m_pSpokesVector;    // Spokes of Wheel Factorisation container
-    uint32_t m_nPrimor;                         // Primorial of Wheel Factorisation
-    uint32_t m_nNumOfSpokes;                    // Number of spokes of Wheel Factorisation
-    uint32_t m_nBegPrimesNum;                   // Number of initial primes of Wheel Factorisation
-    uint32_t m_nMax;                            // Max number of all intervals
-    size_t m_nSize;                             // Effective size of the bool vector
-
-    void countEffectiveSize();
-};
-
-#endif // VECTORPRIMES_H
-
-//*****************************************************************************************
+/**
+  ******************************************************************************************************************************
+  * @file    primenumbersvector.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    25-December-2018
+  * @brief   Сlass-adapter for bool vector to simplify getting prime numbers from it
+  ******************************************************************************************************************************
+*/
+
+#ifndef VECTORPRIMES_H
+#define VECTORPRIMES_H
+
+#include <vector>
+#include <iostream>
+
+#include "sievewords.hpp"
+
+class OutOfRange {};                            // Class for throwing exception when given index to PrimeNumbersVector is out of range
+
+class PrimeNumbersVector
+{
+public:
+    PrimeNumbersVector(const VectorSieveWords *pSieveVector, const std::vector <SieveBlock> *pBlocksVector,
+                       const std::vector <uint64_t> *pDirectVector, const std::vector <uint32_t> *pPrimesVector,
+                       const std::vector <uint32_t> *pSpokesVector, uint32_t nPrimor, uint32_t nBegPrimesNum);
+    ~PrimeNumbersVector();
+
+    size_t size() const;
+    uint64_t at(size_t nPos) const;
+    uint64_t count() const;                                                          // Number of primes in all intervals
+    void getPrimes(size_t nPos, size_t nCount, std::vector <uint64_t> &PrimesVc) const;  // Primes at positions nPos...nPos + nCount - 1
+
+private:
+    friend class PrimesIndex;                        // Index and finder of tuples read bits and blocks directly
+    friend class TupleFinder;
+    friend class SharedPrimesExport;
+
+    const VectorSieveWords *m_pSieveVector;          // Pointer to bits of spokes with result in it
+    const std::vector <SieveBlock> *m_pBlocksVector; // Blocks of intervals in which prime numbers has been searched
+    const std::vector <uint64_t> *m_pDirectVector;   // Primes found by the direct test
+    const std::vector <uint32_t> *m_pPrimesVector;   // Initial primes of the wheel (0 if out of the progression)
+    const std::vector <uint32_t> *m_pSpokesVector;   // Spokes of Wheel Factorisation container
+    uint32_t m_nPrimor;                              // Primorial of Wheel Factorisation
+    uint32_t m_nNumOfSpokes;                         // Number of spokes of Wheel Factorisation
+    uint32_t m_nBegPrimesNum;                        // Number of initial primes of Wheel Factorisation
+    std::vector <size_t> m_nBlockPosVc;              // First position of every block
+    size_t m_nSize;                                  // Number of positions of all blocks and initial primes of the wheel
+
+    void countEffectiveSize();
+    bool belongsIntervals(uint64_t nNum) const;
+    bool getSpokeRange(const SieveBlock &Block, uint32_t nSpoke, uint64_t &nFirst, uint64_t &nLast) const;
+    static uint64_t rowMask(uint64_t nFirst, uint64_t nLast, uint64_t nBase);       // Bits nFirst...nLast of the word of nBase...nBase + 63
+    uint64_t countComposites(const uint64_t *pWords, uint64_t nLow, uint64_t nHigh) const;
+    void getSievedPrimes(size_t nBlock, size_t nPos, size_t nEnd, std::vector <uint64_t> &PrimesVc) const;
+};
+
+#endif // VECTORPRIMES_H
+
+//*****************************************************************************************
@@ -1,88 +1,241 @@
-/**
-  *************************************************************************************************************************
-  * @file    primenumfunc.cpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    23-November-2018
-  * @brief   Class-functor to be given into particular thread (for multy-threads prime numbers searching)
-  **************************************************************************************************************************
-*/
-
-#include <cmath>
-
-#include "primenumfunc.h"
-#include "findprimes.h"
-
-/**
- * @brief Class PrimeNumFunc constructor
- * @param pfVc Bool vector pointer to save result in it
- * @param pPrimesVec Initial primes for searching another primes
- * @param nSpokesVec Spokes of Wheel Factorisation container (only for current thread!)
- * @param pIntVec Intervals vector pointer
- * @param nPrimor Primorial of Wheel Factorisation
- * @param nBegPrimesNum Number of initial primes of Wheel Factorisation
- */
-PrimeNumFunc::PrimeNumFunc(std::vector <bool> *pfVc, std::vector<uint32_t> *pPrimesVec, std::vector<uint32_t> &&nSpokesVec,
-                               std::vector<Interval> *pIntVec, uint32_t nPrimor, uint32_t nBegPrimesNum):
-    m_pfVc(pfVc),
-    m_pPrimesVec(pPrimesVec),
-    m_nSpokesVec(std::move(nSpokesVec)),
-    m_pIntVec(pIntVec),
-    m_nPrimor(nPrimor),
-    m_nNumOfSpokes(m_nSpokesVec.size()),                         // Number of spokes of Wheel Factorisation
-    m_nBegPrimesNum(nBegPrimesNum) {}
-
-/**
- * @brief Class PrimeNumFunc destructor
- */
-PrimeNumFunc::~PrimeNumFunc() {}
-
-/**
- * @brief Function for finding prime numbers by the Eratosthenes Sieve method with the wheel factorisation
- * @param None
- * @return None
- */
-void PrimeNumFunc::operator () ()
-{
-    uint32_t nBegin, nVal, nPreDiv, nHigh, nLow;
-
-    nBegin = sqrtf((m_pIntVec->back()).m_nHighIntervalSide);            // Numbers less than sqrtf(High) are already finded
-
-    for(uint32_t m = 0, q = m_pIntVec->size(); m < q; ++m)              // For each interval
-    {
-        nHigh = (*m_pIntVec)[m].m_nHighIntervalSide;                    //
-        nLow = (*m_pIntVec)[m].m_nLowIntervalSide;                      // Get limits
-
-        if(nHigh < nBegin)
-        {
-            continue;                                                   // If interval is in initial primes, go to another inteval
-        }
-        if(nLow > nBegin)                                               // Choose position to start searcing from
-        {
-            nBegin = nLow;
-        }
-
-        for(uint32_t i = m_nBegPrimesNum, p = m_pPrimesVec->size(); i < p; ++i)  // For each initial prime
-        {
-            nVal = (*m_pPrimesVec)[i];
-            nPreDiv = 1 + nBegin / nVal;                                // Count value to start
-
-            for(uint32_t k = 0; k < m_nNumOfSpokes; ++k)                // For all spokes in current thread
-            {
-                for(uint32_t j = nVal * nPreDiv; j < nHigh; j += nVal)  // Count last value < nBegin, and increment it with the step nVal
-                {
-                    if(!((j - m_nSpokesVec[k]) % m_nPrimor))            // If the value belongs to m_nPrimor * x + m_nSpokesVc[i] series
-                    {
-                        for(uint32_t r = nVal * m_nPrimor; j < nHigh; j += r)  // change step to optimal
-                        {
-                            (*m_pfVc)[j] = true;
-                        }
-                        break;
-                    }
-                }
-            }
-        }
-    }
-}
-
-//***********************************************************************************************************************
+/**
+  *************************************************************************************************************************
+  * @file    primenumfunc.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    23-November-2018
+  * @brief   Class-functor to be given into particular thread (for multy-threads prime numbers searching)
+  **************************************************************************************************************************
+*/
+
+#include <chrono>
+#include <algorithm>
+
+#include "primenumfunc.h"
+#include "findprimes.h"
+#include "profiler.h"
+
+/**
+ * @brief Class PrimeNumFunc constructor
+ * @param pSieveVc Bits of spokes to save result in it
+ * @param pPrimesVec Initial primes for searching another primes
+ * @param pInvPrimorVec Inverse of primorial modulo every initial prime
+ * @param pSpokesVec Spokes of Wheel Factorisation container
+ * @param nSpokesIdxVec Indices of spokes of Wheel Factorisation (only for current thread!)
+ * @param pBlocksVec Blocks of intervals
+ * @param pPreSieve Patterns of the smallest initial primes
+ * @param nPrimor Primorial of Wheel Factorisation
+ * @param nBegPrimesNum Number of initial primes of Wheel Factorisation
+ * @param nSegmentSize Number of bits of the spoke sieved at once
+ * @param nWorker Serial number of the thread
+ */
+PrimeNumFunc::PrimeNumFunc(VectorSieveWords *pSieveVc, const std::vector<uint32_t> *pPrimesVec,
+                           const std::vector<uint32_t> *pInvPrimorVec, const std::vector<uint32_t> *pSpokesVec,
+                           std::vector<uint32_t> &&nSpokesIdxVec, const std::vector<SieveBlock> *pBlocksVec, const PreSieve *pPreSieve, uint32_t nPrimor, uint32_t nBegPrimesNum,
+                           uint32_t nSegmentSize, uint32_t nWorker):
+    m_pSieveVc(pSieveVc),
+    m_pPrimesVec(pPrimesVec),
+    m_pInvPrimorVec(pInvPrimorVec),
+    m_pSpokesVec(pSpokesVec),
+    m_nSpokesIdxVec(std::move(nSpokesIdxVec)),
+    m_pBlocksVec(pBlocksVec),
+    m_pPreSieve(pPreSieve),
+    m_nPrimor(nPrimor),
+    m_nNumOfSpokes(m_nSpokesIdxVec.size()),                      // Number of spokes of Wheel Factorisation
+    m_nBegPrimesNum(nBegPrimesNum),
+    m_nFirstPrime(nBegPrimesNum + pPreSieve->getPrimesNum()),
+    m_nSegmentSize(nSegmentSize),
+    m_nWorker(nWorker),
+    m_nBusyTime(0),
+    m_nBucketsMemory(0) {}
+
+/**
+ * @brief Class PrimeNumFunc destructor
+ */
+PrimeNumFunc::~PrimeNumFunc() {}
+
+/**
+ * @brief Function for finding prime numbers by the segmented Eratosthenes Sieve method with the wheel factorisation.
+ *        Every spoke is sieved separately, bit k of the spoke s corresponds to the number k * m_nPrimor + s,
+ *        bits of every interval are kept in its own block
+ * @param None
+ * @return None
+ */
+void PrimeNumFunc::operator () ()
+{
+    Profiler::ScopedTimer Timer("sieve", m_nWorker);
+    std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+    BucketSieve Buckets(m_nSegmentSize);                                // Buckets are reused for all spokes of the thread
+    uint64_t nHigh, nLow, nLowIdx, nHighIdx, nCandidates(0);
+
+    for(uint32_t i = 0; i < m_nNumOfSpokes; ++i)                        // For all spokes in current thread
+    {
+        uint32_t nSpoke = (*m_pSpokesVec)[m_nSpokesIdxVec[i]];
+        SieveWords &Words = (*m_pSieveVc)[m_nSpokesIdxVec[i]];
+
+        for(uint32_t m = 0, q = m_pBlocksVec->size(); m < q; ++m)       // For each sieved interval
+        {
+            const SieveBlock &Block = (*m_pBlocksVec)[m];
+            if(!Block.m_fSieved)
+            {
+                continue;
+            }
+
+            nHigh = Block.m_Int.m_nHighIntervalSide;                    //
+            nLow = Block.m_Int.m_nLowIntervalSide;                      // Get limits
+
+            if(nHigh < nSpoke)
+            {
+                continue;                                               // Interval is below the first number of the spoke
+            }
+
+            uint64_t *pWords = Words.data() + Block.m_nWordOffset;
+            if(1 == nSpoke && !Block.m_nOrigin)
+            {
+                setSieveBit(pWords, 0);                                 // 1 is not prime number
+            }
+
+            nLowIdx = (nLow <= nSpoke ? 0 : (nLow - nSpoke + m_nPrimor - 1) / m_nPrimor);
+            nHighIdx = (nHigh - nSpoke) / m_nPrimor;
+
+            if(nLowIdx <= nHighIdx)
+            {
+                sieveRange(Buckets, m_nSpokesIdxVec[i], pWords, Block.m_nOrigin, nLowIdx, nHighIdx);
+                nCandidates += nHighIdx - nLowIdx + 1;
+            }
+        }
+    }
+
+    Profiler::get().addCounter("candidates_sieved", nCandidates, m_nWorker);
+    Profiler::get().addCounter("candidates_sieved", nCandidates);
+
+    m_nBucketsMemory = Buckets.getMemoryUsage();
+    m_nBusyTime = std::chrono::duration_cast <std::chrono::nanoseconds> (std::chrono::steady_clock::now() - Start).count();
+}
+
+/**
+ * @brief Returns time of the last run of the functor (the functor must be given to the thread by reference)
+ * @param None
+ * @return Nanoseconds
+ */
+uint64_t PrimeNumFunc::getBusyTime() const
+{
+    return m_nBusyTime;
+}
+
+/**
+ * @brief Returns memory of the buckets allocated in the last run of the functor
+ * @param None
+ * @return Bytes
+ */
+size_t PrimeNumFunc::getBucketsMemory() const
+{
+    return m_nBucketsMemory;
+}
+
+/**
+ * @brief Find the bit of the spoke which corresponds to the first number not less than square of the initial prime
+ * @param nPrimeIdx Index of the initial prime
+ * @param nSpoke Spoke of Wheel Factorisation
+ * @return Bit of the spoke
+ */
+uint64_t PrimeNumFunc::squareBit(uint32_t nPrimeIdx, uint32_t nSpoke) const
+{
+    uint64_t nSquare = static_cast <uint64_t> ((*m_pPrimesVec)[nPrimeIdx]) * (*m_pPrimesVec)[nPrimeIdx];
+
+    return (nSquare <= nSpoke ? 0 : (nSquare - nSpoke + m_nPrimor - 1) / m_nPrimor);
+}
+
+/**
+ * @brief Find the first bit of the spoke not less than nLow which corresponds to the multiple of the initial prime.
+ *        Multiples less than square of the prime are skipped, they are crossed off by smaller primes
+ * @param nPrimeIdx Index of the initial prime
+ * @param nSpoke Spoke of Wheel Factorisation
+ * @param nLow Bit of the spoke to start searching from
+ * @return Bit of the spoke
+ */
+uint64_t PrimeNumFunc::firstHit(uint32_t nPrimeIdx, uint32_t nSpoke, uint64_t nLow) const
+{
+    uint64_t nVal = (*m_pPrimesVec)[nPrimeIdx];
+    uint64_t nRes = (nVal - (nSpoke % nVal) * (*m_pInvPrimorVec)[nPrimeIdx] % nVal) % nVal;   // k * m_nPrimor + nSpoke == 0 (mod nVal)
+    uint64_t nStart = squareBit(nPrimeIdx, nSpoke);
+
+    if(nStart < nLow)
+    {
+        nStart = nLow;
+    }
+
+    return nStart + (nRes + nVal - nStart % nVal) % nVal;
+}
+
+/**
+ * @brief Sieve bits nLow...nHigh of the spoke segment by segment. Every segment starts from the copy of the pre-sieved
+ *        pattern, then primes which are less than the segment size are crossed off in every segment, larger primes
+ *        are filed into buckets of the segments they hit
+ * @param Buckets Bucket sieve for the large initial primes
+ * @param nSpokeIdx Index of the spoke of Wheel Factorisation
+ * @param pWords Bits of the block of the spoke
+ * @param nOrigin Index k of the first bit of the block
+ * @param nLow First bit of the range
+ * @param nHigh Last bit of the range
+ * @return None
+ */
+void PrimeNumFunc::sieveRange(BucketSieve &Buckets, uint32_t nSpokeIdx, uint64_t *pWords, uint64_t nOrigin, uint64_t nLow,
+                              uint64_t nHigh)
+{
+    uint32_t nSpoke = (*m_pSpokesVec)[nSpokeIdx];
+    uint64_t nMaxNum = nHigh * m_nPrimor + nSpoke;
+
+    // Only primes with the square not bigger than the max number of the range are needed
+    uint32_t nEnd = std::upper_bound(m_pPrimesVec->begin() + m_nFirstPrime, m_pPrimesVec->end(), nMaxNum,
+    [] (uint64_t nMax, uint32_t nPrime)
+    {
+        return static_cast <uint64_t> (nPrime) * nPrime > nMax;
+    }) - m_pPrimesVec->begin();
+
+    uint32_t nSmallEnd = std::lower_bound(m_pPrimesVec->begin() + m_nFirstPrime, m_pPrimesVec->begin() + nEnd,
+                                       m_nSegmentSize) - m_pPrimesVec->begin();
+
+    uint32_t nLarge = nSmallEnd;                                            // Next large prime to file into buckets
+
+    m_nNextHitVc.resize(nSmallEnd - m_nFirstPrime);
+    for(uint32_t i = m_nFirstPrime; i < nSmallEnd; ++i)
+    {
+        m_nNextHitVc[i - m_nFirstPrime] = firstHit(i, nSpoke, nLow);
+    }
+
+    Buckets.reset(nEnd > nSmallEnd ? (*m_pPrimesVec)[nEnd - 1] : 0);
+
+    for(uint64_t nSegment = 0, nSegLow = nLow; nSegLow <= nHigh; ++nSegment, nSegLow += m_nSegmentSize)
+    {
+        uint64_t nSegHigh = std::min(nHigh, nSegLow + m_nSegmentSize - 1);
+
+        m_pPreSieve->apply(nSpokeIdx, pWords, nOrigin, nSegLow, nSegHigh);
+
+        for(uint32_t i = m_nFirstPrime; i < nSmallEnd; ++i)                 // Small primes hit the segment many times
+        {
+            uint64_t nVal = (*m_pPrimesVec)[i];
+            uint64_t j = m_nNextHitVc[i - m_nFirstPrime] - nOrigin;       // Bits of the block
+
+            for(; j <= nSegHigh - nOrigin; j += nVal)
+            {
+                setSieveBit(pWords, j);
+            }
+            m_nNextHitVc[i - m_nFirstPrime] = j + nOrigin;
+        }
+
+        // Large primes are filed into buckets when the segment reaches their squares
+        for(; nLarge < nEnd && squareBit(nLarge, nSpoke) <= nSegHigh; ++nLarge)
+        {
+            uint64_t nHit = firstHit(nLarge, nSpoke, nSegLow);
+            if(nHit <= nHigh)
+            {
+                Buckets.addPrime((*m_pPrimesVec)[nLarge], nHit - nLow);
+            }
+        }
+
+        Buckets.sieveSegment(nSegment, pWords, nSegLow - nOrigin, nSegHigh - nSegLow + 1);
+    }
+}
+
+//***********************************************************************************************************************
@@ -1,42 +1,66 @@
-/**
-  *************************************************************************************************************************
-  * @file    primenumfunc.h
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    23-November-2018
-  * @brief   Class-functor to be given into particular thread (for multy-threads prime numbers searching)
-  **************************************************************************************************************************
-*/
-
-
-#ifndef PRIMENUMFUNC_H
-#define PRIMENUMFUNC_H
-
-#include <iostream>
-#include <vector>
-
-#include "interval.hpp"
-
-class PrimeNumFunc
-{
-public:
-    PrimeNumFunc(std::vector <bool> *pfVc, std::vector <uint32_t> *pPrimesVec, std::vector <uint32_t> &&nSpokesVec, std::vector <Interval> *pIntVec, uint32_t nPrimor, uint32_t nBegPrimesNum);
-
-    ~PrimeNumFunc();
-
-    void operator () ();
-
-private:
-    std::vector <bool> *m_pfVc;                 // Bool vector pointer to save result in it
-    std::vector <uint32_t> *m_pPrimesVec;       // Initial primes for searching another primes
-    std::vector <uint32_t> m_nSpokesVec;        // Spokes of Wheel Factorisation container (only for current thread!)
-    std::vector <Interval> *m_pIntVec;          // Intervals vector pointer
-
-    uint32_t m_nPrimor;                         // Primorial of Wheel Factorisation
-    uint32_t m_nNumOfSpokes;                    // Number of spokes of Wheel Factorisation
-    uint32_t m_nBegPrimesNum;                   // Number of initial primes of Wheel Factorisation
-};
-
-#endif // PRIMENUMFUNC_H
-
-//******************************************************************************************************************
+/**
+  *************************************************************************************************************************
+  * @file    primenumfunc.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    23-November-2018
+  * @brief   Class-functor to be given into particular thread (for multy-threads prime numbers searching)
+  **************************************************************************************************************************
+*/
+
+
+#ifndef PRIMENUMFUNC_H
+#define PRIMENUMFUNC_H
+
+#include <iostream>
+#include <vector>
+
+#include "interval.hpp"
+#include "sievewords.hpp"
+#include "bucketsieve.h"
+#include "presieve.h"
+
+class PrimeNumFunc
+{
+public:
+    PrimeNumFunc(VectorSieveWords *pSieveVc, const std::vector <uint32_t> *pPrimesVec, const std::vector <uint32_t> *pInvPrimorVec,
+                 const std::vector <uint32_t> *pSpokesVec, std::vector <uint32_t> &&nSpokesIdxVec,
+                 const std::vector <SieveBlock> *pBlocksVec,
+                 const PreSieve *pPreSieve, uint32_t nPrimor, uint32_t nBegPrimesNum, uint32_t nSegmentSize, uint32_t nWorker);
+
+    ~PrimeNumFunc();
+
+    void operator () ();
+
+    uint64_t getBusyTime() const;                   // Nanoseconds of the sieve of the thread
+    size_t getBucketsMemory() const;                // Bytes of the buckets allocated by the thread
+
+private:
+    VectorSieveWords *m_pSieveVc;                   // Bits of spokes to save result in it
+    const std::vector <uint32_t> *m_pPrimesVec;     // Initial primes for searching another primes
+    const std::vector <uint32_t> *m_pInvPrimorVec;  // Inverse of primorial modulo every initial prime
+    const std::vector <uint32_t> *m_pSpokesVec;     // Spokes of Wheel Factorisation container
+    std::vector <uint32_t> m_nSpokesIdxVec;         // Indices of spokes of Wheel Factorisation (only for current thread!)
+    const std::vector <SieveBlock> *m_pBlocksVec;   // Blocks of intervals (only sieved ones are processed)
+    const PreSieve *m_pPreSieve;                    // Patterns of the smallest initial primes
+
+    uint32_t m_nPrimor;                             // Primorial of Wheel Factorisation
+    uint32_t m_nNumOfSpokes;                        // Number of spokes of Wheel Factorisation
+    uint32_t m_nBegPrimesNum;                       // Number of initial primes of Wheel Factorisation
+    uint32_t m_nFirstPrime;                         // Index of the first initial prime which is not crossed off by the patterns
+    uint32_t m_nSegmentSize;                        // Number of bits of the spoke sieved at once
+    uint32_t m_nWorker;                             // Serial number of the thread (for the profiler)
+    uint64_t m_nBusyTime;                           // Nanoseconds of the last run
+    size_t m_nBucketsMemory;                        // Bytes of the buckets of the last run
+
+    std::vector <uint64_t> m_nNextHitVc;            // Next hits of small initial primes in the current range
+
+    void sieveRange(BucketSieve &Buckets, uint32_t nSpokeIdx, uint64_t *pWords, uint64_t nOrigin, uint64_t nLow,
+                    uint64_t nHigh);
+    uint64_t squareBit(uint32_t nPrimeIdx, uint32_t nSpoke) const;
+    uint64_t firstHit(uint32_t nPrimeIdx, uint32_t nSpoke, uint64_t nLow) const;
+};
+
+#endif // PRIMENUMFUNC_H
+
+//******************************************************************************************************************
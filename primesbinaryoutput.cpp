@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************************************************************
+  * @file    primesbinaryoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which writes prime numbers to the binary file: magic
+  *          "PRMPRIME", uint32_t version, uint32_t reserved (0), then primes in ascending order as uint64_t in the byte
+  *          order of the machine. Files of the next intervals are joined by plain concatenation of their primes
+  ******************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <cstring>
+
+#include "primesbinaryoutput.h"
+#include "checkpoint.h"
+#include "arena.h"
+#include "profiler.h"
+
+/**
+ * @brief Class PrimesBinaryOutput constructor
+ * @param pFileName Name of the file to write in
+ */
+PrimesBinaryOutput::PrimesBinaryOutput(const char *pFileName): PrimesOutput(), m_pFileName(pFileName),
+    m_pBuffer(static_cast <char*> (Arena::get().allocate(m_nBufferSize))), m_nEmitted(0)
+{
+    m_Out.rdbuf()->pubsetbuf(m_pBuffer, m_nBufferSize);    // Before the file is opened
+}
+
+/**
+ * @brief Class PrimesBinaryOutput destructor
+ */
+PrimesBinaryOutput::~PrimesBinaryOutput()
+{
+    if(m_Out.is_open())
+    {
+        m_Out.close();
+    }
+
+    Arena::get().release(m_pBuffer);
+}
+
+/**
+ * @brief Implementation of the abstract function to output prime numbers (write to the binary file) from PrimeNumbersVector
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void PrimesBinaryOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("output");
+    std::vector <uint64_t> PrimesVc;
+
+    begin();
+    for(size_t i = 0, p = pPrimeNumVc->size(); i < p; i += m_nChunkSize)
+    {
+        pPrimeNumVc->getPrimes(i, m_nChunkSize, PrimesVc);
+        write(PrimesVc);
+    }
+    end();
+}
+
+/**
+ * @brief Open the file and write the header
+ * @param None
+ * @return None
+ */
+void PrimesBinaryOutput::begin()
+{
+    uint32_t nHeader[2] = { m_nVersion, 0 };
+
+    m_Out.open(m_pFileName, std::ios::out | std::ios::binary);
+
+    if(!m_Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    m_Out.write("PRMPRIME", 8);
+    m_Out.write(reinterpret_cast <const char*> (nHeader), sizeof(nHeader));
+    m_nEmitted = 0;
+}
+
+/**
+ * @brief Write next primes of the stream
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void PrimesBinaryOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    m_nEmitted += PrimesVc.size();
+    m_Out.write(reinterpret_cast <const char*> (PrimesVc.data()), PrimesVc.size() * sizeof(uint64_t));
+}
+
+/**
+ * @brief Close the file
+ * @param None
+ * @return None
+ */
+void PrimesBinaryOutput::end()
+{
+    m_Out.close();
+
+    Profiler::get().setCounter("primes_emitted", m_nEmitted);
+}
+
+/**
+ * @brief Open the file written before and continue the stream from the checkpoint. Data after it are cut off
+ * @param nOffset Size of the file at the checkpoint
+ * @param nEmitted Number of primes written before the checkpoint
+ * @return false if the file is shorter than the checkpoint (the stream must be started again)
+ */
+bool PrimesBinaryOutput::resume(uint64_t nOffset, uint64_t nEmitted)
+{
+    std::ifstream In(m_pFileName, std::ios::in | std::ios::binary | std::ios::ate);
+
+    if(!In || static_cast <uint64_t> (In.tellg()) < nOffset)
+    {
+        return false;
+    }
+    In.close();
+
+    Checkpoint::truncateFile(m_pFileName, nOffset);
+    m_Out.open(m_pFileName, std::ios::in | std::ios::out | std::ios::binary);
+    m_Out.seekp(nOffset);
+    m_nEmitted = nEmitted;
+
+    return m_Out.good();
+}
+
+/**
+ * @brief Write the stream to the disk for the checkpoint
+ * @param nOffset Size of the file to write in
+ * @return true if the stream is good
+ */
+bool PrimesBinaryOutput::sync(uint64_t &nOffset)
+{
+    m_Out.flush();
+    nOffset = m_Out.tellp();
+    Checkpoint::syncFile(m_pFileName);
+
+    return m_Out.good();
+}
+
+/**
+ * @brief Number of primes written in the last stream
+ * @param None
+ * @return Number of primes
+ */
+uint64_t PrimesBinaryOutput::getEmitted() const
+{
+    return m_nEmitted;
+}
+
+/**
+ * @brief Reads and checks the header of the binary file of primes
+ * @param In Stream at the beginning of the file
+ * @return true if the header is right, the stream is at the first prime then
+ */
+bool PrimesBinaryOutput::readHeader(std::istream &In)
+{
+    char cHeader[m_nHeaderSize];
+    uint32_t nVersion;
+
+    if(!In.read(cHeader, m_nHeaderSize) || memcmp(cHeader, "PRMPRIME", 8))
+    {
+        return false;
+    }
+
+    memcpy(&nVersion, cHeader + 8, sizeof(nVersion));
+    return (nVersion == m_nVersion);
+}
+
+//*****************************************************************************************************************************
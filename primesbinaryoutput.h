@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************************************************************
+  * @file    primesbinaryoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which writes prime numbers to the binary file: magic
+  *          "PRMPRIME", uint32_t version, uint32_t reserved (0), then primes in ascending order as uint64_t in the byte
+  *          order of the machine. Files of the next intervals are joined by plain concatenation of their primes
+  ******************************************************************************************************************************
+*/
+
+#ifndef PRIMESBINARYOUTPUT_H
+#define PRIMESBINARYOUTPUT_H
+
+#include <fstream>
+
+#include "primesoutput.hpp"
+
+class PrimesBinaryOutput: public PrimesOutput
+{
+public:
+    static constexpr uint32_t m_nVersion = 1;               // Version of the file
+    static constexpr uint32_t m_nHeaderSize = 16;           // Bytes before the primes
+
+    PrimesBinaryOutput(const char *pFileName);
+    virtual ~PrimesBinaryOutput() override;
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+    bool resume(uint64_t nOffset, uint64_t nEmitted) override;
+    bool sync(uint64_t &nOffset) override;
+
+    uint64_t getEmitted() const;                           // Number of primes written in the last stream
+
+    static bool readHeader(std::istream &In);              // Check the header of the file
+
+private:
+    static constexpr size_t m_nBufferSize = 1 << 20;        // Buffer of the file taken from Arena
+
+    const char *m_pFileName;
+    char *m_pBuffer;
+    std::ofstream m_Out;                                    // File of the stream
+    uint64_t m_nEmitted;                                    // Number of primes written in the stream
+};
+
+#endif // PRIMESBINARYOUTPUT_H
+
+//*****************************************************************************************
@@ -1,44 +1,82 @@
-/**
-  ******************************************************************************************************************************
-  * @file    primesconsoleoutput.cpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    25-December-2018
-  * @brief   Derived class from the abstract class PrimesOutput which implements printing to console prime numbers
-  *          from FindPrimes object
-  ******************************************************************************************************************************
-*/
-
-#include "primesconsoleoutput.h"
-
-#include <iostream>
-
-/**
- * @brief Class PrimesConsoleOutput constructor
- * @param None
- */
-PrimesConsoleOutput::PrimesConsoleOutput(): PrimesOutput() {}
-
-/**
- * @brief Class IntervalsOutput destructor
- */
-PrimesConsoleOutput::~PrimesConsoleOutput() {}
-
-/**
- * @brief Implementation of the abstract function to output prime numbers (print to console) from PrimeNumbersVector
- * @param pPrimeNumVc Container to prime numbers from
- * @return None
- */
-void PrimesConsoleOutput::output(PrimeNumbersVector *pPrimeNumVc)
-{
-    for(uint32_t i = 0, p = pPrimeNumVc->size(), nNum = 0; i < p; ++i)
-    {
-        nNum = pPrimeNumVc->at(i);
-        if(nNum)
-        {
-            std::cout << nNum << ' ';
-        }
-    }
-}
-
-//*****************************************************************************************************************************
+/**
+  ******************************************************************************************************************************
+  * @file    primesconsoleoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    25-December-2018
+  * @brief   Derived class from the abstract class PrimesOutput which implements printing to console prime numbers
+  *          from FindPrimes object
+  ******************************************************************************************************************************
+*/
+
+#include "primesconsoleoutput.h"
+
+#include <iostream>
+
+#include "profiler.h"
+
+/**
+ * @brief Class PrimesConsoleOutput constructor
+ * @param None
+ */
+PrimesConsoleOutput::PrimesConsoleOutput(): PrimesOutput(), m_nEmitted(0) {}
+
+/**
+ * @brief Class IntervalsOutput destructor
+ */
+PrimesConsoleOutput::~PrimesConsoleOutput() {}
+
+/**
+ * @brief Implementation of the abstract function to output prime numbers (print to console) from PrimeNumbersVector
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void PrimesConsoleOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("output");
+    std::vector <uint64_t> PrimesVc;
+
+    begin();
+    for(size_t i = 0, p = pPrimeNumVc->size(); i < p; i += m_nChunkSize)
+    {
+        pPrimeNumVc->getPrimes(i, m_nChunkSize, PrimesVc);
+        write(PrimesVc);
+    }
+    end();
+}
+
+/**
+ * @brief Start of the stream of primes
+ * @param None
+ * @return None
+ */
+void PrimesConsoleOutput::begin()
+{
+    m_nEmitted = 0;
+}
+
+/**
+ * @brief Print next primes of the stream
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void PrimesConsoleOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    m_nEmitted += PrimesVc.size();
+    for(size_t j = 0, q = PrimesVc.size(); j < q; ++j)
+    {
+        std::cout << PrimesVc[j] << ' ';
+    }
+}
+
+/**
+ * @brief End of the stream of primes
+ * @param None
+ * @return None
+ */
+void PrimesConsoleOutput::end()
+{
+    Profiler::get().setCounter("primes_emitted", m_nEmitted);
+}
+
+//*****************************************************************************************************************************
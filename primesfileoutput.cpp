@@ -1,58 +1,147 @@
-/**
-  ******************************************************************************************************************************
-  * @file    primesfileoutput.cpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    25-December-2018
-  * @brief   Derived class from the abstract class PrimesOutput which implements printing to file prime numbers
-  *          from FindPrimes object
-  ******************************************************************************************************************************
-*/
-
-#include "primesfileoutput.h"
-
-#include <iostream>
-#include <fstream>
-
-/**
- * @brief Class PrimesFileOutput constructor
- * @param pFileName Name of the file to write in
- */
-PrimesFileOutput::PrimesFileOutput(const char* pFileName): PrimesOutput(), m_pFileName(pFileName) {}
-
-/**
- * @brief Class IntervalsOutput destructor
- */
-PrimesFileOutput::~PrimesFileOutput() {}
-
-/**
- * @brief Implementation of the abstract function to output prime numbers (print to file) from PrimeNumbersVector
- * @param pPrimeNumVc Container to prime numbers from
- * @return None
- */
-void PrimesFileOutput::output(PrimeNumbersVector *pPrimeNumVc)
-{
-    std::ofstream out(m_pFileName);
-
-    if(!out)
-    {
-        std::cerr << "File opening error!\n";
-        exit(1);
-    }
-
-    out << "<root>\n<primes> ";
-
-    for(uint32_t i = 0, p = pPrimeNumVc->size(), nNum = 0; i < p; ++i)
-    {
-        nNum = pPrimeNumVc->at(i);
-        if(nNum)
-        {
-            out << nNum << ' ';
-        }
-    }
-
-    out << "</primes>\n</root>";
-    out.close();
-}
-
-//*****************************************************************************************************************************
+/**
+  ******************************************************************************************************************************
+  * @file    primesfileoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    25-December-2018
+  * @brief   Derived class from the abstract class PrimesOutput which implements printing to file prime numbers
+  *          from FindPrimes object
+  ******************************************************************************************************************************
+*/
+
+#include "primesfileoutput.h"
+
+#include <iostream>
+#include <fstream>
+
+#include "checkpoint.h"
+#include "arena.h"
+#include "profiler.h"
+
+/**
+ * @brief Class PrimesFileOutput constructor
+ * @param pFileName Name of the file to write in
+ */
+PrimesFileOutput::PrimesFileOutput(const char *pFileName): PrimesOutput(), m_pFileName(pFileName),
+    m_pBuffer(static_cast <char*> (Arena::get().allocate(m_nBufferSize))), m_nEmitted(0)
+{
+    m_Out.rdbuf()->pubsetbuf(m_pBuffer, m_nBufferSize);    // Before the file is opened
+}
+
+/**
+ * @brief Class IntervalsOutput destructor
+ */
+PrimesFileOutput::~PrimesFileOutput()
+{
+    if(m_Out.is_open())
+    {
+        m_Out.close();
+    }
+
+    Arena::get().release(m_pBuffer);
+}
+
+/**
+ * @brief Implementation of the abstract function to output prime numbers (print to file) from PrimeNumbersVector
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void PrimesFileOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("output");
+    std::vector <uint64_t> PrimesVc;
+
+    begin();
+    for(size_t i = 0, p = pPrimeNumVc->size(); i < p; i += m_nChunkSize)
+    {
+        pPrimeNumVc->getPrimes(i, m_nChunkSize, PrimesVc);
+        write(PrimesVc);
+    }
+    end();
+}
+
+/**
+ * @brief Open the file and write the beginning of the list of primes
+ * @param None
+ * @return None
+ */
+void PrimesFileOutput::begin()
+{
+    m_Out.open(m_pFileName);
+
+    if(!m_Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    m_Out << "<root>\n<primes> ";
+    m_nEmitted = 0;
+}
+
+/**
+ * @brief Write next primes of the stream
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void PrimesFileOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    m_nEmitted += PrimesVc.size();
+    for(size_t j = 0, q = PrimesVc.size(); j < q; ++j)
+    {
+        m_Out << PrimesVc[j] << ' ';
+    }
+}
+
+/**
+ * @brief Write the end of the list of primes and close the file
+ * @param None
+ * @return None
+ */
+void PrimesFileOutput::end()
+{
+    m_Out << "</primes>\n</root>";
+    m_Out.close();
+
+    Profiler::get().setCounter("primes_emitted", m_nEmitted);
+}
+
+/**
+ * @brief Open the file written before and continue the stream from the checkpoint. Data after it are cut off
+ * @param nOffset Size of the file at the checkpoint
+ * @param nEmitted Number of primes written before the checkpoint
+ * @return false if the file is shorter than the checkpoint (the stream must be started again)
+ */
+bool PrimesFileOutput::resume(uint64_t nOffset, uint64_t nEmitted)
+{
+    std::ifstream In(m_pFileName, std::ios::in | std::ios::binary | std::ios::ate);
+
+    if(!In || static_cast <uint64_t> (In.tellg()) < nOffset)
+    {
+        return false;
+    }
+    In.close();
+
+    Checkpoint::truncateFile(m_pFileName, nOffset);
+    m_Out.open(m_pFileName, std::ios::in | std::ios::out);
+    m_Out.seekp(nOffset);
+    m_nEmitted = nEmitted;
+
+    return m_Out.good();
+}
+
+/**
+ * @brief Write the stream to the disk for the checkpoint
+ * @param nOffset Size of the file to write in
+ * @return true if the stream is good
+ */
+bool PrimesFileOutput::sync(uint64_t &nOffset)
+{
+    m_Out.flush();
+    nOffset = m_Out.tellp();
+    Checkpoint::syncFile(m_pFileName);
+
+    return m_Out.good();
+}
+
+//*****************************************************************************************************************************
@@ -1,29 +1,43 @@
-/**
-  ******************************************************************************************************************************
-  * @file    primesfileoutput.h
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    25-December-2018
-  * @brief   Derived class from the abstract class PrimesOutput which implements printing to file prime numbers
-  *          from FindPrimes object
-  ******************************************************************************************************************************
-*/
-
-#ifndef PRIMESFILEOUTPUT_H
-#define PRIMESFILEOUTPUT_H
-
-#include "primesoutput.hpp"
-
-class PrimesFileOutput: public PrimesOutput
-{
-public:
-    PrimesFileOutput(const char *pFileName);
-    virtual ~PrimesFileOutput() override;
-
-    void output(PrimeNumbersVector *pPrimeNumVc) override;
-
-private:
-    const char *m_pFileName;
-};
-
-#endif // PRIMESFILEOUTPUT_H
+/**
+  ******************************************************************************************************************************
+  * @file    primesfileoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    25-December-2018
+  * @brief   Derived class from the abstract class PrimesOutput which implements printing to file prime numbers
+  *          from FindPrimes object
+  ******************************************************************************************************************************
+*/
+
+#ifndef PRIMESFILEOUTPUT_H
+#define PRIMESFILEOUTPUT_H
+
+#include <fstream>
+
+#include "primesoutput.hpp"
+
+class PrimesFileOutput: public PrimesOutput
+{
+public:
+    PrimesFileOutput(const char *pFileName);
+    virtual ~PrimesFileOutput() override;
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+    bool resume(uint64_t nOffset, uint64_t nEmitted) override;
+    bool sync(uint64_t &nOffset) override;
+
+private:
+    static constexpr size_t m_nBufferSize = 1 << 20;        // Buffer of the file taken from Arena
+
+    const char *m_pFileName;
+    char *m_pBuffer;
+    std::ofstream m_Out;                                    // File of the stream
+    uint64_t m_nEmitted;                                    // Number of primes written in the stream
+};
+
+#endif // PRIMESFILEOUTPUT_H
@@ -0,0 +1,173 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesgzipoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to write prime numbers into the gzip file while they are found: the list of PrimesFileOutput or
+  *          the binary file of PrimesBinaryOutput compressed by GzipWriter on worker threads. Decompressed file is the
+  *          same as the file of the uncompressed output
+  **************************************************************************************************************************
+*/
+
+#include "primesgzipoutput.h"
+
+#include <iostream>
+#include <algorithm>
+
+#include "primesbinaryoutput.h"
+#include "profiler.h"
+
+/**
+ * @brief Class PrimesGzipOutput constructor
+ * @param pFileName Name of the file to write in
+ * @param fBinary Write primes in the binary format
+ * @param nThreads Number of compressing threads (0 - one per core)
+ * @param nLevel Level of compression 1...9
+ * @param nMemory Bytes of the writer (0 - no limit), see GzipWriter::getMemory()
+ */
+PrimesGzipOutput::PrimesGzipOutput(const char *pFileName, bool fBinary, uint32_t nThreads, int nLevel, uint64_t nMemory):
+    PrimesOutput(), m_Writer(pFileName, nThreads, nLevel, nMemory), m_fBinary(fBinary), m_nEmitted(0) {}
+
+/**
+ * @brief Class PrimesGzipOutput destructor
+ */
+PrimesGzipOutput::~PrimesGzipOutput() {}
+
+/**
+ * @brief Implementation of the abstract function to output prime numbers (print to file) from PrimeNumbersVector
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void PrimesGzipOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("output");
+    std::vector <uint64_t> PrimesVc;
+
+    begin();
+    for(size_t i = 0, p = pPrimeNumVc->size(); i < p; i += m_nChunkSize)
+    {
+        pPrimeNumVc->getPrimes(i, m_nChunkSize, PrimesVc);
+        write(PrimesVc);
+    }
+    end();
+}
+
+/**
+ * @brief Open the file and write the beginning of the list of primes or the header of the binary file
+ * @param None
+ * @return None
+ */
+void PrimesGzipOutput::begin()
+{
+    if(!m_Writer.open())
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    if(m_fBinary)
+    {
+        uint32_t nHeader[2] = { PrimesBinaryOutput::m_nVersion, 0 };
+
+        m_Writer.write("PRMPRIME", 8);
+        m_Writer.write(reinterpret_cast <const char*> (nHeader), sizeof(nHeader));
+    }
+    else
+    {
+        m_Writer.write("<root>\n<primes> ", 16);
+    }
+    m_nEmitted = 0;
+}
+
+/**
+ * @brief Write next primes of the stream. Numbers are converted to text here, it's faster than the stream's operator
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void PrimesGzipOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    m_nEmitted += PrimesVc.size();
+    if(m_fBinary)
+    {
+        m_Writer.write(reinterpret_cast <const char*> (PrimesVc.data()), PrimesVc.size() * sizeof(uint64_t));
+        return;
+    }
+
+    m_sText.resize(m_nTextPrimes * 21);                                     // 20 digits and the space
+    for(size_t i = 0, p = PrimesVc.size(); i < p; i += m_nTextPrimes)      // The batch may be large, the text is taken by parts
+    {
+        char *pText = &m_sText[0];
+
+        for(size_t j = i, q = std::min(p, i + m_nTextPrimes); j < q; ++j)
+        {
+            uint64_t nPrime = PrimesVc[j];
+            char cDigits[20];
+            uint32_t nDigits(0);
+
+            do
+            {
+                cDigits[nDigits++] = '0' + nPrime % 10;
+                nPrime /= 10;
+            }
+            while(nPrime);
+
+            while(nDigits)
+            {
+                *pText++ = cDigits[--nDigits];
+            }
+            *pText++ = ' ';
+        }
+
+        m_Writer.write(m_sText.data(), pText - m_sText.data());
+    }
+}
+
+/**
+ * @brief Write the end of the list of primes and close the file
+ * @param None
+ * @return None
+ */
+void PrimesGzipOutput::end()
+{
+    if(!m_fBinary)
+    {
+        m_Writer.write("</primes>\n</root>", 17);
+    }
+
+    if(!m_Writer.close())
+    {
+        std::cerr << "File writing error!\n";
+        exit(1);
+    }
+
+    Profiler::get().setCounter("primes_emitted", m_nEmitted);
+    Profiler::get().addCounter("gzip_raw_bytes", m_Writer.getRawBytes());
+    Profiler::get().addCounter("gzip_bytes", m_Writer.getPackedBytes());
+}
+
+/**
+ * @brief Open the file written before and continue the stream from the checkpoint. The checkpoint is always at the
+ *        end of the gzip member, data after it are cut off
+ * @param nOffset Size of the file at the checkpoint
+ * @param nEmitted Number of primes written before the checkpoint
+ * @return false if the file is shorter than the checkpoint (the stream must be started again)
+ */
+bool PrimesGzipOutput::resume(uint64_t nOffset, uint64_t nEmitted)
+{
+    m_nEmitted = nEmitted;
+
+    return m_Writer.open(nOffset);
+}
+
+/**
+ * @brief Compress all data given and write the file to the disk for the checkpoint
+ * @param nOffset Size of the file to write in
+ * @return true if the file is good
+ */
+bool PrimesGzipOutput::sync(uint64_t &nOffset)
+{
+    return m_Writer.flush(nOffset);
+}
+
+//*****************************************************************************************
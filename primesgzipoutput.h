@@ -0,0 +1,48 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesgzipoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to write prime numbers into the gzip file while they are found: the list of PrimesFileOutput or
+  *          the binary file of PrimesBinaryOutput compressed by GzipWriter on worker threads. Decompressed file is the
+  *          same as the file of the uncompressed output
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMESGZIPOUTPUT_H
+#define PRIMESGZIPOUTPUT_H
+
+#include <string>
+
+#include "primesoutput.hpp"
+#include "gzipwriter.h"
+
+class PrimesGzipOutput: public PrimesOutput
+{
+public:
+    PrimesGzipOutput(const char *pFileName, bool fBinary = false, uint32_t nThreads = 0,
+                     int nLevel = GzipWriter::m_nDefaultLevel, uint64_t nMemory = 0);
+    virtual ~PrimesGzipOutput() override;
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+    bool resume(uint64_t nOffset, uint64_t nEmitted) override;
+    bool sync(uint64_t &nOffset) override;
+
+private:
+    static constexpr size_t m_nTextPrimes = 1 << 12;        // Primes converted to text at once
+
+    GzipWriter m_Writer;
+    bool m_fBinary;                                         // Format of PrimesBinaryOutput instead of the list
+    std::string m_sText;                                    // Text of m_nTextPrimes primes being written
+    uint64_t m_nEmitted;                                    // Number of primes written in the stream
+};
+
+#endif // PRIMESGZIPOUTPUT_H
+
+//*****************************************************************************************
@@ -0,0 +1,257 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesindex.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Rank/select index over the result of the sieve. Every row of 64 indices of the sieved block (one word of
+  *          every spoke) has the number of primes before it, and the row of every m_nSelectSample-th prime is sampled,
+  *          so the n-th prime, the number of primes not greater than the number and the next prime are found by one
+  *          popcount of every spoke instead of the scan of positions. Memory is about 1 / spokes of the bits
+  **************************************************************************************************************************
+*/
+
+#include <algorithm>
+
+#include "primesindex.h"
+#include "primesrow.hpp"
+
+/**
+ * @brief Class PrimesIndex constructor. Counts primes of every row of every sieved block (spoke by spoke, so the words
+ *        are read in order) and samples rows of the select directory
+ * @param pPrimeNumVector Result of the sieve of the usual mode (it must live while the index is used)
+ */
+PrimesIndex::PrimesIndex(const PrimeNumbersVector *pPrimeNumVector): m_pPrimeNumVector(pPrimeNumVector)
+{
+    const std::vector <SieveBlock> &BlocksVc = *m_pPrimeNumVector->m_pBlocksVector;
+    uint32_t nPrimor = m_pPrimeNumVector->m_nPrimor;
+
+    for(uint32_t i = 0; i < m_pPrimeNumVector->m_nBegPrimesNum; ++i)
+    {
+        if(m_pPrimeNumVector->at(i))
+        {
+            m_nWheelPrimesVc.push_back(m_pPrimeNumVector->at(i));
+        }
+    }
+
+    uint64_t nRank = m_nWheelPrimesVc.size(), nAllRows(0);
+    for(const SieveBlock &Block : BlocksVc)
+    {
+        nAllRows += (Block.m_fSieved ? ((Block.m_Int.m_nHighIntervalSide / nPrimor - Block.m_nOrigin) >> 6) + 1 : 0);
+    }
+    m_nRowRankVc.reserve(nAllRows);
+    m_nBlockRankVc.reserve(BlocksVc.size() + 1);
+    m_nBlockRowVc.reserve(BlocksVc.size() + 1);
+
+    for(const SieveBlock &Block : BlocksVc)
+    {
+        m_nBlockRankVc.push_back(nRank);
+        m_nBlockRowVc.push_back(m_nRowRankVc.size());
+        if(!Block.m_fSieved)
+        {
+            nRank += Block.m_nDirectEnd - Block.m_nDirectBegin;
+            continue;
+        }
+
+        uint64_t nRows = ((Block.m_Int.m_nHighIntervalSide / nPrimor - Block.m_nOrigin) >> 6) + 1;
+        std::vector <uint64_t> nCountVc(nRows, 0);
+
+        for(uint32_t i = 0; i < m_pPrimeNumVector->m_nNumOfSpokes; ++i)
+        {
+            const uint64_t *pWords = (*m_pPrimeNumVector->m_pSieveVector)[i].data() + Block.m_nWordOffset;
+            uint64_t nFirst, nLast;
+
+            if(!m_pPrimeNumVector->getSpokeRange(Block, i, nFirst, nLast))
+            {
+                continue;
+            }
+
+            uint64_t nFirstRow = (nFirst - Block.m_nOrigin) >> 6, nLastRow = (nLast - Block.m_nOrigin) >> 6;
+            for(uint64_t j = nFirstRow; j <= nLastRow; ++j)
+            {
+                uint64_t nMask = (j == nFirstRow || j == nLastRow ? PrimeNumbersVector::rowMask(nFirst, nLast, Block.m_nOrigin + 64 * j) :
+                                                                    ~static_cast <uint64_t> (0));
+                nCountVc[j] += __builtin_popcountll(~pWords[j] & nMask);
+            }
+        }
+
+        for(uint64_t j = 0; j < nRows; ++j)
+        {
+            m_nRowRankVc.push_back(nRank);
+            nRank += nCountVc[j];
+        }
+    }
+    m_nBlockRankVc.push_back(nRank);
+    m_nBlockRowVc.push_back(m_nRowRankVc.size());
+
+    m_nSelectVc.reserve(nRank / m_nSelectSample + 2);
+    for(uint64_t n = 0; n <= nRank / m_nSelectSample + 1; ++n)
+    {
+        m_nSelectVc.push_back(std::upper_bound(m_nRowRankVc.begin(), m_nRowRankVc.end(), n * m_nSelectSample) -
+                              m_nRowRankVc.begin());
+    }
+}
+
+/**
+ * @brief Class PrimesIndex destructor
+ */
+PrimesIndex::~PrimesIndex() {}
+
+/**
+ * @brief Primes of the row of all spokes: zero bits of the words. Only the first and the last rows of the block
+ *        have bits out of the interval, so masks are found for them only
+ * @param Block Sieved block
+ * @param nRow Row of the block
+ * @param nBitsVc Container to write primes of every spoke in (set bit for every prime)
+ * @return None
+ */
+void PrimesIndex::getRowBits(const SieveBlock &Block, uint64_t nRow, std::vector <uint64_t> &nBitsVc) const
+{
+    const VectorSieveWords &SieveVc = *m_pPrimeNumVector->m_pSieveVector;
+    uint64_t nBase = Block.m_nOrigin + 64 * nRow;                              // Index of the first bit of the row
+    bool fInside = (nBase > Block.m_Int.m_nLowIntervalSide / m_pPrimeNumVector->m_nPrimor &&
+                    nBase + 63 < Block.m_Int.m_nHighIntervalSide / m_pPrimeNumVector->m_nPrimor);
+
+    nBitsVc.resize(m_pPrimeNumVector->m_nNumOfSpokes);
+    for(uint32_t i = 0; i < m_pPrimeNumVector->m_nNumOfSpokes; ++i)
+    {
+        uint64_t nFirst, nLast;
+
+        if(fInside)
+        {
+            nBitsVc[i] = ~SieveVc[i][Block.m_nWordOffset + nRow];
+        }
+        else
+        {
+            nBitsVc[i] = (m_pPrimeNumVector->getSpokeRange(Block, i, nFirst, nLast) ?
+                          ~SieveVc[i][Block.m_nWordOffset + nRow] & PrimeNumbersVector::rowMask(nFirst, nLast, nBase) : 0);
+        }
+    }
+}
+
+/**
+ * @brief Returns number of primes in all intervals
+ * @param None
+ * @return Number of primes
+ */
+uint64_t PrimesIndex::count() const
+{
+    return m_nBlockRankVc.back();
+}
+
+/**
+ * @brief Returns the prime number nNum in ascending order. The block is found by ranks of blocks, the row by ranks of
+ *        rows between two samples of the select directory, the index in the row by the binary search of popcounts
+ * @param nNum Number of the prime (from 0)
+ * @return The prime
+ * @exceptions OutOfRange if !(nNum < count()).
+ */
+uint64_t PrimesIndex::nthPrime(uint64_t nNum) const
+{
+    if(nNum >= count())
+    {
+        throw OutOfRange();
+    }
+
+    if(nNum < m_nWheelPrimesVc.size())
+    {
+        return m_nWheelPrimesVc[nNum];
+    }
+
+    size_t nBlock = std::upper_bound(m_nBlockRankVc.begin(), m_nBlockRankVc.end(), nNum) - m_nBlockRankVc.begin() - 1;
+    const SieveBlock &Block = (*m_pPrimeNumVector->m_pBlocksVector)[nBlock];
+
+    if(!Block.m_fSieved)
+    {
+        return (*m_pPrimeNumVector->m_pDirectVector)[Block.m_nDirectBegin + (nNum - m_nBlockRankVc[nBlock])];
+    }
+
+    size_t nLowRow = std::max(m_nBlockRowVc[nBlock], m_nSelectVc[nNum / m_nSelectSample]);
+    size_t nHighRow = std::min(m_nBlockRowVc[nBlock + 1], m_nSelectVc[nNum / m_nSelectSample + 1]);
+    size_t nRow = std::upper_bound(m_nRowRankVc.begin() + nLowRow, m_nRowRankVc.begin() + nHighRow, nNum) -
+                  m_nRowRankVc.begin() - 1;
+    uint64_t nRest = nNum - m_nRowRankVc[nRow];                                // Primes of the row before the prime
+    std::vector <uint64_t> nBitsVc;
+
+    getRowBits(Block, nRow - m_nBlockRowVc[nBlock], nBitsVc);
+
+    uint32_t nBit, nSpoke;
+    PrimesRow::select(nBitsVc, m_pPrimeNumVector->m_nNumOfSpokes, nRest, nBit, nSpoke);
+
+    uint64_t nIndex = Block.m_nOrigin + 64 * (nRow - m_nBlockRowVc[nBlock]) + nBit;
+    return nIndex * m_pPrimeNumVector->m_nPrimor + (*m_pPrimeNumVector->m_pSpokesVector)[nSpoke];
+}
+
+/**
+ * @brief Returns number of primes not greater than the number: ranks of the block and of the row, and popcounts
+ *        of the row up to the index of the number
+ * @param nVal Number
+ * @return Number of primes
+ */
+uint64_t PrimesIndex::rank(uint64_t nVal) const
+{
+    const std::vector <SieveBlock> &BlocksVc = *m_pPrimeNumVector->m_pBlocksVector;
+    uint64_t nRank = std::upper_bound(m_nWheelPrimesVc.begin(), m_nWheelPrimesVc.end(), nVal) - m_nWheelPrimesVc.begin();
+    uint64_t nWheelPrimes = m_nWheelPrimesVc.size();                         // Ranks of blocks count all of them
+
+    std::vector <SieveBlock>::const_iterator Iter = std::upper_bound(BlocksVc.begin(), BlocksVc.end(), nVal,
+    [] (uint64_t nNum, const SieveBlock &Block)
+    {
+        return nNum < Block.m_Int.m_nLowIntervalSide;
+    });
+
+    if(Iter == BlocksVc.begin())
+    {
+        return nRank;
+    }
+
+    size_t nBlock = Iter - BlocksVc.begin() - 1;
+    const SieveBlock &Block = BlocksVc[nBlock];
+
+    if(nVal > Block.m_Int.m_nHighIntervalSide)
+    {
+        return nRank + m_nBlockRankVc[nBlock + 1] - nWheelPrimes;
+    }
+
+    if(!Block.m_fSieved)
+    {
+        const std::vector <uint64_t> &DirectVc = *m_pPrimeNumVector->m_pDirectVector;
+        return nRank + m_nBlockRankVc[nBlock] - nWheelPrimes +
+               (std::upper_bound(DirectVc.begin() + Block.m_nDirectBegin, DirectVc.begin() + Block.m_nDirectEnd, nVal) -
+                (DirectVc.begin() + Block.m_nDirectBegin));
+    }
+
+    uint32_t nPrimor = m_pPrimeNumVector->m_nPrimor;
+    uint64_t nBit = nVal / nPrimor - Block.m_nOrigin;
+    std::vector <uint64_t> nBitsVc;
+
+    getRowBits(Block, nBit >> 6, nBitsVc);
+    return nRank + m_nRowRankVc[m_nBlockRowVc[nBlock] + (nBit >> 6)] - nWheelPrimes +
+           PrimesRow::rank(nBitsVc, m_pPrimeNumVector->m_pSpokesVector->data(), m_pPrimeNumVector->m_nNumOfSpokes,
+                           nBit & 63, nVal % nPrimor);
+}
+
+/**
+ * @brief Returns the least prime greater than the number
+ * @param nVal Number
+ * @return The prime (0 if there is not such prime in intervals)
+ */
+uint64_t PrimesIndex::nextPrime(uint64_t nVal) const
+{
+    uint64_t nRank = rank(nVal);
+
+    return (nRank < count() ? nthPrime(nRank) : 0);
+}
+
+/**
+ * @brief Returns memory of the index
+ * @param None
+ * @return Bytes of all containers
+ */
+size_t PrimesIndex::getMemoryUsage() const
+{
+    return (m_nWheelPrimesVc.capacity() + m_nBlockRankVc.capacity() + m_nRowRankVc.capacity()) * sizeof(uint64_t) +
+           (m_nBlockRowVc.capacity() + m_nSelectVc.capacity()) * sizeof(size_t);
+}
+
+//*****************************************************************************************
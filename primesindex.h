@@ -0,0 +1,52 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesindex.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Rank/select index over the result of the sieve. Every row of 64 indices of the sieved block (one word of
+  *          every spoke) has the number of primes before it, and the row of every m_nSelectSample-th prime is sampled,
+  *          so the n-th prime, the number of primes not greater than the number and the next prime are found by one
+  *          popcount of every spoke instead of the scan of positions. Memory is about 1 / spokes of the bits
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMESINDEX_H
+#define PRIMESINDEX_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+#include "primenumbersvector.h"
+
+class PrimesIndex
+{
+public:
+    PrimesIndex(const PrimeNumbersVector *pPrimeNumVector);
+    ~PrimesIndex();
+
+    uint64_t count() const;                                 // Number of primes in all intervals
+    uint64_t nthPrime(uint64_t nNum) const;                 // Prime number nNum (from 0) in ascending order
+    uint64_t rank(uint64_t nVal) const;                     // Number of primes not greater than nVal
+    uint64_t nextPrime(uint64_t nVal) const;                // The least prime greater than nVal (0 if there is not)
+    size_t getMemoryUsage() const;                          // Bytes of the index
+
+private:
+    friend class SharedPrimesExport;                        // Ranks and rows are published with the bits
+
+    static constexpr uint32_t m_nSelectSample = 1 << 12;    // Primes between samples of the select directory
+
+    const PrimeNumbersVector *m_pPrimeNumVector;            // Result of the sieve
+    std::vector <uint64_t> m_nWheelPrimesVc;                // Initial primes of the wheel which belong to intervals
+    std::vector <uint64_t> m_nBlockRankVc;                  // Primes before every block (and after the last one)
+    std::vector <size_t> m_nBlockRowVc;                     // First row of every block in m_nRowRankVc
+    std::vector <uint64_t> m_nRowRankVc;                    // Primes before every row of sieved blocks
+    std::vector <size_t> m_nSelectVc;                       // Rows after the prime number i * m_nSelectSample
+
+    void getRowBits(const SieveBlock &Block, uint64_t nRow, std::vector <uint64_t> &nBitsVc) const;
+};
+
+#endif // PRIMESINDEX_H
+
+//*****************************************************************************************
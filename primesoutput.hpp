@@ -1,31 +1,42 @@
-/**
-  *************************************************************************************************************************
-  * @file    PrimesOutput.hpp
-  * @author  Alexander Porada
-  *          a.porada@online.ua
-  * @date    23-December-2018
-  * @brief   The abstract class to output result of searching prime numbers
-  **************************************************************************************************************************
-*/
-
-#ifndef PRIMESOUTPUT_HPP
-#define PRIMESOUTPUT_HPP
-
-#include <vector>
-
-#include "primenumbersvector.h"
-
-class PrimesOutput
-{
-public:
-
-    PrimesOutput() {}
-    virtual ~PrimesOutput() {}
-
-    virtual void output(PrimeNumbersVector *pPrimeNumVc) = 0;
-};
-
-#endif // PRIMESOUTPUT_HPP
-
-
-//**************************************************************************************************************************
+/**
+  *************************************************************************************************************************
+  * @file    PrimesOutput.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    23-December-2018
+  * @brief   The abstract class to output result of searching prime numbers. The result is taken either from
+  *          PrimeNumbersVector at once or as the stream of ascending chunks of primes (begin, write..., end)
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMESOUTPUT_HPP
+#define PRIMESOUTPUT_HPP
+
+#include <vector>
+
+#include "primenumbersvector.h"
+
+class PrimesOutput
+{
+public:
+
+    PrimesOutput() {}
+    virtual ~PrimesOutput() {}
+
+    virtual void output(PrimeNumbersVector *pPrimeNumVc) = 0;
+
+    virtual void begin() = 0;                                       // Start of the stream
+    virtual void write(const std::vector <uint64_t> &PrimesVc) = 0; // Next primes of the stream
+    virtual void end() = 0;                                         // End of the stream
+
+    virtual bool resume(uint64_t, uint64_t) { return false; }       // Continue the stream from the offset and number of primes
+    virtual bool sync(uint64_t &) { return false; }                 // Write the stream to the disk, get its offset
+
+protected:
+    static constexpr size_t m_nChunkSize = 1 << 20;       // Number of positions of PrimeNumbersVector taken at once
+};
+
+#endif // PRIMESOUTPUT_HPP
+
+
+//**************************************************************************************************************************
@@ -0,0 +1,105 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesring.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Bounded ring of batches of primes between the sieving threads and the writer. The batch n goes to the
+  *          slot n % size, the producer waits while the slot holds the batch n - size, the writer takes batches
+  *          strictly in order. Slots are handed over by sequence numbers with acquire/release atomics, there are no
+  *          locks, waiting threads yield
+  **************************************************************************************************************************
+*/
+
+#include <thread>
+
+#include "primesring.h"
+
+/**
+ * @brief Class PrimesRing constructor
+ * @param nSlots Number of slots (batches which may be ready before the writer takes them)
+ */
+PrimesRing::PrimesRing(size_t nSlots): m_pSlots(new Slot[nSlots]), m_nSlots(nSlots), m_nWritten(0), m_nStalls(0)
+{
+    for(size_t i = 0; i < nSlots; ++i)
+    {
+        m_pSlots[i].m_nReady.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Class PrimesRing destructor
+ */
+PrimesRing::~PrimesRing() {}
+
+/**
+ * @brief Wait until the writer takes the batch nBatch - m_nSlots, then give the slot to the producer.
+ *        All batches before nBatch have producers already, so the writer reaches nBatch - m_nSlots and the wait ends
+ * @param nBatch Number of the batch
+ * @return Container to write primes of the batch in (it is empty)
+ */
+std::vector <uint64_t> &PrimesRing::acquire(uint64_t nBatch)
+{
+    if(nBatch >= m_nWritten.load(std::memory_order_acquire) + m_nSlots)
+    {
+        m_nStalls.fetch_add(1, std::memory_order_relaxed);
+        while(nBatch >= m_nWritten.load(std::memory_order_acquire) + m_nSlots)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::vector <uint64_t> &PrimesVc = m_pSlots[nBatch % m_nSlots].m_PrimesVc;
+    PrimesVc.clear();
+
+    return PrimesVc;
+}
+
+/**
+ * @brief Mark the batch as ready for the writer
+ * @param nBatch Number of the batch
+ * @return None
+ */
+void PrimesRing::publish(uint64_t nBatch)
+{
+    m_pSlots[nBatch % m_nSlots].m_nReady.store(nBatch + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Wait until the producer publishes the batch
+ * @param nBatch Number of the batch (the next one after the last released)
+ * @return Primes of the batch
+ */
+const std::vector <uint64_t> &PrimesRing::wait(uint64_t nBatch)
+{
+    Slot &Cur = m_pSlots[nBatch % m_nSlots];
+
+    while(Cur.m_nReady.load(std::memory_order_acquire) != nBatch + 1)
+    {
+        std::this_thread::yield();
+    }
+
+    return Cur.m_PrimesVc;
+}
+
+/**
+ * @brief Give the slot of the written batch back to producers
+ * @param nBatch Number of the batch
+ * @return None
+ */
+void PrimesRing::release(uint64_t nBatch)
+{
+    m_nWritten.store(nBatch + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Returns number of waits of producers for the free slot (the writer is the bottleneck if it is large)
+ * @param None
+ * @return Number of waits
+ */
+uint64_t PrimesRing::getStalls() const
+{
+    return m_nStalls.load(std::memory_order_relaxed);
+}
+
+//*****************************************************************************************
@@ -0,0 +1,51 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesring.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Bounded ring of batches of primes between the sieving threads and the writer. The batch n goes to the
+  *          slot n % size, the producer waits while the slot holds the batch n - size, the writer takes batches
+  *          strictly in order. Slots are handed over by sequence numbers with acquire/release atomics, there are no
+  *          locks, waiting threads yield
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMESRING_H
+#define PRIMESRING_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <stdint.h>
+
+class PrimesRing
+{
+public:
+    PrimesRing(size_t nSlots);
+    ~PrimesRing();
+
+    std::vector <uint64_t> &acquire(uint64_t nBatch);              // Producer: wait for the free slot of the batch
+    void publish(uint64_t nBatch);                                 // Producer: the batch is ready
+    const std::vector <uint64_t> &wait(uint64_t nBatch);           // Writer: wait for the batch
+    void release(uint64_t nBatch);                                 // Writer: the batch is written, the slot is free
+    uint64_t getStalls() const;                                    // Number of waits of producers for the writer
+
+private:
+    struct Slot
+    {
+        std::atomic <uint64_t> m_nReady;                           // Number of the ready batch + 1 (0 - empty)
+        std::vector <uint64_t> m_PrimesVc;                         // Primes of the batch
+        char m_Pad[64];                                            // Keep slots in different cache lines
+    };
+
+    std::unique_ptr <Slot []> m_pSlots;
+    size_t m_nSlots;
+    std::atomic <uint64_t> m_nWritten;                             // Number of batches taken by the writer
+    std::atomic <uint64_t> m_nStalls;
+};
+
+#endif // PRIMESRING_H
+
+//*****************************************************************************************
@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    primesrow.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Queries inside one row of the rank index: 64 indices of all
+  *          spokes, bit i of the word of the spoke is set if the number of
+  *          the index i and the spoke is prime. Bits of the row are read by
+  *          the accessor Bits[spoke], so PrimesIndex and SharedPrimesReader
+  *          share the same code for the words of the sieve and the words of
+  *          shared memory
+  ******************************************************************************
+*/
+
+#ifndef PRIMESROW_HPP
+#define PRIMESROW_HPP
+
+#include <stdint.h>
+
+struct PrimesRow
+{
+    /**
+     * @brief Number of primes of the row before the number: indices before nBit in all spokes and the index nBit in
+     *        spokes not greater than the number's one
+     * @param Bits Accessor of bits of the row
+     * @param pSpokes Spokes in ascending order
+     * @param nSpokes Number of spokes
+     * @param nBit Index of the number in the row (0...63)
+     * @param nSpoke Remainder of the number modulo the primorial
+     * @return Number of primes
+     */
+    template <class RowBits>
+    static uint64_t rank(const RowBits &Bits, const uint32_t *pSpokes, uint32_t nSpokes, uint32_t nBit, uint32_t nSpoke)
+    {
+        uint64_t nMask = (nBit ? ~static_cast <uint64_t> (0) >> (64 - nBit) : 0), nRank(0);   // Indices before the number's one
+
+        for(uint32_t i = 0; i < nSpokes; ++i)
+        {
+            nRank += __builtin_popcountll(Bits[i] & nMask);
+            if(pSpokes[i] <= nSpoke)
+            {
+                nRank += (Bits[i] >> nBit) & 1;
+            }
+        }
+
+        return nRank;
+    }
+
+    /**
+     * @brief Find the prime of the row by its number: the index by the binary search of popcounts, then the spoke
+     * @param Bits Accessor of bits of the row
+     * @param nSpokes Number of spokes
+     * @param nRest Number of the prime in the row (from 0), it must be less than primes of the row
+     * @param nBit Index of the prime in the row (0...63)
+     * @param nSpoke Index of the spoke of the prime
+     * @return None
+     */
+    template <class RowBits>
+    static void select(const RowBits &Bits, uint32_t nSpokes, uint64_t nRest, uint32_t &nBit, uint32_t &nSpoke)
+    {
+        uint32_t nLowBit(0), nHighBit(63);                                  // The least bit with more than nRest primes up to it
+        uint64_t nBefore(0);                                                // Primes before nLowBit
+
+        while(nLowBit < nHighBit)
+        {
+            uint32_t nMidBit = (nLowBit + nHighBit) / 2;
+            uint64_t nMask = ~static_cast <uint64_t> (0) >> (63 - nMidBit), nCount(0);
+
+            for(uint32_t i = 0; i < nSpokes; ++i)
+            {
+                nCount += __builtin_popcountll(Bits[i] & nMask);
+            }
+
+            if(nCount > nRest)
+            {
+                nHighBit = nMidBit;
+            }
+            else
+            {
+                nLowBit = nMidBit + 1;
+                nBefore = nCount;
+            }
+        }
+
+        for(nSpoke = 0, nRest -= nBefore; ; ++nSpoke)                        // Spokes of the bit are in ascending order
+        {
+            if(((Bits[nSpoke] >> nLowBit) & 1) && !nRest--)
+            {
+                break;
+            }
+        }
+        nBit = nLowBit;
+    }
+};
+
+#endif // PRIMESROW_HPP
+
+//*****************************************************************************************
@@ -0,0 +1,103 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesteeoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which gives the same stream of primes to several
+  *          outputs. The pipelined mode finds primes again for every call of FindPrimes::output(), so all outputs
+  *          take primes from one pass of the sieve
+  **************************************************************************************************************************
+*/
+
+#include "primesteeoutput.h"
+
+#include "profiler.h"
+
+/**
+ * @brief Class PrimesTeeOutput constructor
+ * @param None
+ */
+PrimesTeeOutput::PrimesTeeOutput(): PrimesOutput() {}
+
+/**
+ * @brief Class PrimesTeeOutput destructor. All outputs added are deleted
+ */
+PrimesTeeOutput::~PrimesTeeOutput()
+{
+    for(PrimesOutput *pOutput : m_OutputsVc)
+    {
+        delete pOutput;
+    }
+}
+
+/**
+ * @brief Add the output which takes the stream after the outputs added before
+ * @param pOutput Output (it is deleted by the tee)
+ * @return None
+ */
+void PrimesTeeOutput::add(PrimesOutput *pOutput)
+{
+    m_OutputsVc.push_back(pOutput);
+}
+
+/**
+ * @brief Implementation of the abstract function to output prime numbers from PrimeNumbersVector. Primes are taken
+ *        once and given to all outputs
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void PrimesTeeOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("output");
+    std::vector <uint64_t> PrimesVc;
+
+    begin();
+    for(size_t i = 0, p = pPrimeNumVc->size(); i < p; i += m_nChunkSize)
+    {
+        pPrimeNumVc->getPrimes(i, m_nChunkSize, PrimesVc);
+        write(PrimesVc);
+    }
+    end();
+}
+
+/**
+ * @brief Start the stream of all outputs
+ * @param None
+ * @return None
+ */
+void PrimesTeeOutput::begin()
+{
+    for(PrimesOutput *pOutput : m_OutputsVc)
+    {
+        pOutput->begin();
+    }
+}
+
+/**
+ * @brief Give next primes of the stream to all outputs
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void PrimesTeeOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    for(PrimesOutput *pOutput : m_OutputsVc)
+    {
+        pOutput->write(PrimesVc);
+    }
+}
+
+/**
+ * @brief End the stream of all outputs
+ * @param None
+ * @return None
+ */
+void PrimesTeeOutput::end()
+{
+    for(PrimesOutput *pOutput : m_OutputsVc)
+    {
+        pOutput->end();
+    }
+}
+
+//*****************************************************************************************
@@ -0,0 +1,38 @@
+/**
+  *************************************************************************************************************************
+  * @file    primesteeoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which gives the same stream of primes to several
+  *          outputs. The pipelined mode finds primes again for every call of FindPrimes::output(), so all outputs
+  *          take primes from one pass of the sieve
+  **************************************************************************************************************************
+*/
+
+#ifndef PRIMESTEEOUTPUT_H
+#define PRIMESTEEOUTPUT_H
+
+#include "primesoutput.hpp"
+
+class PrimesTeeOutput: public PrimesOutput
+{
+public:
+    PrimesTeeOutput();
+    virtual ~PrimesTeeOutput() override;
+
+    void add(PrimesOutput *pOutput);                        // The output is deleted by the tee
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+private:
+    std::vector <PrimesOutput*> m_OutputsVc;
+};
+
+#endif // PRIMESTEEOUTPUT_H
+
+//*****************************************************************************************
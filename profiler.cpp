@@ -0,0 +1,391 @@
+/**
+  *************************************************************************************************************************
+  * @file    profiler.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Instrumentation of the pipeline: monotonic timers of phases (reading, parsing, merging of intervals, initial
+  *          primes, wheel, sieve, direct test, output) for the whole phase and for every worker thread, and counters
+  *          (bytes parsed, candidates sieved, primes emitted, ...). The report is written as JSON on request.
+  *          Optionally hardware counters of the thread are collected for every phase. Disabled profiler doesn't read
+  *          the clock
+  **************************************************************************************************************************
+*/
+
+#include <fstream>
+
+#include "profiler.h"
+#include "alloctracker.h"
+
+/**
+ * @brief Class ScopedTimer constructor. Starts the timer if the profiler is enabled
+ * @param pPhase Name of the phase (string literal)
+ * @param nWorker Index of the worker thread, -1 for the whole phase
+ */
+Profiler::ScopedTimer::ScopedTimer(const char *pPhase, int32_t nWorker):
+    m_pPhase(pPhase),
+    m_nWorker(nWorker),
+    m_fActive(Profiler::get().isEnabled()),
+    m_fPerf(Profiler::get().isPerfEnabled()),
+    m_nPrevAllocPhase(0)
+{
+    if(m_fActive && AllocTracker::isCompiled())
+    {
+        m_nPrevAllocPhase = AllocTracker::enterPhase(pPhase);             // Allocations are counted for the phase
+    }
+    if(m_fPerf)
+    {
+        PerfCounters::forThread().read(m_StartPerf);
+    }
+    if(m_fActive)
+    {
+        m_Start = std::chrono::steady_clock::now();
+    }
+}
+
+/**
+ * @brief Class ScopedTimer destructor. Adds the elapsed time to the phase
+ */
+Profiler::ScopedTimer::~ScopedTimer()
+{
+    if(m_fActive)
+    {
+        std::chrono::nanoseconds Elapsed = std::chrono::steady_clock::now() - m_Start;
+        Profiler::get().addTime(m_pPhase, m_nWorker, Elapsed.count());
+    }
+    if(m_fPerf)
+    {
+        PerfCounters::Values Delta;
+
+        PerfCounters::forThread().read(Delta);
+        for(uint32_t i = 0; i < PerfCounters::EVENTS_NUM; ++i)
+        {
+            Delta.m_fValid[i] = Delta.m_fValid[i] && m_StartPerf.m_fValid[i];
+            Delta.m_nCount[i] -= m_StartPerf.m_nCount[i];
+        }
+        Profiler::get().addPerf(m_pPhase, m_nWorker, Delta);
+    }
+    if(m_fActive && AllocTracker::isCompiled())
+    {
+        AllocTracker::leavePhase(m_nPrevAllocPhase);
+    }
+}
+
+/**
+ * @brief Class Profiler constructor
+ */
+Profiler::Profiler(): m_fEnabled(false), m_fPerfEnabled(false) {}
+
+/**
+ * @brief The only profiler of the program
+ * @param None
+ * @return Profiler
+ */
+Profiler &Profiler::get()
+{
+    static Profiler Instance;
+
+    return Instance;
+}
+
+/**
+ * @brief Enable or disable the profiler. It must be set before worker threads start
+ * @param fEnabled true to enable
+ * @return None
+ */
+void Profiler::setEnabled(bool fEnabled)
+{
+    m_fEnabled = fEnabled;
+}
+
+/**
+ * @brief Check whether the profiler is enabled
+ * @param None
+ * @return true if enabled
+ */
+bool Profiler::isEnabled() const
+{
+    return m_fEnabled;
+}
+
+/**
+ * @brief Enable or disable hardware counters. They must be set before worker threads start. If counters can't be opened
+ *        in the calling thread, they stay disabled
+ * @param fEnabled true to enable
+ * @return true if counters are enabled or disabling has been requested
+ */
+bool Profiler::setPerfEnabled(bool fEnabled)
+{
+    m_fPerfEnabled = fEnabled && PerfCounters::forThread().isAvailable();
+
+    return m_fPerfEnabled == fEnabled;
+}
+
+/**
+ * @brief Check whether hardware counters are enabled
+ * @param None
+ * @return true if enabled
+ */
+bool Profiler::isPerfEnabled() const
+{
+    return m_fPerfEnabled;
+}
+
+/**
+ * @brief Add the value to the record with the name and the worker, or create the record
+ * @param RecordsVc Records
+ * @param pName Name
+ * @param nWorker Index of the worker thread, -1 for the whole phase
+ * @param nVal Value to add
+ * @return None
+ */
+void Profiler::add(std::vector <Record> &RecordsVc, const char *pName, int32_t nWorker, uint64_t nVal)
+{
+    for(Record &Rec : RecordsVc)
+    {
+        if(Rec.m_nWorker == nWorker && Rec.m_sName == pName)
+        {
+            Rec.m_nValue += nVal;
+            ++Rec.m_nCalls;
+            return;
+        }
+    }
+
+    RecordsVc.push_back({ pName, nWorker, nVal, 1 });
+}
+
+/**
+ * @brief Find the record with the name and the worker
+ * @param RecordsVc Records
+ * @param sName Name
+ * @param nWorker Index of the worker thread, -1 for the whole phase
+ * @return Pointer to the record or nullptr
+ */
+const Profiler::Record *Profiler::find(const std::vector <Record> &RecordsVc, const std::string &sName, int32_t nWorker)
+{
+    for(const Record &Rec : RecordsVc)
+    {
+        if(Rec.m_nWorker == nWorker && Rec.m_sName == sName)
+        {
+            return &Rec;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Add time to the phase
+ * @param pPhase Name of the phase
+ * @param nWorker Index of the worker thread, -1 for the whole phase
+ * @param nNanos Time in nanoseconds
+ * @return None
+ */
+void Profiler::addTime(const char *pPhase, int32_t nWorker, uint64_t nNanos)
+{
+    if(m_fEnabled)
+    {
+        std::lock_guard <std::mutex> Lock(m_Mutex);
+        add(m_PhasesVc, pPhase, nWorker, nNanos);
+    }
+}
+
+/**
+ * @brief Add the value to the counter
+ * @param pName Name of the counter
+ * @param nVal Value to add
+ * @param nWorker Index of the worker thread, -1 for the whole program
+ * @return None
+ */
+void Profiler::addCounter(const char *pName, uint64_t nVal, int32_t nWorker)
+{
+    if(m_fEnabled)
+    {
+        std::lock_guard <std::mutex> Lock(m_Mutex);
+        add(m_CountersVc, pName, nWorker, nVal);
+    }
+}
+
+/**
+ * @brief Set the counter. Used for values which several reporters give for the same data (all outputs of one search
+ *        report the same number of primes)
+ * @param pName Name of the counter
+ * @param nVal Value
+ * @param nWorker Index of the worker thread, -1 for the whole program
+ * @return None
+ */
+void Profiler::setCounter(const char *pName, uint64_t nVal, int32_t nWorker)
+{
+    if(m_fEnabled)
+    {
+        std::lock_guard <std::mutex> Lock(m_Mutex);
+        for(Record &Rec : m_CountersVc)
+        {
+            if(Rec.m_nWorker == nWorker && Rec.m_sName == pName)
+            {
+                Rec.m_nValue = nVal;
+                ++Rec.m_nCalls;
+                return;
+            }
+        }
+
+        m_CountersVc.push_back({ pName, nWorker, nVal, 1 });
+    }
+}
+
+/**
+ * @brief Add hardware counters to the phase. The counter is valid if it was valid in every addition
+ * @param pPhase Name of the phase
+ * @param nWorker Index of the worker thread, -1 for the whole phase (only the calling thread is counted)
+ * @param Delta Counters of the phase
+ * @return None
+ */
+void Profiler::addPerf(const char *pPhase, int32_t nWorker, const PerfCounters::Values &Delta)
+{
+    std::lock_guard <std::mutex> Lock(m_Mutex);
+
+    for(PerfRecord &Rec : m_PerfVc)
+    {
+        if(Rec.m_nWorker == nWorker && Rec.m_sName == pPhase)
+        {
+            for(uint32_t i = 0; i < PerfCounters::EVENTS_NUM; ++i)
+            {
+                Rec.m_Sum.m_nCount[i] += Delta.m_nCount[i];
+                Rec.m_Sum.m_fValid[i] = Rec.m_Sum.m_fValid[i] && Delta.m_fValid[i];
+            }
+            return;
+        }
+    }
+
+    m_PerfVc.push_back({ pPhase, nWorker, Delta });
+}
+
+/**
+ * @brief Stage of the pipeline which the phase belongs to
+ * @param sPhase Name of the phase
+ * @return Name of the stage
+ */
+const char *Profiler::getStage(const std::string &sPhase)
+{
+    static const char *pStages[][2] = { { "read_file", "ReadXml" }, { "parse", "ReadXml" },
+                                        { "merge_intervals", "IntervalsOutput" }, { "batch_test", "BatchPrimality" },
+                                        { "output", "PrimesOutput" } };
+
+    for(const char **pItem : pStages)
+    {
+        if(sPhase == pItem[0])
+        {
+            return pItem[1];
+        }
+    }
+
+    return "FindPrimes";
+}
+
+/**
+ * @brief Write hardware counters of phases in JSON (the part of the report)
+ * @param out Stream to write in
+ * @return None
+ */
+void Profiler::writePerf(std::ostream &out) const
+{
+    out << ",\n  \"perf\": {\n    \"available\": " << (m_fPerfEnabled ? "true" : "false") << ",\n    \"records\": [";
+
+    for(size_t i = 0, p = m_PerfVc.size(); i < p; ++i)
+    {
+        const PerfRecord &Rec = m_PerfVc[i];
+
+        out << (i ? ",\n" : "\n") << "      { \"name\": \"" << Rec.m_sName << "\", \"stage\": \"" << getStage(Rec.m_sName)
+            << "\", \"worker\": " << Rec.m_nWorker;
+        for(uint32_t j = 0; j < PerfCounters::EVENTS_NUM; ++j)
+        {
+            if(Rec.m_Sum.m_fValid[j])
+            {
+                out << ", \"" << PerfCounters::getName(j) << "\": " << Rec.m_Sum.m_nCount[j];
+            }
+        }
+
+        const bool *pValid = Rec.m_Sum.m_fValid;
+        if(pValid[PerfCounters::CYCLES] && pValid[PerfCounters::INSTRUCTIONS] && Rec.m_Sum.m_nCount[PerfCounters::CYCLES])
+        {
+            out << ", \"ipc\": " << static_cast <double> (Rec.m_Sum.m_nCount[PerfCounters::INSTRUCTIONS]) /
+                                     Rec.m_Sum.m_nCount[PerfCounters::CYCLES];
+        }
+        out << " }";
+    }
+
+    out << "\n    ]\n  }";
+}
+
+/**
+ * @brief Write the report in JSON. Idle time of the worker is the time of the whole phase minus the time of the worker,
+ *        throughput is the counter divided by the time of the phase it belongs to. Allocations are reported only
+ *        in the build with the allocation tracker
+ * @param pFileName Name of the file
+ * @return true if the report has been written
+ */
+bool Profiler::writeJson(const char *pFileName) const
+{
+    static const char *pThroughput[][3] = { { "bytes_parsed", "parse", "bytes_per_second" },
+                                            { "candidates_sieved", "sieve", "candidates_per_second" },
+                                            { "numbers_tested", "direct_test", "tests_per_second" },
+                                            { "primes_emitted", "output", "primes_per_second" } };
+
+    std::lock_guard <std::mutex> Lock(m_Mutex);
+    std::ofstream out(pFileName);
+
+    if(!out)
+    {
+        return false;
+    }
+
+    out << "{\n  \"phases\": [";
+    for(size_t i = 0, p = m_PhasesVc.size(); i < p; ++i)
+    {
+        const Record &Rec = m_PhasesVc[i];
+
+        out << (i ? ",\n" : "\n") << "    { \"name\": \"" << Rec.m_sName << "\", \"worker\": " << Rec.m_nWorker
+            << ", \"ns\": " << Rec.m_nValue << ", \"calls\": " << Rec.m_nCalls;
+
+        const Record *pWhole = find(m_PhasesVc, Rec.m_sName, -1);
+        if(Rec.m_nWorker >= 0 && pWhole)
+        {
+            out << ", \"idle_ns\": " << (pWhole->m_nValue > Rec.m_nValue ? pWhole->m_nValue - Rec.m_nValue : 0);
+        }
+        out << " }";
+    }
+
+    out << "\n  ],\n  \"counters\": [";
+    for(size_t i = 0, p = m_CountersVc.size(); i < p; ++i)
+    {
+        out << (i ? ",\n" : "\n") << "    { \"name\": \"" << m_CountersVc[i].m_sName << "\", \"worker\": "
+            << m_CountersVc[i].m_nWorker << ", \"value\": " << m_CountersVc[i].m_nValue << " }";
+    }
+
+    out << "\n  ],\n  \"throughput\": {";
+    bool fFirst(true);
+    for(const char **pItem : pThroughput)
+    {
+        const Record *pCounter = find(m_CountersVc, pItem[0], -1);
+        const Record *pPhase = find(m_PhasesVc, pItem[1], -1);
+
+        if(pCounter && pPhase && pPhase->m_nValue)
+        {
+            out << (fFirst ? "\n" : ",\n") << "    \"" << pItem[2] << "\": " << pCounter->m_nValue * 1e9 / pPhase->m_nValue;
+            fFirst = false;
+        }
+    }
+    out << "\n  }";
+
+    writePerf(out);
+    if(AllocTracker::isCompiled())
+    {
+        out << ",\n  \"allocations\": ";
+        AllocTracker::writeJson(out);
+    }
+    out << "\n}\n";
+
+    return static_cast <bool> (out);
+}
+
+//*****************************************************************************************
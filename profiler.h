@@ -0,0 +1,93 @@
+/**
+  *************************************************************************************************************************
+  * @file    profiler.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Instrumentation of the pipeline: monotonic timers of phases (reading, parsing, merging of intervals, initial
+  *          primes, wheel, sieve, direct test, output) for the whole phase and for every worker thread, and counters
+  *          (bytes parsed, candidates sieved, primes emitted, ...). The report is written as JSON on request.
+  *          Optionally hardware counters of the thread are collected for every phase. Disabled profiler doesn't read
+  *          the clock
+  **************************************************************************************************************************
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <mutex>
+#include <chrono>
+#include <stdint.h>
+
+#include "perfcounters.h"
+
+class Profiler
+{
+public:
+    class ScopedTimer                                       // Adds time from construction to destruction to the phase
+    {
+    public:
+        ScopedTimer(const char *pPhase, int32_t nWorker = -1);
+        ~ScopedTimer();
+
+    private:
+        const char *m_pPhase;
+        int32_t m_nWorker;                                  // -1 for the whole phase
+        bool m_fActive;
+        bool m_fPerf;                                       // Hardware counters are collected
+        uint32_t m_nPrevAllocPhase;                         // Phase of the allocation tracker to restore
+        std::chrono::steady_clock::time_point m_Start;
+        PerfCounters::Values m_StartPerf;
+    };
+
+    static Profiler &get();
+
+    void setEnabled(bool fEnabled);
+    bool isEnabled() const;
+    bool setPerfEnabled(bool fEnabled);                     // Returns false if counters are unavailable
+    bool isPerfEnabled() const;
+    void addTime(const char *pPhase, int32_t nWorker, uint64_t nNanos);
+    void addPerf(const char *pPhase, int32_t nWorker, const PerfCounters::Values &Delta);
+    void addCounter(const char *pName, uint64_t nVal, int32_t nWorker = -1);
+    void setCounter(const char *pName, uint64_t nVal, int32_t nWorker = -1);    // Value of several reporters is counted once
+    bool writeJson(const char *pFileName) const;
+
+private:
+    struct Record
+    {
+        std::string m_sName;
+        int32_t m_nWorker;
+        uint64_t m_nValue;                                  // Nanoseconds for phases, value for counters
+        uint64_t m_nCalls;
+    };
+
+    struct PerfRecord
+    {
+        std::string m_sName;
+        int32_t m_nWorker;
+        PerfCounters::Values m_Sum;
+    };
+
+    bool m_fEnabled;
+    bool m_fPerfEnabled;
+    mutable std::mutex m_Mutex;                             // Workers add records concurrently
+    std::vector <Record> m_PhasesVc;                        // In order of the first record
+    std::vector <Record> m_CountersVc;
+    std::vector <PerfRecord> m_PerfVc;
+
+    Profiler();
+    Profiler(const Profiler &) = delete;
+    Profiler &operator = (const Profiler &) = delete;
+
+    static void add(std::vector <Record> &RecordsVc, const char *pName, int32_t nWorker, uint64_t nVal);
+    static const char *getStage(const std::string &sPhase);
+    void writePerf(std::ostream &out) const;
+    static const Record *find(const std::vector <Record> &RecordsVc, const std::string &sName, int32_t nWorker);
+};
+
+#endif // PROFILER_H
+
+//*****************************************************************************************
@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file    progression.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Arithmetic progression n = m_nResidue (mod m_nModulus) to restrict
+  *          found primes with. The wheel of FindPrimes is widened to multiple
+  *          of the modulus, so every spoke lies in one residue class and only
+  *          spokes of the progression are sieved. Prime factors of the modulus
+  *          must be primes of the wheel (up to 13)
+  ******************************************************************************
+*/
+
+#ifndef PROGRESSION_HPP
+#define PROGRESSION_HPP
+
+#include <stdint.h>
+
+struct Progression
+{
+    static constexpr uint32_t m_nMaxModulus = 1 << 12;          // The wheel is widened m_nModulus times at most
+
+    uint32_t m_nModulus;                                        // 1 - all numbers
+    uint32_t m_nResidue;
+
+    Progression(uint32_t nModulus = 1, uint32_t nResidue = 0): m_nModulus(nModulus), m_nResidue(nResidue) {}
+};
+
+#endif // PROGRESSION_HPP
+
+//*****************************************************************************************
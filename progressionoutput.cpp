@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************************************************************
+  * @file    progressionoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class Xml_output which implements getting the arithmetic progression to restrict
+  *          primes with (<progression> <modulus> 4 </modulus> <residue> 1 </residue> </progression>) from the parsed xml file
+  ******************************************************************************************************************************
+*/
+
+#include "progressionoutput.h"
+
+/**
+ * @brief Class ProgressionOutput constructor
+ * @param pProgression Progression to fill (it is kept if the file has no progression)
+ */
+ProgressionOutput::ProgressionOutput(Progression *pProgression): XML_output(), m_pProgression(pProgression) {}
+
+/**
+ * @brief Class ProgressionOutput destructor
+ */
+ProgressionOutput::~ProgressionOutput() {}
+
+/**
+ * @brief Implementation of the abstract function to get the progression from tags. The last one is taken if there are
+ *        several of them
+ * @param ParserXml Parsed xml file
+ * @return None
+ */
+void ProgressionOutput::output(const ReadXml &ParserXml)
+{
+    size_t nCurPos(0);
+
+    for(Tag tag = ParserXml.getTag(nCurPos, "progression"); tag.getName() != "EMPTY_TAG";
+        tag = ParserXml.getTag(nCurPos, "progression"))
+    {
+        m_pProgression->m_nModulus = tag.getTag("modulus").getValue();
+        m_pProgression->m_nResidue = tag.getTag("residue").getValue();
+    }
+}
+
+//*******************************************************************************************************
@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************************************************************
+  * @file    progressionoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class Xml_output which implements getting the arithmetic progression to restrict
+  *          primes with (<progression> <modulus> 4 </modulus> <residue> 1 </residue> </progression>) from the parsed xml file
+  ******************************************************************************************************************************
+*/
+
+#ifndef PROGRESSIONOUTPUT_H
+#define PROGRESSIONOUTPUT_H
+
+#include "xml_output.hpp"
+#include "progression.hpp"
+
+class ProgressionOutput: public XML_output
+{
+public:
+    ProgressionOutput(Progression *pProgression);
+    ~ProgressionOutput() override;
+
+    void output(const ReadXml &ParserXml) override;
+
+private:
+    Progression *m_pProgression;
+};
+
+#endif // PROGRESSIONOUTPUT_H
+
+//*****************************************************************************************
@@ -0,0 +1,420 @@
+/**
+  *************************************************************************************************************************
+  * @file    shardcoordinator.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to search primes by several processes. Merged intervals are split into shards of equal estimated cost,
+  *          every shard is written to its own xml file and searched by the worker process, which writes binary file
+  *          of primes and reports their number through the pipe. Workers are forked, or started by the launcher
+  *          command (e.g. "ssh node /path/PrimesProject") if files are on the shared filesystem. Binary files are
+  *          stitched in the order of shards into the output
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include "shardcoordinator.h"
+#include "sieveplanner.h"
+#include "readxml.h"
+#include "intervalsoutput.h"
+#include "progressionoutput.h"
+#include "findprimes.h"
+#include "primesbinaryoutput.h"
+#include "profiler.h"
+
+/**
+ * @brief Class ShardCoordinator constructor. Splits intervals into shards
+ * @param pIntVc Sorted merged intervals
+ * @param nShards Number of shards (worker processes)
+ * @param pPrefix Path and beginning of names of files of shards (on the shared filesystem if workers are launched on other nodes)
+ * @param Settings Settings of the sieve of workers. Forked workers share threads (if their number is 0) and the memory budget
+ *        of the computer
+ * @param pLauncher Command to start the worker, it gets arguments "--worker <in> <out>" (nullptr - workers are forked)
+ */
+ShardCoordinator::ShardCoordinator(const std::vector <Interval> *pIntVc, uint32_t nShards, const char *pPrefix,
+                                   const SieveSettings &Settings, const char *pLauncher):
+    m_pIntVc(pIntVc),
+    m_nShards(nShards ? nShards : 1),
+    m_sPrefix(pPrefix),
+    m_Settings(Settings),
+    m_pLauncher(pLauncher),
+    m_pOutput(nullptr),
+    m_nPrimesNum(0)
+{
+    if(!m_Settings.m_nThreads && !m_pLauncher)
+    {
+        m_Settings.m_nThreads = std::thread::hardware_concurrency() / m_nShards;
+        if(!m_Settings.m_nThreads)
+        {
+            m_Settings.m_nThreads = 1;
+        }
+    }
+
+    if(!m_pLauncher)
+    {
+        m_Settings.m_nMemoryBudget /= m_nShards;                            // Forked workers share memory of the computer
+    }
+
+    makeShards();
+}
+
+/**
+ * @brief Class ShardCoordinator destructor
+ */
+ShardCoordinator::~ShardCoordinator()
+{
+    if(m_pOutput)
+    {
+        delete m_pOutput;
+    }
+}
+
+/**
+ * @brief Split intervals into shards of equal estimated cost. The cost of the interval is spread evenly over its numbers,
+ *        so the interval is cut where the shard gets its part of the total cost. Shards keep the order of intervals
+ * @param None
+ * @return None
+ */
+void ShardCoordinator::makeShards()
+{
+    SievePlanner Planner(m_pIntVc);
+    std::vector <double> fCostVc(m_pIntVc->size());
+    double fTotal(0), fAcc(0);
+
+    for(size_t i = 0, p = m_pIntVc->size(); i < p; ++i)
+    {
+        fCostVc[i] = Planner.estimateCost((*m_pIntVc)[i]);
+        fTotal += fCostVc[i];
+    }
+
+    double fTarget = fTotal / m_nShards;
+    m_ShardsVc.assign(1, std::vector <Interval> ());
+    for(size_t i = 0, p = m_pIntVc->size(); i < p; ++i)
+    {
+        uint64_t nLow = (*m_pIntVc)[i].m_nLowIntervalSide, nHigh = (*m_pIntVc)[i].m_nHighIntervalSide;
+        double fPerNum = fCostVc[i] / (static_cast <double> (nHigh - nLow) + 1);
+
+        for(;;)
+        {
+            uint64_t nLeft = nHigh - nLow;                                  // Numbers of the rest of the interval minus 1
+            double fNums = (fTarget - fAcc) / fPerNum;                      // Numbers to complete the shard
+
+            if(m_ShardsVc.size() == m_nShards || fNums >= static_cast <double> (nLeft) + 1)
+            {
+                m_ShardsVc.back().push_back(Interval(nLow, nHigh));         // The last shard takes everything
+                fAcc += fPerNum * (static_cast <double> (nLeft) + 1);
+                break;
+            }
+
+            uint64_t nTake = static_cast <uint64_t> (fNums);
+            if(!nTake && m_ShardsVc.back().empty())
+            {
+                nTake = 1;                                                  // Every shard has some numbers
+            }
+
+            if(nTake > nLeft)
+            {
+                m_ShardsVc.back().push_back(Interval(nLow, nHigh));
+                fAcc += fPerNum * (static_cast <double> (nLeft) + 1);
+                break;
+            }
+
+            if(nTake)
+            {
+                m_ShardsVc.back().push_back(Interval(nLow, nLow + nTake - 1));
+                nLow += nTake;
+            }
+
+            m_ShardsVc.push_back(std::vector <Interval> ());
+            fAcc = 0;
+        }
+    }
+
+    if(m_ShardsVc.back().empty())
+    {
+        m_ShardsVc.pop_back();
+    }
+}
+
+/**
+ * @brief Write intervals of the shard and the progression to the xml file of the worker
+ * @param IntVc Intervals of the shard
+ * @param sName Name of the file
+ * @return None
+ */
+void ShardCoordinator::writeShard(const std::vector <Interval> &IntVc, const std::string &sName) const
+{
+    std::ofstream Out(sName);
+
+    if(!Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    Out << "<root>\n  <intervals>\n";
+    for(const Interval &Int : IntVc)
+    {
+        Out << "    <interval>\n      <low> " << Int.m_nLowIntervalSide << " </low>\n      <high> "
+            << Int.m_nHighIntervalSide << " </high>\n    </interval>\n";
+    }
+    Out << "  </intervals>\n";
+
+    if(m_Settings.m_Progression.m_nModulus != 1)
+    {
+        Out << "  <progression>\n    <modulus> " << m_Settings.m_Progression.m_nModulus << " </modulus>\n    <residue> "
+            << m_Settings.m_Progression.m_nResidue << " </residue>\n  </progression>\n";
+    }
+    Out << "</root>\n";
+}
+
+/**
+ * @brief Quote the argument of the shell command
+ * @param sArg Argument
+ * @return Argument in single quotes
+ */
+std::string ShardCoordinator::quote(const std::string &sArg)
+{
+    std::string sRes("'");
+
+    for(char c : sArg)
+    {
+        sRes += (c == '\'' ? std::string("'\\''") : std::string(1, c));
+    }
+
+    return sRes + '\'';
+}
+
+/**
+ * @brief Start the worker. The forked process searches the shard itself, the launched one is the shell command with
+ *        its standard output redirected to the pipe. Without fork() the worker is run later by collect()
+ * @param Wrk Worker with names of its files
+ * @return None
+ */
+void ShardCoordinator::launch(Worker &Wrk) const
+{
+    Wrk.m_nPid = 0;
+    Wrk.m_nPipe = -1;
+
+#ifdef __linux__
+    int nFd[2];
+
+    if(pipe(nFd))
+    {
+        std::cerr << "Pipe creating error!\n";
+        exit(1);
+    }
+
+    std::cout.flush();                                                      // Buffers are not written twice by the child
+    fflush(nullptr);
+
+    int nPid = fork();
+    if(nPid < 0)
+    {
+        std::cerr << "Worker starting error!\n";
+        exit(1);
+    }
+
+    if(!nPid)
+    {
+        close(nFd[0]);
+        if(m_pLauncher)
+        {
+            std::string sCmd = std::string(m_pLauncher) + " --worker " + quote(Wrk.m_sInName) + ' ' + quote(Wrk.m_sOutName);
+
+            dup2(nFd[1], 1);
+            close(nFd[1]);
+            execl("/bin/sh", "sh", "-c", sCmd.c_str(), static_cast <char*> (nullptr));
+            _exit(127);
+        }
+
+        std::string sStatus = std::to_string(runWorker(Wrk.m_sInName.c_str(), Wrk.m_sOutName.c_str(), m_Settings)) + '\n';
+        _exit(::write(nFd[1], sStatus.data(), sStatus.size()) == static_cast <ssize_t> (sStatus.size()) ? 0 : 1);
+    }
+
+    close(nFd[1]);
+    Wrk.m_nPid = nPid;
+    Wrk.m_nPipe = nFd[0];
+#endif
+}
+
+/**
+ * @brief Wait for the worker and get its status: number of primes written by it
+ * @param Wrk Started worker
+ * @return Number of primes of the shard
+ */
+uint64_t ShardCoordinator::collect(Worker &Wrk) const
+{
+    if(!Wrk.m_nPid)
+    {
+        return runWorker(Wrk.m_sInName.c_str(), Wrk.m_sOutName.c_str(), m_Settings);
+    }
+
+    std::string sStatus;
+    bool fDone(false);
+
+#ifdef __linux__
+    char cBuf[256];
+    int nStatus(0);
+
+    for(ssize_t nRead; (nRead = read(Wrk.m_nPipe, cBuf, sizeof(cBuf))) > 0; )
+    {
+        sStatus.append(cBuf, nRead);
+    }
+    close(Wrk.m_nPipe);
+    Wrk.m_nPipe = -1;
+
+    fDone = (waitpid(Wrk.m_nPid, &nStatus, 0) == Wrk.m_nPid && WIFEXITED(nStatus) && !WEXITSTATUS(nStatus));
+#endif
+
+    char *pEnd = nullptr;
+    uint64_t nCount = strtoull(sStatus.c_str(), &pEnd, 10);
+    if(!fDone || pEnd == sStatus.c_str())
+    {
+        std::cerr << "Worker of " << Wrk.m_sInName << " failed\n";
+        exit(1);
+    }
+
+    return nCount;
+}
+
+/**
+ * @brief Write primes of the binary file of the worker to the output
+ * @param sName Name of the binary file
+ * @param nCount Number of primes reported by the worker
+ * @return None
+ */
+void ShardCoordinator::stitch(const std::string &sName, uint64_t nCount)
+{
+    std::ifstream In(sName, std::ios::in | std::ios::binary);
+    std::vector <uint64_t> PrimesVc;
+
+    if(!In || !PrimesBinaryOutput::readHeader(In))
+    {
+        std::cerr << "Wrong file of primes: " << sName << '\n';
+        exit(1);
+    }
+
+    for(uint64_t n = 0; n < nCount; n += PrimesVc.size())
+    {
+        PrimesVc.resize(nCount - n < m_nStitchChunk ? nCount - n : m_nStitchChunk);
+        if(!In.read(reinterpret_cast <char*> (PrimesVc.data()), PrimesVc.size() * sizeof(uint64_t)))
+        {
+            std::cerr << "Wrong file of primes: " << sName << '\n';
+            exit(1);
+        }
+        m_pOutput->write(PrimesVc);
+    }
+
+    m_nPrimesNum += nCount;
+}
+
+/**
+ * @brief Set the output of stitched primes
+ * @param pOutput Output (it is deleted by the coordinator)
+ * @return None
+ */
+void ShardCoordinator::setOutput(PrimesOutput *pOutput)
+{
+    if(m_pOutput)
+    {
+        delete m_pOutput;
+    }
+
+    m_pOutput = pOutput;
+}
+
+/**
+ * @brief Start workers of all shards, then stitch their primes in the order of shards. Next workers go on while the
+ *        previous shard is stitched. Files of shards are removed
+ * @param None
+ * @return None
+ */
+void ShardCoordinator::output()
+{
+    Profiler::ScopedTimer Timer("shards");
+    std::vector <Worker> WorkersVc(m_ShardsVc.size());
+
+    for(size_t k = 0, p = m_ShardsVc.size(); k < p; ++k)
+    {
+        WorkersVc[k].m_sInName = m_sPrefix + ".shard" + std::to_string(k) + ".xml";
+        WorkersVc[k].m_sOutName = m_sPrefix + ".shard" + std::to_string(k) + ".bin";
+        writeShard(m_ShardsVc[k], WorkersVc[k].m_sInName);
+        launch(WorkersVc[k]);
+    }
+
+    m_nPrimesNum = 0;
+    m_pOutput->begin();
+    for(Worker &Wrk : WorkersVc)
+    {
+        stitch(Wrk.m_sOutName, collect(Wrk));
+        std::remove(Wrk.m_sInName.c_str());
+        std::remove(Wrk.m_sOutName.c_str());
+    }
+    m_pOutput->end();
+
+    Profiler::get().addCounter("shards", m_ShardsVc.size());
+}
+
+/**
+ * @brief Intervals of every shard
+ * @param None
+ * @return Container of shards
+ */
+const std::vector <std::vector <Interval> > &ShardCoordinator::getShards() const
+{
+    return m_ShardsVc;
+}
+
+/**
+ * @brief Number of primes written by the last output
+ * @param None
+ * @return Number of primes
+ */
+uint64_t ShardCoordinator::getPrimesNum() const
+{
+    return m_nPrimesNum;
+}
+
+/**
+ * @brief Work of the worker process: search primes of intervals of the xml file in the pipelined mode and write them
+ *        to the binary file. The worker keeps checkpoints next to the binary file, so the shard of the killed worker
+ *        is resumed by the next run
+ * @param pInName Xml file of the shard
+ * @param pOutName Binary file of primes
+ * @param Settings Settings of the sieve (the progression is taken from the file)
+ * @return Number of primes written
+ */
+uint64_t ShardCoordinator::runWorker(const char *pInName, const char *pOutName, const SieveSettings &Settings)
+{
+    std::vector <Interval> IntVc;
+    SieveSettings WorkerSettings(Settings);
+
+    ReadXml xml(pInName, { "root" });
+    xml.setOutput(new IntervalsOutput(&IntVc));
+    xml.output();
+    xml.setOutput(new ProgressionOutput(&WorkerSettings.m_Progression));
+    xml.output();
+
+    WorkerSettings.m_fPipelined = true;                                     // Primes go to the file, they are not kept
+    FindPrimes Primes(&IntVc, WorkerSettings);
+    PrimesBinaryOutput *pOutput = new PrimesBinaryOutput(pOutName);
+
+    Primes.setCheckpoint((std::string(pOutName) + ".ckpt").c_str());
+    Primes.setOutput(pOutput);
+    Primes.output();
+
+    return pOutput->getEmitted();
+}
+
+//*****************************************************************************************
@@ -0,0 +1,70 @@
+/**
+  *************************************************************************************************************************
+  * @file    shardcoordinator.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to search primes by several processes. Merged intervals are split into shards of equal estimated cost,
+  *          every shard is written to its own xml file and searched by the worker process, which writes binary file
+  *          of primes and reports their number through the pipe. Workers are forked, or started by the launcher
+  *          command (e.g. "ssh node /path/PrimesProject") if files are on the shared filesystem. Binary files are
+  *          stitched in the order of shards into the output
+  **************************************************************************************************************************
+*/
+
+#ifndef SHARDCOORDINATOR_H
+#define SHARDCOORDINATOR_H
+
+#include <vector>
+#include <string>
+
+#include "interval.hpp"
+#include "sievesettings.hpp"
+#include "primesoutput.hpp"
+
+class ShardCoordinator
+{
+public:
+    ShardCoordinator(const std::vector <Interval> *pIntVc, uint32_t nShards, const char *pPrefix,
+                     const SieveSettings &Settings = SieveSettings(), const char *pLauncher = nullptr);
+    ~ShardCoordinator();
+
+    void setOutput(PrimesOutput *pOutput);
+    void output();                                          // Run workers and stitch their primes
+
+    const std::vector <std::vector <Interval> > &getShards() const;
+    uint64_t getPrimesNum() const;                          // Number of primes of the last output
+
+    static uint64_t runWorker(const char *pInName, const char *pOutName, const SieveSettings &Settings = SieveSettings());
+
+private:
+    static constexpr size_t m_nStitchChunk = 1 << 20;       // Number of primes read from the binary file at once
+
+    struct Worker
+    {
+        int m_nPid;                                         // Process of the worker (0 if it is not started)
+        int m_nPipe;                                        // Read end of the pipe with the status (-1 if it is closed)
+        std::string m_sInName;                              // Intervals of the shard
+        std::string m_sOutName;                             // Binary primes of the shard
+    };
+
+    const std::vector <Interval> *m_pIntVc;                 // Sorted merged intervals
+    uint32_t m_nShards;                                     // Number of shards requested
+    std::string m_sPrefix;                                  // Path and beginning of names of files of shards
+    SieveSettings m_Settings;                               // Settings of workers
+    const char *m_pLauncher;                                // Command to start the worker (nullptr - fork)
+    std::vector <std::vector <Interval> > m_ShardsVc;       // Intervals of every shard
+    PrimesOutput *m_pOutput;
+    uint64_t m_nPrimesNum;
+
+    void makeShards();                                      // Split intervals by their cost
+    void writeShard(const std::vector <Interval> &IntVc, const std::string &sName) const;
+    void launch(Worker &Wrk) const;
+    uint64_t collect(Worker &Wrk) const;                    // Wait for the worker, returns number of its primes
+    void stitch(const std::string &sName, uint64_t nCount);
+    static std::string quote(const std::string &sArg);      // Argument of the shell command
+};
+
+#endif // SHARDCOORDINATOR_H
+
+//*****************************************************************************************
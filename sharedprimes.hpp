@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    sharedprimes.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Layout of the result of the sieve in POSIX shared memory. The
+  *          control segment <name> has the number of the current generation,
+  *          the data segment <name>.<generation> has the header, spokes,
+  *          initial primes of the wheel, blocks, ranks of blocks and rows,
+  *          the select directory, primes of the direct test and bits of primes (1 - prime) row by
+  *          row: the row r is spokes words r * spokes...r * spokes + spokes - 1.
+  *          Bits out of intervals are cleared. Arrays are aligned to 64 bytes
+  ******************************************************************************
+*/
+
+#ifndef SHAREDPRIMES_HPP
+#define SHAREDPRIMES_HPP
+
+#include <atomic>
+#include <stdint.h>
+
+struct SharedPrimesControl
+{
+    static constexpr uint32_t m_nCurrentVersion = 1;
+
+    char m_cMagic[8];                                           // "PRMCTRL\0"
+    uint32_t m_nVersion;                                        // Version of the layout of the writer
+    uint32_t m_nReserved;
+    std::atomic <uint64_t> m_nGeneration;                       // Current data segment (0 - none yet)
+};
+
+struct SharedPrimesHeader
+{
+    static constexpr uint32_t m_nCurrentVersion = 2;
+    static constexpr uint32_t m_nAlign = 64;                    // Alignment of arrays
+
+    char m_cMagic[8];                                           // "PRMSHARE"
+    uint32_t m_nVersion;                                        // Version of the layout of the writer
+    uint32_t m_nHeaderSize;                                     // sizeof(SharedPrimesHeader) of the writer
+    uint64_t m_nGeneration;                                     // Generation of the segment
+    uint64_t m_nSize;                                           // Bytes of the segment
+    uint32_t m_nPrimor;                                         // Primorial of Wheel Factorisation
+    uint32_t m_nSpokes;                                         // Number of spokes
+    uint64_t m_nCount;                                          // Number of primes
+    uint64_t m_nWheelPrimes;                                    // Initial primes of the wheel in intervals
+    uint64_t m_nBlocks;                                         // Blocks of intervals
+    uint64_t m_nRows;                                           // Ranks of rows of sieved blocks
+    uint64_t m_nWordRows;                                       // Rows of words of bits
+    uint64_t m_nSelectSample;                                   // Primes between samples of the select directory
+    uint64_t m_nSelects;                                        // Samples of the select directory
+    uint64_t m_nDirect;                                         // Primes of the direct test
+
+    uint64_t m_nSpokesOffset;                                   // uint32_t [m_nSpokes], ascending
+    uint64_t m_nWheelOffset;                                    // uint64_t [m_nWheelPrimes]
+    uint64_t m_nBlocksOffset;                                   // SharedBlock [m_nBlocks], ascending
+    uint64_t m_nBlockRankOffset;                                // uint64_t [m_nBlocks + 1], primes before the block (with the wheel primes)
+    uint64_t m_nBlockRowOffset;                                 // uint64_t [m_nBlocks + 1], first row rank of the block
+    uint64_t m_nRowRankOffset;                                  // uint64_t [m_nRows], primes before the row
+    uint64_t m_nSelectOffset;                                   // uint64_t [m_nSelects], rows after the prime i * m_nSelectSample
+    uint64_t m_nDirectOffset;                                   // uint64_t [m_nDirect]
+    uint64_t m_nWordsOffset;                                    // uint64_t [m_nWordRows * m_nSpokes]
+};
+
+struct SharedBlock
+{
+    uint64_t m_nLow;                                            // Interval of the block
+    uint64_t m_nHigh;
+    uint64_t m_nSieved;                                         // 1 - bits, 0 - primes of the direct test
+    uint64_t m_nOrigin;                                         // Index of the first bit of the block
+    uint64_t m_nWordRow;                                        // First row of words of the block
+    uint64_t m_nDirectBegin;                                    // Primes of the direct test are
+    uint64_t m_nDirectEnd;                                      //   m_nDirectBegin...m_nDirectEnd - 1
+};
+
+#endif // SHAREDPRIMES_HPP
+
+//*****************************************************************************************
@@ -0,0 +1,229 @@
+/**
+  *************************************************************************************************************************
+  * @file    sharedprimesexport.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to publish the result of the sieve and its rank index in POSIX shared memory for other processes
+  *          of the computer (see sharedprimes.hpp). Every publication writes the new data segment and then switches
+  *          the generation of the control segment, so readers are never blocked: they go on with the old segment
+  *          until they refresh. The old segment is unlinked, its memory is freed when the last reader unmaps it
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "sharedprimesexport.h"
+#include "profiler.h"
+
+/**
+ * @brief Class SharedPrimesExport constructor
+ * @param pName Name of the control segment, it begins with '/' (data segments are named <name>.<generation>)
+ */
+SharedPrimesExport::SharedPrimesExport(const char *pName): m_sName(pName) {}
+
+/**
+ * @brief Class SharedPrimesExport destructor
+ */
+SharedPrimesExport::~SharedPrimesExport() {}
+
+/**
+ * @brief Offset aligned for the next array
+ * @param nOffset Offset
+ * @return Aligned offset
+ */
+uint64_t SharedPrimesExport::align(uint64_t nOffset)
+{
+    return (nOffset + SharedPrimesHeader::m_nAlign - 1) & ~static_cast <uint64_t> (SharedPrimesHeader::m_nAlign - 1);
+}
+
+/**
+ * @brief Map the control segment, it is created with generation 0 if it doesn't exist
+ * @param None
+ * @return Control segment (the program stops if it can't be mapped)
+ */
+SharedPrimesControl *SharedPrimesExport::openControl() const
+{
+#ifdef __linux__
+    int nFd = shm_open(m_sName.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat Stat;
+
+    if(nFd < 0 || fstat(nFd, &Stat) || (!Stat.st_size && ftruncate(nFd, sizeof(SharedPrimesControl))))
+    {
+        std::cerr << "Shared memory opening error: " << m_sName << '\n';
+        exit(1);
+    }
+
+    void *pMem = mmap(nullptr, sizeof(SharedPrimesControl), PROT_READ | PROT_WRITE, MAP_SHARED, nFd, 0);
+    close(nFd);
+    if(pMem == MAP_FAILED)
+    {
+        std::cerr << "Shared memory opening error: " << m_sName << '\n';
+        exit(1);
+    }
+
+    SharedPrimesControl *pControl = static_cast <SharedPrimesControl*> (pMem);
+    if(memcmp(pControl->m_cMagic, "PRMCTRL", 8))                            // New segment (zeros)
+    {
+        new (&pControl->m_nGeneration) std::atomic <uint64_t> (0);
+        pControl->m_nVersion = SharedPrimesControl::m_nCurrentVersion;
+        pControl->m_nReserved = 0;
+        memcpy(pControl->m_cMagic, "PRMCTRL", 8);
+    }
+    else if(pControl->m_nVersion != SharedPrimesControl::m_nCurrentVersion)
+    {
+        std::cerr << "Shared memory of another version: " << m_sName << '\n';
+        exit(1);
+    }
+
+    return pControl;
+#else
+    std::cerr << "Shared memory isn't supported!\n";
+    exit(1);
+#endif
+}
+
+/**
+ * @brief Write arrays of the data segment. Bits of every row of sieved blocks are taken from the index, so bits out
+ *        of intervals are cleared, and they are placed row by row, so the query reads one piece of memory
+ * @param pMem Data segment
+ * @param Header Header with sizes and offsets
+ * @param pPrimeNumVector Result of the sieve
+ * @param Index Rank index of the result
+ * @return None
+ */
+void SharedPrimesExport::fill(char *pMem, const SharedPrimesHeader &Header, const PrimeNumbersVector *pPrimeNumVector,
+                              const PrimesIndex &Index) const
+{
+    const std::vector <SieveBlock> &BlocksVc = *pPrimeNumVector->m_pBlocksVector;
+    uint32_t *pSpokes = reinterpret_cast <uint32_t*> (pMem + Header.m_nSpokesOffset);
+    uint64_t *pWheel = reinterpret_cast <uint64_t*> (pMem + Header.m_nWheelOffset);
+    SharedBlock *pBlocks = reinterpret_cast <SharedBlock*> (pMem + Header.m_nBlocksOffset);
+    uint64_t *pBlockRank = reinterpret_cast <uint64_t*> (pMem + Header.m_nBlockRankOffset);
+    uint64_t *pBlockRow = reinterpret_cast <uint64_t*> (pMem + Header.m_nBlockRowOffset);
+    uint64_t *pWords = reinterpret_cast <uint64_t*> (pMem + Header.m_nWordsOffset);
+    std::vector <uint64_t> nBitsVc;
+
+    memcpy(pMem, &Header, sizeof(Header));
+    std::copy(pPrimeNumVector->m_pSpokesVector->begin(), pPrimeNumVector->m_pSpokesVector->end(), pSpokes);
+    std::copy(Index.m_nWheelPrimesVc.begin(), Index.m_nWheelPrimesVc.end(), pWheel);
+    std::copy(Index.m_nBlockRankVc.begin(), Index.m_nBlockRankVc.end(), pBlockRank);
+    std::copy(Index.m_nBlockRowVc.begin(), Index.m_nBlockRowVc.end(), pBlockRow);
+    std::copy(Index.m_nRowRankVc.begin(), Index.m_nRowRankVc.end(), reinterpret_cast <uint64_t*> (pMem + Header.m_nRowRankOffset));
+    std::copy(Index.m_nSelectVc.begin(), Index.m_nSelectVc.end(), reinterpret_cast <uint64_t*> (pMem + Header.m_nSelectOffset));
+    std::copy(pPrimeNumVector->m_pDirectVector->begin(), pPrimeNumVector->m_pDirectVector->end(),
+              reinterpret_cast <uint64_t*> (pMem + Header.m_nDirectOffset));
+
+    for(size_t b = 0, p = BlocksVc.size(); b < p; ++b)
+    {
+        const SieveBlock &Block = BlocksVc[b];
+
+        pBlocks[b] = { Block.m_Int.m_nLowIntervalSide, Block.m_Int.m_nHighIntervalSide, Block.m_fSieved ? 1u : 0u,
+                       Block.m_nOrigin, Block.m_nWordOffset, Block.m_nDirectBegin, Block.m_nDirectEnd };
+        if(!Block.m_fSieved)
+        {
+            continue;
+        }
+
+        for(uint64_t r = 0, q = pBlockRow[b + 1] - pBlockRow[b]; r < q; ++r)
+        {
+            Index.getRowBits(Block, r, nBitsVc);
+            std::copy(nBitsVc.begin(), nBitsVc.end(), pWords + (Block.m_nWordOffset + r) * Header.m_nSpokes);
+        }
+    }
+}
+
+/**
+ * @brief Publish the result: the data segment of the next generation is created and filled, then the generation of
+ *        the control segment is switched and the previous data segment is unlinked. Only one process may publish
+ *        under the name at once
+ * @param pPrimeNumVector Result of the sieve of the usual mode
+ * @param Index Rank index of the result
+ * @return Generation of the published segment
+ */
+uint64_t SharedPrimesExport::publish(const PrimeNumbersVector *pPrimeNumVector, const PrimesIndex &Index)
+{
+    Profiler::ScopedTimer Timer("shared_export");
+    SharedPrimesHeader Header;
+    const VectorSieveWords &SieveVc = *pPrimeNumVector->m_pSieveVector;
+
+    memset(&Header, 0, sizeof(Header));
+    memcpy(Header.m_cMagic, "PRMSHARE", 8);
+    Header.m_nVersion = SharedPrimesHeader::m_nCurrentVersion;
+    Header.m_nHeaderSize = sizeof(SharedPrimesHeader);
+    Header.m_nPrimor = pPrimeNumVector->m_nPrimor;
+    Header.m_nSpokes = pPrimeNumVector->m_nNumOfSpokes;
+    Header.m_nCount = Index.count();
+    Header.m_nWheelPrimes = Index.m_nWheelPrimesVc.size();
+    Header.m_nBlocks = pPrimeNumVector->m_pBlocksVector->size();
+    Header.m_nRows = Index.m_nRowRankVc.size();
+    Header.m_nWordRows = (SieveVc.empty() ? 0 : SieveVc[0].size());
+    Header.m_nSelectSample = PrimesIndex::m_nSelectSample;
+    Header.m_nSelects = Index.m_nSelectVc.size();
+    Header.m_nDirect = pPrimeNumVector->m_pDirectVector->size();
+
+    Header.m_nSpokesOffset = align(sizeof(SharedPrimesHeader));
+    Header.m_nWheelOffset = align(Header.m_nSpokesOffset + Header.m_nSpokes * sizeof(uint32_t));
+    Header.m_nBlocksOffset = align(Header.m_nWheelOffset + Header.m_nWheelPrimes * sizeof(uint64_t));
+    Header.m_nBlockRankOffset = align(Header.m_nBlocksOffset + Header.m_nBlocks * sizeof(SharedBlock));
+    Header.m_nBlockRowOffset = align(Header.m_nBlockRankOffset + (Header.m_nBlocks + 1) * sizeof(uint64_t));
+    Header.m_nRowRankOffset = align(Header.m_nBlockRowOffset + (Header.m_nBlocks + 1) * sizeof(uint64_t));
+    Header.m_nSelectOffset = align(Header.m_nRowRankOffset + Header.m_nRows * sizeof(uint64_t));
+    Header.m_nDirectOffset = align(Header.m_nSelectOffset + Header.m_nSelects * sizeof(uint64_t));
+    Header.m_nWordsOffset = align(Header.m_nDirectOffset + Header.m_nDirect * sizeof(uint64_t));
+    Header.m_nSize = Header.m_nWordsOffset + Header.m_nWordRows * Header.m_nSpokes * sizeof(uint64_t);
+
+#ifdef __linux__
+    SharedPrimesControl *pControl = openControl();
+    uint64_t nGeneration = pControl->m_nGeneration.load(std::memory_order_acquire) + 1;
+    std::string sData = m_sName + '.' + std::to_string(nGeneration);
+
+    Header.m_nGeneration = nGeneration;
+    shm_unlink(sData.c_str());                                              // Left by the publisher which has failed
+
+    int nFd = shm_open(sData.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if(nFd < 0 || ftruncate(nFd, Header.m_nSize))
+    {
+        std::cerr << "Shared memory creating error: " << sData << '\n';
+        exit(1);
+    }
+
+    void *pMem = mmap(nullptr, Header.m_nSize, PROT_READ | PROT_WRITE, MAP_SHARED, nFd, 0);
+    close(nFd);
+    if(pMem == MAP_FAILED)
+    {
+        std::cerr << "Shared memory creating error: " << sData << '\n';
+        shm_unlink(sData.c_str());
+        exit(1);
+    }
+
+    fill(static_cast <char*> (pMem), Header, pPrimeNumVector, Index);
+    munmap(pMem, Header.m_nSize);
+
+    pControl->m_nGeneration.store(nGeneration, std::memory_order_release);   // Readers see the whole segment
+    if(nGeneration > 1)
+    {
+        shm_unlink((m_sName + '.' + std::to_string(nGeneration - 1)).c_str());
+    }
+    munmap(pControl, sizeof(SharedPrimesControl));
+
+    Profiler::get().addCounter("shared_bytes", Header.m_nSize);
+    return nGeneration;
+#else
+    (void)Index;
+    openControl();
+    return 0;
+#endif
+}
+
+//*****************************************************************************************
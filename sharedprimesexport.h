@@ -0,0 +1,42 @@
+/**
+  *************************************************************************************************************************
+  * @file    sharedprimesexport.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to publish the result of the sieve and its rank index in POSIX shared memory for other processes
+  *          of the computer (see sharedprimes.hpp). Every publication writes the new data segment and then switches
+  *          the generation of the control segment, so readers are never blocked: they go on with the old segment
+  *          until they refresh. The old segment is unlinked, its memory is freed when the last reader unmaps it
+  **************************************************************************************************************************
+*/
+
+#ifndef SHAREDPRIMESEXPORT_H
+#define SHAREDPRIMESEXPORT_H
+
+#include <string>
+
+#include "primenumbersvector.h"
+#include "primesindex.h"
+#include "sharedprimes.hpp"
+
+class SharedPrimesExport
+{
+public:
+    SharedPrimesExport(const char *pName);
+    ~SharedPrimesExport();
+
+    uint64_t publish(const PrimeNumbersVector *pPrimeNumVector, const PrimesIndex &Index);  // Returns the new generation
+
+private:
+    std::string m_sName;                                    // Name of the control segment (e.g. "/primes")
+
+    static uint64_t align(uint64_t nOffset);
+    SharedPrimesControl *openControl() const;               // Create the control segment if there is no one
+    void fill(char *pMem, const SharedPrimesHeader &Header, const PrimeNumbersVector *pPrimeNumVector,
+              const PrimesIndex &Index) const;
+};
+
+#endif // SHAREDPRIMESEXPORT_H
+
+//*****************************************************************************************
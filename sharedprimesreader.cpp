@@ -0,0 +1,357 @@
+/**
+  *************************************************************************************************************************
+  * @file    sharedprimesreader.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to query the result of the sieve published in POSIX shared memory by SharedPrimesExport. The data
+  *          segment of the current generation is mapped read-only and queries read it in place: the number of
+  *          primes, the test of the number, rank, the n-th prime and the next prime. refresh() maps the newer
+  *          generation if it has been published, the reader is never blocked by the publisher
+  **************************************************************************************************************************
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "sharedprimesreader.h"
+#include "primenumbersvector.h"
+#include "primesrow.hpp"
+
+/**
+ * @brief Class SharedPrimesReader constructor. The current generation is mapped if it has been published
+ * @param pName Name of the control segment given to SharedPrimesExport
+ */
+SharedPrimesReader::SharedPrimesReader(const char *pName): m_sName(pName), m_pControl(nullptr), m_pMem(nullptr),
+    m_nMapSize(0), m_pHeader(nullptr), m_pSpokes(nullptr), m_pWheel(nullptr), m_pBlocks(nullptr), m_pBlockRank(nullptr),
+    m_pBlockRow(nullptr), m_pRowRank(nullptr), m_pSelect(nullptr), m_pDirect(nullptr), m_pWords(nullptr)
+{
+    refresh();
+}
+
+/**
+ * @brief Class SharedPrimesReader destructor
+ */
+SharedPrimesReader::~SharedPrimesReader()
+{
+    unmap();
+
+#ifdef __linux__
+    if(m_pControl)
+    {
+        munmap(const_cast <SharedPrimesControl*> (m_pControl), sizeof(SharedPrimesControl));
+    }
+#endif
+}
+
+/**
+ * @brief Map the current generation if it isn't mapped yet. The publisher may switch the generation and unlink the
+ *        segment between reading of the generation and its opening, then the next generation is tried
+ * @param None
+ * @return true if some generation is mapped
+ */
+bool SharedPrimesReader::refresh()
+{
+#ifdef __linux__
+    if(!m_pControl)
+    {
+        int nFd = shm_open(m_sName.c_str(), O_RDONLY, 0);
+        struct stat Stat;
+
+        if(nFd < 0)
+        {
+            return false;
+        }
+
+        if(!fstat(nFd, &Stat) && Stat.st_size >= static_cast <off_t> (sizeof(SharedPrimesControl)))
+        {
+            void *pMem = mmap(nullptr, sizeof(SharedPrimesControl), PROT_READ, MAP_SHARED, nFd, 0);
+            m_pControl = (pMem == MAP_FAILED ? nullptr : static_cast <const SharedPrimesControl*> (pMem));
+        }
+        close(nFd);
+
+        if(m_pControl && (memcmp(m_pControl->m_cMagic, "PRMCTRL", 8) ||
+                          m_pControl->m_nVersion != SharedPrimesControl::m_nCurrentVersion))
+        {
+            munmap(const_cast <SharedPrimesControl*> (m_pControl), sizeof(SharedPrimesControl));
+            m_pControl = nullptr;
+        }
+
+        if(!m_pControl)
+        {
+            return false;
+        }
+    }
+
+    for(uint32_t i = 0; i < m_nAttempts; ++i)
+    {
+        uint64_t nGeneration = m_pControl->m_nGeneration.load(std::memory_order_acquire);
+
+        if(!nGeneration || (m_pHeader && m_pHeader->m_nGeneration == nGeneration) || map(nGeneration))
+        {
+            break;
+        }
+    }
+#endif
+
+    return m_pHeader != nullptr;
+}
+
+/**
+ * @brief Map the data segment of the generation read-only and check its header. The previous segment is unmapped
+ *        only if the new one is right
+ * @param nGeneration Generation
+ * @return true if the segment is mapped
+ */
+bool SharedPrimesReader::map(uint64_t nGeneration)
+{
+#ifdef __linux__
+    std::string sData = m_sName + '.' + std::to_string(nGeneration);
+    int nFd = shm_open(sData.c_str(), O_RDONLY, 0);
+    struct stat Stat;
+
+    if(nFd < 0)
+    {
+        return false;
+    }
+
+    void *pMem = MAP_FAILED;
+    if(!fstat(nFd, &Stat) && Stat.st_size >= static_cast <off_t> (sizeof(SharedPrimesHeader)))
+    {
+        pMem = mmap(nullptr, Stat.st_size, PROT_READ, MAP_SHARED, nFd, 0);
+    }
+    close(nFd);
+
+    if(pMem == MAP_FAILED)
+    {
+        return false;
+    }
+
+    const char *pBytes = static_cast <const char*> (pMem);
+    const SharedPrimesHeader *pHeader = reinterpret_cast <const SharedPrimesHeader*> (pBytes);
+    if(memcmp(pHeader->m_cMagic, "PRMSHARE", 8) || pHeader->m_nVersion != SharedPrimesHeader::m_nCurrentVersion ||
+       pHeader->m_nHeaderSize != sizeof(SharedPrimesHeader) || pHeader->m_nGeneration != nGeneration ||
+       pHeader->m_nSize > static_cast <uint64_t> (Stat.st_size) || !pHeader->m_nSelectSample)
+    {
+        munmap(pMem, Stat.st_size);
+        return false;
+    }
+
+    unmap();
+    m_pMem = pBytes;
+    m_nMapSize = Stat.st_size;
+    m_pHeader = pHeader;
+    m_pSpokes = reinterpret_cast <const uint32_t*> (pBytes + pHeader->m_nSpokesOffset);
+    m_pWheel = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nWheelOffset);
+    m_pBlocks = reinterpret_cast <const SharedBlock*> (pBytes + pHeader->m_nBlocksOffset);
+    m_pBlockRank = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nBlockRankOffset);
+    m_pBlockRow = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nBlockRowOffset);
+    m_pRowRank = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nRowRankOffset);
+    m_pSelect = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nSelectOffset);
+    m_pDirect = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nDirectOffset);
+    m_pWords = reinterpret_cast <const uint64_t*> (pBytes + pHeader->m_nWordsOffset);
+    return true;
+#else
+    (void)nGeneration;
+    return false;
+#endif
+}
+
+/**
+ * @brief Unmap the data segment
+ * @param None
+ * @return None
+ */
+void SharedPrimesReader::unmap()
+{
+#ifdef __linux__
+    if(m_pMem)
+    {
+        munmap(const_cast <char*> (m_pMem), m_nMapSize);
+    }
+#endif
+
+    m_pMem = nullptr;
+    m_nMapSize = 0;
+    m_pHeader = nullptr;
+}
+
+/**
+ * @brief Returns generation of the mapped segment
+ * @param None
+ * @return Generation (0 if nothing is mapped)
+ */
+uint64_t SharedPrimesReader::getGeneration() const
+{
+    return (m_pHeader ? m_pHeader->m_nGeneration : 0);
+}
+
+/**
+ * @brief Returns number of primes in all intervals
+ * @param None
+ * @return Number of primes
+ */
+uint64_t SharedPrimesReader::count() const
+{
+    return (m_pHeader ? m_pHeader->m_nCount : 0);
+}
+
+/**
+ * @brief Find the block of the number
+ * @param nVal Number
+ * @return Last block with low side not greater than the number (m_nBlocks if there is not such block)
+ */
+size_t SharedPrimesReader::findBlock(uint64_t nVal) const
+{
+    const SharedBlock *pEnd = m_pBlocks + m_pHeader->m_nBlocks;
+    const SharedBlock *pBlock = std::upper_bound(m_pBlocks, pEnd, nVal, [] (uint64_t nNum, const SharedBlock &Block)
+    {
+        return nNum < Block.m_nLow;
+    });
+
+    return (pBlock == m_pBlocks ? m_pHeader->m_nBlocks : pBlock - m_pBlocks - 1);
+}
+
+/**
+ * @brief Check the number: initial primes of the wheel, primes of the direct test or the bit of its spoke
+ * @param nVal Number
+ * @return true if the number is prime and belongs to intervals
+ */
+bool SharedPrimesReader::isPrime(uint64_t nVal) const
+{
+    if(!m_pHeader)
+    {
+        return false;
+    }
+
+    if(std::binary_search(m_pWheel, m_pWheel + m_pHeader->m_nWheelPrimes, nVal))
+    {
+        return true;
+    }
+
+    size_t nBlock = findBlock(nVal);
+    if(nBlock == m_pHeader->m_nBlocks || nVal > m_pBlocks[nBlock].m_nHigh)
+    {
+        return false;
+    }
+
+    const SharedBlock &Block = m_pBlocks[nBlock];
+    if(!Block.m_nSieved)
+    {
+        return std::binary_search(m_pDirect + Block.m_nDirectBegin, m_pDirect + Block.m_nDirectEnd, nVal);
+    }
+
+    uint32_t nRest = nVal % m_pHeader->m_nPrimor;
+    const uint32_t *pSpoke = std::lower_bound(m_pSpokes, m_pSpokes + m_pHeader->m_nSpokes, nRest);
+    if(pSpoke == m_pSpokes + m_pHeader->m_nSpokes || *pSpoke != nRest)
+    {
+        return false;                                                       // Multiple of the wheel prime
+    }
+
+    uint64_t nBit = nVal / m_pHeader->m_nPrimor - Block.m_nOrigin;
+    return (m_pWords[(Block.m_nWordRow + (nBit >> 6)) * m_pHeader->m_nSpokes + (pSpoke - m_pSpokes)] >> (nBit & 63)) & 1;
+}
+
+/**
+ * @brief Returns number of primes not greater than the number: ranks of the block and of the row, and popcounts
+ *        of the row up to the index of the number
+ * @param nVal Number
+ * @return Number of primes
+ */
+uint64_t SharedPrimesReader::rank(uint64_t nVal) const
+{
+    if(!m_pHeader)
+    {
+        return 0;
+    }
+
+    uint64_t nWheelPrimes = m_pHeader->m_nWheelPrimes;                      // Ranks of blocks count all of them
+    uint64_t nRank = std::upper_bound(m_pWheel, m_pWheel + nWheelPrimes, nVal) - m_pWheel;
+    size_t nBlock = findBlock(nVal);
+
+    if(nBlock == m_pHeader->m_nBlocks)
+    {
+        return nRank;
+    }
+
+    const SharedBlock &Block = m_pBlocks[nBlock];
+    if(nVal > Block.m_nHigh)
+    {
+        return nRank + m_pBlockRank[nBlock + 1] - nWheelPrimes;
+    }
+
+    if(!Block.m_nSieved)
+    {
+        return nRank + m_pBlockRank[nBlock] - nWheelPrimes +
+               (std::upper_bound(m_pDirect + Block.m_nDirectBegin, m_pDirect + Block.m_nDirectEnd, nVal) -
+                (m_pDirect + Block.m_nDirectBegin));
+    }
+
+    uint32_t nPrimor = m_pHeader->m_nPrimor;
+    uint64_t nBit = nVal / nPrimor - Block.m_nOrigin;
+    const uint64_t *pRow = m_pWords + (Block.m_nWordRow + (nBit >> 6)) * m_pHeader->m_nSpokes;
+
+    return nRank + m_pRowRank[m_pBlockRow[nBlock] + (nBit >> 6)] - nWheelPrimes +
+           PrimesRow::rank(pRow, m_pSpokes, m_pHeader->m_nSpokes, nBit & 63, nVal % nPrimor);
+}
+
+/**
+ * @brief Returns the prime number nNum in ascending order. The block is found by ranks of blocks, the row by ranks of
+ *        rows between samples of the select directory, the index in the row by PrimesRow
+ * @param nNum Number of the prime (from 0)
+ * @return The prime
+ * @exceptions OutOfRange if !(nNum < count()).
+ */
+uint64_t SharedPrimesReader::nthPrime(uint64_t nNum) const
+{
+    if(nNum >= count())
+    {
+        throw OutOfRange();
+    }
+
+    if(nNum < m_pHeader->m_nWheelPrimes)
+    {
+        return m_pWheel[nNum];
+    }
+
+    size_t nBlock = std::upper_bound(m_pBlockRank, m_pBlockRank + m_pHeader->m_nBlocks + 1, nNum) - m_pBlockRank - 1;
+    const SharedBlock &Block = m_pBlocks[nBlock];
+
+    if(!Block.m_nSieved)
+    {
+        return m_pDirect[Block.m_nDirectBegin + (nNum - m_pBlockRank[nBlock])];
+    }
+
+    uint64_t nSample = nNum / m_pHeader->m_nSelectSample;
+    size_t nLowRow = std::max(m_pBlockRow[nBlock], m_pSelect[nSample]);
+    size_t nHighRow = std::min(m_pBlockRow[nBlock + 1], m_pSelect[nSample + 1]);
+    size_t nRow = std::upper_bound(m_pRowRank + nLowRow, m_pRowRank + nHighRow, nNum) - m_pRowRank - 1;
+    const uint64_t *pRow = m_pWords + (Block.m_nWordRow + nRow - m_pBlockRow[nBlock]) * m_pHeader->m_nSpokes;
+    uint32_t nBit, nSpoke;
+
+    PrimesRow::select(pRow, m_pHeader->m_nSpokes, nNum - m_pRowRank[nRow], nBit, nSpoke);
+
+    uint64_t nIndex = Block.m_nOrigin + 64 * (nRow - m_pBlockRow[nBlock]) + nBit;
+    return nIndex * m_pHeader->m_nPrimor + m_pSpokes[nSpoke];
+}
+
+/**
+ * @brief Returns the least prime greater than the number
+ * @param nVal Number
+ * @return The prime (0 if there is not such prime in intervals)
+ */
+uint64_t SharedPrimesReader::nextPrime(uint64_t nVal) const
+{
+    uint64_t nRank = rank(nVal);
+
+    return (nRank < count() ? nthPrime(nRank) : 0);
+}
+
+//*****************************************************************************************
@@ -0,0 +1,62 @@
+/**
+  *************************************************************************************************************************
+  * @file    sharedprimesreader.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to query the result of the sieve published in POSIX shared memory by SharedPrimesExport. The data
+  *          segment of the current generation is mapped read-only and queries read it in place: the number of
+  *          primes, the test of the number, rank, the n-th prime and the next prime. refresh() maps the newer
+  *          generation if it has been published, the reader is never blocked by the publisher
+  **************************************************************************************************************************
+*/
+
+#ifndef SHAREDPRIMESREADER_H
+#define SHAREDPRIMESREADER_H
+
+#include <string>
+#include <cstddef>
+
+#include "sharedprimes.hpp"
+
+class SharedPrimesReader
+{
+public:
+    SharedPrimesReader(const char *pName);
+    ~SharedPrimesReader();
+
+    bool refresh();                                         // Map the current generation, false if nothing is published
+    uint64_t getGeneration() const;                         // Generation mapped (0 - none)
+
+    uint64_t count() const;                                 // Number of primes in all intervals
+    bool isPrime(uint64_t nVal) const;                      // nVal is prime and belongs to intervals
+    uint64_t rank(uint64_t nVal) const;                     // Number of primes not greater than nVal
+    uint64_t nthPrime(uint64_t nNum) const;                 // Prime number nNum (from 0) in ascending order
+    uint64_t nextPrime(uint64_t nVal) const;                // The least prime greater than nVal (0 if there is not)
+
+private:
+    static constexpr uint32_t m_nAttempts = 8;              // Attempts to map when the generation is switched meanwhile
+
+    std::string m_sName;                                    // Name of the control segment
+    const SharedPrimesControl *m_pControl;
+    const char *m_pMem;                                     // Data segment
+    size_t m_nMapSize;                                      // Bytes mapped (the size of the segment when it was mapped)
+    const SharedPrimesHeader *m_pHeader;
+    const uint32_t *m_pSpokes;
+    const uint64_t *m_pWheel;
+    const SharedBlock *m_pBlocks;
+    const uint64_t *m_pBlockRank;
+    const uint64_t *m_pBlockRow;
+    const uint64_t *m_pRowRank;
+    const uint64_t *m_pSelect;
+    const uint64_t *m_pDirect;
+    const uint64_t *m_pWords;
+
+    bool map(uint64_t nGeneration);                         // Map the data segment of the generation
+    void unmap();
+    size_t findBlock(uint64_t nVal) const;                  // Last block with low side not greater than nVal (m_nBlocks - none)
+};
+
+#endif // SHAREDPRIMESREADER_H
+
+//*****************************************************************************************
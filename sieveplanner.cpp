@@ -0,0 +1,92 @@
+/**
+  *************************************************************************************************************************
+  * @file    sieveplanner.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to choose for every interval between the segmented sieve and the direct Miller-Rabin test of the
+  *          numbers which survive the wheel. The sieve needs all initial primes up to square root of the interval's
+  *          high side, so narrow intervals at high magnitude are tested directly. Every interval has its own block of
+  *          bits, so the choice is made for every interval separately
+  **************************************************************************************************************************
+*/
+
+#include <cmath>
+
+#include "sieveplanner.h"
+
+/**
+ * @brief Class SievePlanner constructor
+ * @param pIntVc Sorted merged intervals
+ */
+SievePlanner::SievePlanner(const std::vector <Interval> *pIntVc): m_pIntVc(pIntVc) {}
+
+/**
+ * @brief Class SievePlanner destructor
+ */
+SievePlanner::~SievePlanner() {}
+
+/**
+ * @brief Estimated cost of the sieve for the interval: initial primes up to square root of the high side (if they are
+ *        not found for a higher sieved interval yet), start of every initial prime in the interval, and crossing off
+ * @param Int Interval
+ * @param fPrimesReady Initial primes are found for a higher sieved interval
+ * @return Cost in the bit operations
+ */
+double SievePlanner::sieveCost(const Interval &Int, bool fPrimesReady) const
+{
+    double fWidth = static_cast <double> (Int.m_nHighIntervalSide - Int.m_nLowIntervalSide) + 1;
+    double fRoot = std::sqrt(static_cast <double> (Int.m_nHighIntervalSide)) + 2;
+    double fLogLog = std::log(std::log(fRoot + 16));
+
+    return (fPrimesReady ? 0 : fRoot / 2) + fRoot / std::log(fRoot) * m_fInitWeight + fWidth * m_fWheelRatio * fLogLog;
+}
+
+/**
+ * @brief Estimated cost of the direct test for the interval: about log2(n) modular squarings for every number
+ *        which survives the wheel (most composites fail the first base)
+ * @param Int Interval
+ * @return Cost in the bit operations
+ */
+double SievePlanner::directCost(const Interval &Int) const
+{
+    double fWidth = static_cast <double> (Int.m_nHighIntervalSide - Int.m_nLowIntervalSide) + 1;
+
+    return fWidth * m_fWheelRatio * std::log2(static_cast <double> (Int.m_nHighIntervalSide) + 2) * m_fTestWeight;
+}
+
+/**
+ * @brief Choose the method for every interval. Intervals are checked from the highest one: initial primes of the highest
+ *        sieved interval serve all lower intervals, so their cost is taken into account only once
+ * @param fSieveVc Container to write flags in: true if the interval is sieved, false if it is tested directly
+ * @return None
+ */
+void SievePlanner::plan(std::vector <bool> &fSieveVc) const
+{
+    bool fPrimesReady(false);
+
+    fSieveVc.assign(m_pIntVc->size(), false);
+    for(size_t i = m_pIntVc->size(); i--; )
+    {
+        if(sieveCost((*m_pIntVc)[i], fPrimesReady) <= directCost((*m_pIntVc)[i]))
+        {
+            fSieveVc[i] = true;
+            fPrimesReady = true;
+        }
+    }
+}
+
+/**
+ * @brief Estimated cost of the interval searched alone (initial primes are found for it) by the cheaper method.
+ *        It is used to split intervals into shards of equal work
+ * @param Int Interval
+ * @return Cost in the bit operations
+ */
+double SievePlanner::estimateCost(const Interval &Int) const
+{
+    double fSieve = sieveCost(Int, false), fDirect = directCost(Int);
+
+    return (fSieve < fDirect ? fSieve : fDirect);
+}
+
+//*****************************************************************************************
@@ -0,0 +1,43 @@
+/**
+  *************************************************************************************************************************
+  * @file    sieveplanner.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to choose for every interval between the segmented sieve and the direct Miller-Rabin test of the
+  *          numbers which survive the wheel. The sieve needs all initial primes up to square root of the interval's
+  *          high side, so narrow intervals at high magnitude are tested directly. Every interval has its own block of
+  *          bits, so the choice is made for every interval separately
+  **************************************************************************************************************************
+*/
+
+#ifndef SIEVEPLANNER_H
+#define SIEVEPLANNER_H
+
+#include <vector>
+
+#include "interval.hpp"
+
+class SievePlanner
+{
+public:
+    SievePlanner(const std::vector <Interval> *pIntVc);
+    ~SievePlanner();
+
+    void plan(std::vector <bool> &fSieveVc) const;
+    double estimateCost(const Interval &Int) const;         // Cost of the cheaper method with its own initial primes
+
+private:
+    static constexpr double m_fWheelRatio = 0.25;           // Part of numbers which survive the wheel
+    static constexpr double m_fTestWeight = 4.0;            // Cost of the modular squaring relative to crossing off the bit
+    static constexpr double m_fInitWeight = 300.0;          // Cost of the initial prime's start in all spokes of the interval
+
+    const std::vector <Interval> *m_pIntVc;                 // Sorted merged intervals
+
+    double sieveCost(const Interval &Int, bool fPrimesReady) const;
+    double directCost(const Interval &Int) const;
+};
+
+#endif // SIEVEPLANNER_H
+
+//*****************************************************************************************
@@ -0,0 +1,48 @@
+/**
+  ******************************************************************************
+  * @file    sievesettings.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Parameters of the sieve given to FindPrimes: number of threads,
+  *          number of primes of Wheel Factorisation and size of the segment.
+  *          Zero means the value is chosen by FindPrimes from the intervals.
+  *          In the pipelined mode intervals are sieved by chunks in output(),
+  *          chunks are written in order while the next ones are sieved.
+  *          PrimeGenerator uses this mode to sieve chunks on demand.
+  *          The progression restricts primes to one residue class.
+  *          The memory budget makes FindPrimes choose the pipelined mode,
+  *          smaller chunks and fewer threads to stay within it
+  ******************************************************************************
+*/
+
+#ifndef SIEVESETTINGS_HPP
+#define SIEVESETTINGS_HPP
+
+#include <stdint.h>
+
+#include "progression.hpp"
+
+struct SieveSettings
+{
+    static constexpr uint32_t m_nDefaultSegmentSize = 1 << 18;  // 32 KB of bits, fits L1/L2 cache
+    static constexpr uint32_t m_nMinSegmentSize = 1 << 8;
+    static constexpr uint32_t m_nMaxSegmentSize = 1 << 26;
+    static constexpr uint32_t m_nMaxWheelPrimes = 6;            // Primorial 30030, 5760 spokes
+
+    uint32_t m_nThreads;                                        // Number of sieving threads
+    uint32_t m_nWheelPrimes;                                    // Number of initial primes of Wheel Factorisation
+    uint32_t m_nSegmentSize;                                    // Number of bits of the spoke sieved at once
+    bool m_fPipelined;                                          // Sieve while writing, don't keep the whole result
+    Progression m_Progression;                                  // Residue class of primes (all numbers by default)
+    uint64_t m_nMemoryBudget;                                   // Bytes of memory for the search (0 - no limit)
+    uint64_t m_nOutputMemory;                                   // Bytes of the budget taken by the output of primes
+
+    SieveSettings(uint32_t nThreads = 0, uint32_t nWheelPrimes = 0, uint32_t nSegmentSize = 0, bool fPipelined = false):
+        m_nThreads(nThreads), m_nWheelPrimes(nWheelPrimes), m_nSegmentSize(nSegmentSize), m_fPipelined(fPipelined),
+        m_nMemoryBudget(0), m_nOutputMemory(0) {}
+};
+
+#endif // SIEVESETTINGS_HPP
+
+//*****************************************************************************************
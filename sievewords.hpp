@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    sievewords.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Bit storage of the sieve: one vector of 64-bit words for each spoke
+  *          of Wheel Factorisation. Every interval has its own block of words
+  *          in the vector, so memory depends on the sum of widths of intervals,
+  *          not on the max bound. Bit b of the block of the spoke s is set if
+  *          the number (Origin + b) * Primorial + s is composite.
+  *          Words are taken from Arena
+  ******************************************************************************
+*/
+
+#ifndef SIEVEWORDS_HPP
+#define SIEVEWORDS_HPP
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+#include "interval.hpp"
+#include "arenaallocator.hpp"
+
+typedef std::vector <uint64_t, ArenaAllocator <uint64_t> > SieveWords;  // Bits of one spoke (aligned, reused by next chunks)
+typedef std::vector <SieveWords> VectorSieveWords;          // Bits of all spokes
+
+struct SieveBlock
+{
+    Interval m_Int;                                         // Normalised interval of the block
+    bool m_fSieved;                                         // Interval is sieved (true) or tested directly (false)
+    uint64_t m_nOrigin;                                     // Index k of the first bit of the block (multiple of 64)
+    size_t m_nWordOffset;                                   // Offset of the block in the words of every spoke
+    size_t m_nDirectBegin;                                  // Primes of the direct test of the block are
+    size_t m_nDirectEnd;                                    //   m_nDirectBegin...m_nDirectEnd - 1
+
+    SieveBlock(const Interval &Int, bool fSieved): m_Int(Int), m_fSieved(fSieved), m_nOrigin(0), m_nWordOffset(0),
+        m_nDirectBegin(0), m_nDirectEnd(0) {}
+};
+
+inline void setSieveBit(uint64_t *pWords, uint64_t nBit)
+{
+    pWords[nBit >> 6] |= static_cast <uint64_t> (1) << (nBit & 63);
+}
+
+inline bool testSieveBit(const uint64_t *pWords, uint64_t nBit)
+{
+    return (pWords[nBit >> 6] >> (nBit & 63)) & 1;
+}
+
+#endif // SIEVEWORDS_HPP
+
+//*****************************************************************************************
@@ -0,0 +1,411 @@
+/**
+  *************************************************************************************************************************
+  * @file    simdkernels.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Vector kernels for the dense work on the sieve words: clearing of the segment, combining of the pre-sieved
+  *          pattern, popcount and extraction of primes (zero bits). SSE2, AVX2 and AVX-512 variants are compiled with
+  *          target attributes, the best one is selected at runtime by CPUID and cross-checked with the scalar variant,
+  *          which is the fallback
+  **************************************************************************************************************************
+*/
+
+#include <random>
+#include <algorithm>
+
+#include "simdkernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Positions of zero bits of one word
+ * @param nWord Word
+ * @param nBase Position of the first bit of the word
+ * @param pOut Array to write positions in
+ * @return Number of written positions
+ */
+static inline size_t extractWord(uint64_t nWord, uint32_t nBase, uint32_t *pOut)
+{
+    size_t n(0);
+
+    for(uint64_t nBits = ~nWord; nBits; nBits &= nBits - 1)
+    {
+        pOut[n++] = nBase + __builtin_ctzll(nBits);
+    }
+
+    return n;
+}
+
+//************************************************ Scalar variant ********************************************************
+
+static void clearScalar(uint64_t *pWords, size_t nWords)
+{
+    for(size_t i = 0; i < nWords; ++i)
+    {
+        pWords[i] = 0;
+    }
+}
+
+static void orScalar(uint64_t *pDst, const uint64_t *pSrc, size_t nWords)
+{
+    for(size_t i = 0; i < nWords; ++i)
+    {
+        pDst[i] |= pSrc[i];
+    }
+}
+
+static uint64_t popcountScalar(const uint64_t *pWords, size_t nWords)
+{
+    uint64_t nCount(0);
+
+    for(size_t i = 0; i < nWords; ++i)
+    {
+        nCount += __builtin_popcountll(pWords[i]);
+    }
+
+    return nCount;
+}
+
+static size_t extractScalar(const uint64_t *pWords, size_t nWords, uint32_t *pOut)
+{
+    size_t n(0);
+
+    for(size_t i = 0; i < nWords; ++i)
+    {
+        n += extractWord(pWords[i], 64 * i, pOut + n);
+    }
+
+    return n;
+}
+
+#ifdef SIMD_KERNELS_X86
+
+//************************************************ SSE2 variant **********************************************************
+
+__attribute__((target("sse2")))
+static void clearSse2(uint64_t *pWords, size_t nWords)
+{
+    size_t i(0);
+
+    for(__m128i Zero = _mm_setzero_si128(); i + 2 <= nWords; i += 2)
+    {
+        _mm_storeu_si128(reinterpret_cast <__m128i*> (pWords + i), Zero);
+    }
+    clearScalar(pWords + i, nWords - i);
+}
+
+__attribute__((target("sse2")))
+static void orSse2(uint64_t *pDst, const uint64_t *pSrc, size_t nWords)
+{
+    size_t i(0);
+
+    for(; i + 2 <= nWords; i += 2)
+    {
+        __m128i A = _mm_loadu_si128(reinterpret_cast <const __m128i*> (pDst + i));
+        __m128i B = _mm_loadu_si128(reinterpret_cast <const __m128i*> (pSrc + i));
+        _mm_storeu_si128(reinterpret_cast <__m128i*> (pDst + i), _mm_or_si128(A, B));
+    }
+    orScalar(pDst + i, pSrc + i, nWords - i);
+}
+
+__attribute__((target("sse2")))
+static uint64_t popcountSse2(const uint64_t *pWords, size_t nWords)
+{
+    const __m128i M1 = _mm_set1_epi8(0x55), M2 = _mm_set1_epi8(0x33), M4 = _mm_set1_epi8(0x0f);
+    __m128i Acc = _mm_setzero_si128();
+    size_t i(0);
+
+    for(; i + 2 <= nWords; i += 2)                                          // Bit-slicing count in every byte
+    {
+        __m128i V = _mm_loadu_si128(reinterpret_cast <const __m128i*> (pWords + i));
+        V = _mm_sub_epi8(V, _mm_and_si128(_mm_srli_epi64(V, 1), M1));
+        V = _mm_add_epi8(_mm_and_si128(V, M2), _mm_and_si128(_mm_srli_epi64(V, 2), M2));
+        V = _mm_and_si128(_mm_add_epi8(V, _mm_srli_epi64(V, 4)), M4);
+        Acc = _mm_add_epi64(Acc, _mm_sad_epu8(V, _mm_setzero_si128()));
+    }
+
+    uint64_t nLanes[2];
+    _mm_storeu_si128(reinterpret_cast <__m128i*> (nLanes), Acc);
+
+    return nLanes[0] + nLanes[1] + popcountScalar(pWords + i, nWords - i);
+}
+
+__attribute__((target("sse2")))
+static size_t extractSse2(const uint64_t *pWords, size_t nWords, uint32_t *pOut)
+{
+    const __m128i Ones = _mm_set1_epi32(-1);
+    size_t n(0), i(0);
+
+    for(; i + 2 <= nWords; i += 2)                                          // Skip pairs of words without primes at once
+    {
+        __m128i V = _mm_loadu_si128(reinterpret_cast <const __m128i*> (pWords + i));
+        if(0xffff != _mm_movemask_epi8(_mm_cmpeq_epi32(V, Ones)))
+        {
+            n += extractWord(pWords[i], 64 * i, pOut + n);
+            n += extractWord(pWords[i + 1], 64 * (i + 1), pOut + n);
+        }
+    }
+    for(; i < nWords; ++i)
+    {
+        n += extractWord(pWords[i], 64 * i, pOut + n);
+    }
+
+    return n;
+}
+
+//************************************************ AVX2 variant **********************************************************
+
+__attribute__((target("avx2")))
+static void clearAvx2(uint64_t *pWords, size_t nWords)
+{
+    size_t i(0);
+
+    for(__m256i Zero = _mm256_setzero_si256(); i + 4 <= nWords; i += 4)
+    {
+        _mm256_storeu_si256(reinterpret_cast <__m256i*> (pWords + i), Zero);
+    }
+    clearScalar(pWords + i, nWords - i);
+}
+
+__attribute__((target("avx2")))
+static void orAvx2(uint64_t *pDst, const uint64_t *pSrc, size_t nWords)
+{
+    size_t i(0);
+
+    for(; i + 4 <= nWords; i += 4)
+    {
+        __m256i A = _mm256_loadu_si256(reinterpret_cast <const __m256i*> (pDst + i));
+        __m256i B = _mm256_loadu_si256(reinterpret_cast <const __m256i*> (pSrc + i));
+        _mm256_storeu_si256(reinterpret_cast <__m256i*> (pDst + i), _mm256_or_si256(A, B));
+    }
+    orScalar(pDst + i, pSrc + i, nWords - i);
+}
+
+__attribute__((target("avx2")))
+static uint64_t popcountAvx2(const uint64_t *pWords, size_t nWords)
+{
+    const __m256i Lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i Low = _mm256_set1_epi8(0x0f);
+    __m256i Acc = _mm256_setzero_si256();
+    size_t i(0);
+
+    for(; i + 4 <= nWords; i += 4)                                          // Nibble lookup (W. Mula)
+    {
+        __m256i V = _mm256_loadu_si256(reinterpret_cast <const __m256i*> (pWords + i));
+        __m256i Cnt = _mm256_add_epi8(_mm256_shuffle_epi8(Lookup, _mm256_and_si256(V, Low)),
+                                      _mm256_shuffle_epi8(Lookup, _mm256_and_si256(_mm256_srli_epi16(V, 4), Low)));
+        Acc = _mm256_add_epi64(Acc, _mm256_sad_epu8(Cnt, _mm256_setzero_si256()));
+    }
+
+    uint64_t nLanes[4];
+    _mm256_storeu_si256(reinterpret_cast <__m256i*> (nLanes), Acc);
+
+    return nLanes[0] + nLanes[1] + nLanes[2] + nLanes[3] + popcountScalar(pWords + i, nWords - i);
+}
+
+__attribute__((target("avx2")))
+static size_t extractAvx2(const uint64_t *pWords, size_t nWords, uint32_t *pOut)
+{
+    const __m256i Ones = _mm256_set1_epi32(-1);
+    size_t n(0), i(0);
+
+    for(; i + 4 <= nWords; i += 4)                                          // Skip quads of words without primes at once
+    {
+        __m256i V = _mm256_loadu_si256(reinterpret_cast <const __m256i*> (pWords + i));
+        if(-1 != _mm256_movemask_epi8(_mm256_cmpeq_epi32(V, Ones)))
+        {
+            for(size_t j = i; j < i + 4; ++j)
+            {
+                n += extractWord(pWords[j], 64 * j, pOut + n);
+            }
+        }
+    }
+    for(; i < nWords; ++i)
+    {
+        n += extractWord(pWords[i], 64 * i, pOut + n);
+    }
+
+    return n;
+}
+
+//************************************************ AVX-512 variant *******************************************************
+
+__attribute__((target("avx512f,avx512bw")))
+static void clearAvx512(uint64_t *pWords, size_t nWords)
+{
+    size_t i(0);
+
+    for(__m512i Zero = _mm512_setzero_si512(); i + 8 <= nWords; i += 8)
+    {
+        _mm512_storeu_si512(pWords + i, Zero);
+    }
+    clearScalar(pWords + i, nWords - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void orAvx512(uint64_t *pDst, const uint64_t *pSrc, size_t nWords)
+{
+    size_t i(0);
+
+    for(; i + 8 <= nWords; i += 8)
+    {
+        __m512i A = _mm512_loadu_si512(pDst + i);
+        __m512i B = _mm512_loadu_si512(pSrc + i);
+        _mm512_storeu_si512(pDst + i, _mm512_or_si512(A, B));
+    }
+    orScalar(pDst + i, pSrc + i, nWords - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static uint64_t popcountAvx512(const uint64_t *pWords, size_t nWords)
+{
+    const __m512i Lookup = _mm512_set4_epi32(0x04030302, 0x03020201, 0x03020201, 0x02010100);
+    const __m512i Low = _mm512_set1_epi8(0x0f);
+    __m512i Acc = _mm512_setzero_si512();
+    size_t i(0);
+
+    for(; i + 8 <= nWords; i += 8)                                          // Nibble lookup in every 128-bit lane
+    {
+        __m512i V = _mm512_loadu_si512(pWords + i);
+        __m512i Cnt = _mm512_add_epi8(_mm512_shuffle_epi8(Lookup, _mm512_and_si512(V, Low)),
+                                      _mm512_shuffle_epi8(Lookup, _mm512_and_si512(_mm512_srli_epi16(V, 4), Low)));
+        Acc = _mm512_add_epi64(Acc, _mm512_sad_epu8(Cnt, _mm512_setzero_si512()));
+    }
+
+    uint64_t nLanes[8];
+    _mm512_storeu_si512(nLanes, Acc);
+
+    return nLanes[0] + nLanes[1] + nLanes[2] + nLanes[3] + nLanes[4] + nLanes[5] + nLanes[6] + nLanes[7] +
+           popcountScalar(pWords + i, nWords - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t extractAvx512(const uint64_t *pWords, size_t nWords, uint32_t *pOut)
+{
+    const __m512i Lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    size_t n(0);
+
+    for(size_t i = 0; i < nWords; ++i)                                      // Compress positions of zero bits by 16
+    {
+        uint64_t nBits = ~pWords[i];
+
+        for(uint32_t j = 0; nBits && j < 4; ++j, nBits >>= 16)
+        {
+            __mmask16 nMask = static_cast <__mmask16> (nBits & 0xffff);
+            __m512i Pos = _mm512_add_epi32(Lanes, _mm512_set1_epi32(static_cast <int> (64 * i + 16 * j)));
+            _mm512_mask_compressstoreu_epi32(pOut + n, nMask, Pos);
+            n += __builtin_popcount(nMask);
+        }
+    }
+
+    return n;
+}
+
+#endif // SIMD_KERNELS_X86
+
+/**
+ * @brief Returns all variants of the kernels supported by the CPU
+ * @param None
+ * @return VariantsVc Variants from the scalar to the widest
+ */
+std::vector <SimdKernels::Variant> SimdKernels::getSupported()
+{
+    std::vector <Variant> VariantsVc;
+
+    VariantsVc.push_back({ "scalar", clearScalar, orScalar, popcountScalar, extractScalar });
+
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("sse2"))
+    {
+        VariantsVc.push_back({ "sse2", clearSse2, orSse2, popcountSse2, extractSse2 });
+    }
+    if(__builtin_cpu_supports("avx2"))
+    {
+        VariantsVc.push_back({ "avx2", clearAvx2, orAvx2, popcountAvx2, extractAvx2 });
+    }
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        VariantsVc.push_back({ "avx512", clearAvx512, orAvx512, popcountAvx512, extractAvx512 });
+    }
+#endif
+
+    return VariantsVc;
+}
+
+/**
+ * @brief Cross-check all kernels of the variant with the scalar ones on random words. Lengths cover the tails of
+ *        every vector width, words start at the odd offset, so unaligned loads are checked too
+ * @param Var Variant to check
+ * @return true if all results are equal to the scalar ones
+ */
+bool SimdKernels::check(const Variant &Var)
+{
+    std::mt19937_64 Rand(1);
+
+    for(size_t nWords : { 0, 1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 1000 })
+    {
+        std::vector <uint64_t> SrcVc(nWords + 1), DstVc(nWords + 1), RefVc(nWords + 1);
+        std::vector <uint32_t> BitsVc(64 * nWords + 1), RefBitsVc(64 * nWords + 1);
+
+        for(size_t i = 0; i <= nWords; ++i)
+        {
+            SrcVc[i] = Rand() & Rand();                                     // Dense and sparse bits like the sieve
+            DstVc[i] = RefVc[i] = (i & 1 ? Rand() : Rand() | Rand());
+        }
+
+        Var.m_pOr(DstVc.data() + 1, SrcVc.data() + 1, nWords);
+        orScalar(RefVc.data() + 1, SrcVc.data() + 1, nWords);
+        if(DstVc != RefVc || Var.m_pPopcount(DstVc.data() + 1, nWords) != popcountScalar(RefVc.data() + 1, nWords))
+        {
+            return false;
+        }
+
+        size_t nBits = Var.m_pExtractZeros(DstVc.data() + 1, nWords, BitsVc.data());
+        if(nBits != extractScalar(RefVc.data() + 1, nWords, RefBitsVc.data()) ||
+           !std::equal(BitsVc.begin(), BitsVc.begin() + nBits, RefBitsVc.begin()))
+        {
+            return false;
+        }
+
+        Var.m_pClear(DstVc.data() + 1, nWords);
+        clearScalar(RefVc.data() + 1, nWords);
+        if(DstVc != RefVc)                                                  // The word before the range is kept
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the best variant of the kernels: the widest one supported by the CPU which gives the same results
+ *        as the scalar variant. It is selected once, at the first call
+ * @param None
+ * @return Variant
+ */
+const SimdKernels::Variant &SimdKernels::get()
+{
+    static const Variant Best = [] ()
+    {
+        std::vector <Variant> VariantsVc = getSupported();
+
+        while(VariantsVc.size() > 1 && !check(VariantsVc.back()))
+        {
+            VariantsVc.pop_back();
+        }
+
+        return VariantsVc.back();
+    }();
+
+    return Best;
+}
+
+//*****************************************************************************************
@@ -0,0 +1,45 @@
+/**
+  *************************************************************************************************************************
+  * @file    simdkernels.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Vector kernels for the dense work on the sieve words: clearing of the segment, combining of the pre-sieved
+  *          pattern, popcount and extraction of primes (zero bits). SSE2, AVX2 and AVX-512 variants are compiled with
+  *          target attributes, the best one is selected at runtime by CPUID and cross-checked with the scalar variant,
+  *          which is the fallback
+  **************************************************************************************************************************
+*/
+
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+class SimdKernels
+{
+public:
+    typedef void (*ClearFunc)(uint64_t *pWords, size_t nWords);                         // Set all words to zero
+    typedef void (*OrFunc)(uint64_t *pDst, const uint64_t *pSrc, size_t nWords);        // pDst |= pSrc
+    typedef uint64_t (*PopcountFunc)(const uint64_t *pWords, size_t nWords);            // Number of set bits
+    typedef size_t (*ExtractFunc)(const uint64_t *pWords, size_t nWords, uint32_t *pOut);  // Positions of zero bits
+
+    struct Variant
+    {
+        const char *m_pName;
+        ClearFunc m_pClear;
+        OrFunc m_pOr;
+        PopcountFunc m_pPopcount;
+        ExtractFunc m_pExtractZeros;                       // pOut must have room for 64 * nWords positions
+    };
+
+    static const Variant &get();                           // The best variant supported by the CPU
+    static std::vector <Variant> getSupported();           // All variants supported by the CPU, scalar is the first
+    static bool check(const Variant &Var);                 // All kernels give the same results as the scalar ones
+};
+
+#endif // SIMDKERNELS_H
+
+//*****************************************************************************************
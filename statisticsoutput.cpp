@@ -0,0 +1,310 @@
+/**
+  *************************************************************************************************************************
+  * @file    statisticsoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which finds for every interval as it is given (not merged)
+  *          the number, the sum, the least and the greatest prime, the max gap and the histogram of gaps, and writes
+  *          them to the file. Numbers are split by ends of all intervals into disjoint pieces, statistics of pieces are
+  *          found by threads in parts of positions and merged, then pieces are merged into intervals. Primes are never
+  *          formatted
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+
+#include "statisticsoutput.h"
+#include "profiler.h"
+
+/**
+ * @brief Class StatisticsOutput constructor
+ * @param pFileName Name of the file to write in
+ * @param pOrigVc Intervals as they are given (IntervalsOutput fills them besides merged ones)
+ * @param nThreads Number of threads of output() (0 - by the hardware)
+ */
+StatisticsOutput::StatisticsOutput(const char *pFileName, const std::vector <Interval> *pOrigVc, uint32_t nThreads):
+    PrimesOutput(), m_pFileName(pFileName), m_pOrigVc(pOrigVc), m_nThreads(nThreads), m_Pieces(pOrigVc), m_nPiece(0)
+{
+    if(!m_nThreads)
+    {
+        m_nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+/**
+ * @brief Class StatisticsOutput destructor
+ */
+StatisticsOutput::~StatisticsOutput() {}
+
+/**
+ * @brief Adds the gap to the max gap and to the histogram
+ * @param Dst Statistics
+ * @param nGap Difference of the next primes
+ * @return None
+ */
+void StatisticsOutput::addGap(Stats &Dst, uint64_t nGap)
+{
+    if(Dst.m_nGapsVc.size() <= nGap / 2)
+    {
+        Dst.m_nGapsVc.resize(nGap / 2 + 1, 0);
+    }
+
+    ++Dst.m_nGapsVc[nGap / 2];
+    Dst.m_nMaxGap = std::max(Dst.m_nMaxGap, nGap);
+}
+
+/**
+ * @brief Adds the prime which is greater than all primes of the statistics
+ * @param Dst Statistics
+ * @param nPrime Prime
+ * @return None
+ */
+void StatisticsOutput::addPrime(Stats &Dst, uint64_t nPrime)
+{
+    if(Dst.m_nCount)
+    {
+        addGap(Dst, nPrime - Dst.m_nMax);
+    }
+    else
+    {
+        Dst.m_nMin = nPrime;
+    }
+
+    Dst.m_nMax = nPrime;
+    Dst.m_nSum += nPrime;
+    ++Dst.m_nCount;
+}
+
+/**
+ * @brief Merges statistics of the next numbers: the gap between the greatest prime of Dst and the least prime of Src
+ *        is added, the rest is summed
+ * @param Dst Statistics to merge in
+ * @param Src Statistics of the numbers greater than numbers of Dst
+ * @return None
+ */
+void StatisticsOutput::merge(Stats &Dst, const Stats &Src)
+{
+    if(!Src.m_nCount)
+    {
+        return;
+    }
+
+    if(!Dst.m_nCount)
+    {
+        Dst = Src;
+        return;
+    }
+
+    addGap(Dst, Src.m_nMin - Dst.m_nMax);
+    if(Dst.m_nGapsVc.size() < Src.m_nGapsVc.size())
+    {
+        Dst.m_nGapsVc.resize(Src.m_nGapsVc.size(), 0);
+    }
+    for(size_t i = 0, p = Src.m_nGapsVc.size(); i < p; ++i)
+    {
+        Dst.m_nGapsVc[i] += Src.m_nGapsVc[i];
+    }
+
+    Dst.m_nMaxGap = std::max(Dst.m_nMaxGap, Src.m_nMaxGap);
+    Dst.m_nMax = Src.m_nMax;
+    Dst.m_nSum += Src.m_nSum;
+    Dst.m_nCount += Src.m_nCount;
+}
+
+/**
+ * @brief Decimal string of the 128-bit number (streams can't print it)
+ * @param nVal Number
+ * @return String
+ */
+std::string StatisticsOutput::toString(unsigned __int128 nVal)
+{
+    std::string Res;
+
+    do
+    {
+        Res += static_cast <char> ('0' + static_cast <int> (nVal % 10));
+        nVal /= 10;
+    }
+    while(nVal);
+
+    std::reverse(Res.begin(), Res.end());
+    return Res;
+}
+
+/**
+ * @brief Adds primes to statistics of their pieces
+ * @param PrimesVc Primes in ascending order
+ * @param StatsVc Statistics of every piece
+ * @param nPiece Piece of the previous prime (it is moved forward)
+ * @return None
+ */
+void StatisticsOutput::collect(const std::vector <uint64_t> &PrimesVc, std::vector <Stats> &StatsVc, size_t &nPiece) const
+{
+    for(uint64_t nPrime : PrimesVc)
+    {
+        if(m_Pieces.findPiece(nPrime, nPiece) < StatsVc.size())
+        {
+            addPrime(StatsVc[nPiece], nPrime);
+        }
+    }
+}
+
+/**
+ * @brief Merges statistics of pieces into statistics of every interval
+ * @param None
+ * @return None
+ */
+void StatisticsOutput::finish()
+{
+    m_StatsVc.assign(m_pOrigVc->size(), Stats());
+
+    for(size_t i = 0, p = m_pOrigVc->size(); i < p; ++i)
+    {
+        for(size_t j = m_Pieces.getFirstPiece(i), q = j + m_Pieces.getPiecesNum(i); j < q; ++j)
+        {
+            merge(m_StatsVc[i], m_PieceStatsVc[j]);
+        }
+    }
+}
+
+/**
+ * @brief Implementation of the abstract function to output statistics: positions of PrimeNumbersVector are split
+ *        between threads, every thread finds statistics of pieces of its part, then parts are merged in order
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void StatisticsOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("statistics");
+    size_t nSize = pPrimeNumVc->size(), nPart = (nSize + m_nThreads - 1) / m_nThreads;
+    std::vector <std::vector <Stats> > PartsVc(m_nThreads);
+    std::vector <std::thread> ThreadsVc;
+
+    m_Pieces.make();
+    for(uint32_t t = 0; t < m_nThreads; ++t)
+    {
+        ThreadsVc.emplace_back([this, pPrimeNumVc, &PartsVc, t, nPart, nSize] ()
+        {
+            std::vector <uint64_t> PrimesVc;
+            size_t nPiece(0);
+
+            PartsVc[t].assign(m_Pieces.getPieces().size(), Stats());
+            for(size_t i = t * nPart, p = std::min(nSize, (t + 1) * nPart); i < p; i += m_nChunkSize)
+            {
+                pPrimeNumVc->getPrimes(i, std::min <size_t> (m_nChunkSize, p - i), PrimesVc);
+                collect(PrimesVc, PartsVc[t], nPiece);
+            }
+        });
+    }
+
+    for(std::thread &Thread : ThreadsVc)
+    {
+        Thread.join();
+    }
+
+    m_PieceStatsVc.assign(m_Pieces.getPieces().size(), Stats());
+    for(size_t j = 0, q = m_Pieces.getPieces().size(); j < q; ++j)
+    {
+        for(uint32_t t = 0; t < m_nThreads; ++t)
+        {
+            merge(m_PieceStatsVc[j], PartsVc[t][j]);
+        }
+    }
+
+    finish();
+    writeFile();
+}
+
+/**
+ * @brief Start of the stream of primes
+ * @param None
+ * @return None
+ */
+void StatisticsOutput::begin()
+{
+    m_Pieces.make();
+    m_PieceStatsVc.assign(m_Pieces.getPieces().size(), Stats());
+    m_nPiece = 0;
+}
+
+/**
+ * @brief Next primes of the stream
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void StatisticsOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    Profiler::ScopedTimer Timer("statistics");
+
+    collect(PrimesVc, m_PieceStatsVc, m_nPiece);
+}
+
+/**
+ * @brief End of the stream: statistics of pieces are merged into intervals and written
+ * @param None
+ * @return None
+ */
+void StatisticsOutput::end()
+{
+    finish();
+    writeFile();
+}
+
+/**
+ * @brief Writes statistics of every interval to the file
+ * @param None
+ * @return None
+ */
+void StatisticsOutput::writeFile() const
+{
+    std::ofstream Out(m_pFileName);
+
+    if(!Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    Out << "<root>\n<statistics>\n";
+    for(size_t i = 0, p = m_pOrigVc->size(); i < p; ++i)
+    {
+        const Stats &Cur = m_StatsVc[i];
+
+        Out << "  <interval>\n    <low>" << (*m_pOrigVc)[i].m_nLowIntervalSide << "</low>\n    <high>"
+            << (*m_pOrigVc)[i].m_nHighIntervalSide << "</high>\n    <count>" << Cur.m_nCount << "</count>\n    <sum>"
+            << toString(Cur.m_nSum) << "</sum>\n";
+
+        if(Cur.m_nCount)
+        {
+            Out << "    <min>" << Cur.m_nMin << "</min>\n    <max>" << Cur.m_nMax << "</max>\n    <maxgap>"
+                << Cur.m_nMaxGap << "</maxgap>\n    <gaps>\n";
+            for(size_t j = 0, q = Cur.m_nGapsVc.size(); j < q; ++j)
+            {
+                if(Cur.m_nGapsVc[j])
+                {
+                    Out << "      <gap><length>" << (j ? 2 * j : 1) << "</length><number>" << Cur.m_nGapsVc[j]
+                        << "</number></gap>\n";
+                }
+            }
+            Out << "    </gaps>\n";
+        }
+        Out << "  </interval>\n";
+    }
+    Out << "</statistics>\n</root>";
+}
+
+/**
+ * @brief Returns statistics of every interval
+ * @param None
+ * @return Statistics in order of intervals as they are given
+ */
+const std::vector <StatisticsOutput::Stats> &StatisticsOutput::getStats() const
+{
+    return m_StatsVc;
+}
+
+//*****************************************************************************************
@@ -0,0 +1,72 @@
+/**
+  *************************************************************************************************************************
+  * @file    statisticsoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which finds for every interval as it is given (not merged)
+  *          the number, the sum, the least and the greatest prime, the max gap and the histogram of gaps, and writes
+  *          them to the file. Numbers are split by ends of all intervals into disjoint pieces, statistics of pieces are
+  *          found by threads in parts of positions and merged, then pieces are merged into intervals. Primes are never
+  *          formatted
+  **************************************************************************************************************************
+*/
+
+#ifndef STATISTICSOUTPUT_H
+#define STATISTICSOUTPUT_H
+
+#include <vector>
+#include <string>
+
+#include "primesoutput.hpp"
+#include "interval.hpp"
+#include "intervalpieces.h"
+
+class StatisticsOutput: public PrimesOutput
+{
+public:
+    struct Stats                                            // Statistics of the interval
+    {
+        uint64_t m_nCount;
+        unsigned __int128 m_nSum;
+        uint64_t m_nMin;                                    // The least prime (if m_nCount is not 0)
+        uint64_t m_nMax;                                    // The greatest prime (if m_nCount is not 0)
+        uint64_t m_nMaxGap;                                 // Max difference of the next primes
+        std::vector <uint64_t> m_nGapsVc;                   // Number of gaps of the length 2 * i (the gap 1 is in [0])
+
+        Stats(): m_nCount(0), m_nSum(0), m_nMin(0), m_nMax(0), m_nMaxGap(0) {}
+    };
+
+    StatisticsOutput(const char *pFileName, const std::vector <Interval> *pOrigVc, uint32_t nThreads = 0);
+    virtual ~StatisticsOutput() override;
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+    const std::vector <Stats> &getStats() const;            // Statistics of every interval in order of pOrigVc
+
+private:
+    const char *m_pFileName;
+    const std::vector <Interval> *m_pOrigVc;                // Intervals as they are given
+    uint32_t m_nThreads;                                    // Threads of output() (0 - by the hardware)
+    IntervalPieces m_Pieces;                                // Disjoint pieces of intervals
+    std::vector <Stats> m_PieceStatsVc;                     // Statistics of every piece
+    size_t m_nPiece;                                        // Piece of the last prime of the stream
+    std::vector <Stats> m_StatsVc;                          // Statistics of every interval
+
+    static void addPrime(Stats &Dst, uint64_t nPrime);
+    static void addGap(Stats &Dst, uint64_t nGap);
+    static void merge(Stats &Dst, const Stats &Src);        // Primes of Src are greater than primes of Dst
+    static std::string toString(unsigned __int128 nVal);
+
+    void collect(const std::vector <uint64_t> &PrimesVc, std::vector <Stats> &StatsVc, size_t &nPiece) const;
+    void finish();
+    void writeFile() const;
+};
+
+#endif // STATISTICSOUTPUT_H
+
+//*****************************************************************************************
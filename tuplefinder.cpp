@@ -0,0 +1,271 @@
+/**
+  *************************************************************************************************************************
+  * @file    tuplefinder.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to find prime k-tuples in the result of the sieve without getting primes one by one. The member of
+  *          the tuple with the offset d from the number of the spoke s is in the spoke (s + d) % primorial and
+  *          (s + d) / primorial indices further, so words of the first spoke are ANDed with shifted words of the spokes
+  *          of other members, and 64 candidates are checked at once. Spokes which give a member divisible by a prime
+  *          of the wheel are skipped. Tuples which start not greater than the largest prime of the wheel, and tuples
+  *          of blocks of the direct test, are checked number by number
+  **************************************************************************************************************************
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+
+#include "tuplefinder.h"
+#include "millerrabin.h"
+
+/**
+ * @brief Class TupleFinder constructor
+ * @param pPrimeNumVector Result of the sieve of the usual mode (it must live while the finder is used)
+ */
+TupleFinder::TupleFinder(const PrimeNumbersVector *pPrimeNumVector): m_pPrimeNumVector(pPrimeNumVector)
+{
+    m_nSpokeIdxVc.assign(m_pPrimeNumVector->m_nPrimor, -1);
+    for(uint32_t i = 0; i < m_pPrimeNumVector->m_nNumOfSpokes; ++i)
+    {
+        m_nSpokeIdxVc[(*m_pPrimeNumVector->m_pSpokesVector)[i]] = i;
+    }
+}
+
+/**
+ * @brief Class TupleFinder destructor
+ */
+TupleFinder::~TupleFinder() {}
+
+/**
+ * @brief Makes the pattern from its name (twins, cousins, sexy, triplets, triplets2, quadruplets) or from offsets
+ *        separated by commas, e.g. "0,2,6"
+ * @param Text Name or offsets
+ * @param Pattern Variable to write the pattern in
+ * @return false if the text is not a known name and not a valid list of offsets
+ */
+bool TupleFinder::parsePattern(const std::string &Text, TuplePattern &Pattern)
+{
+    static const TuplePattern Known[] = { TuplePattern("twins", { 0, 2 }), TuplePattern("cousins", { 0, 4 }),
+                                          TuplePattern("sexy", { 0, 6 }), TuplePattern("triplets", { 0, 2, 6 }),
+                                          TuplePattern("triplets2", { 0, 4, 6 }), TuplePattern("quadruplets", { 0, 2, 6, 8 }) };
+
+    for(const TuplePattern &Cur : Known)
+    {
+        if(Cur.m_Name == Text)
+        {
+            Pattern = Cur;
+            return true;
+        }
+    }
+
+    std::istringstream In(Text);
+    std::string Item;
+
+    Pattern = TuplePattern(Text, {});
+    while(std::getline(In, Item, ','))
+    {
+        char *pEnd(nullptr);
+        unsigned long nOffset = strtoul(Item.c_str(), &pEnd, 10);
+
+        if(Item.empty() || *pEnd || nOffset > TuplePattern::m_nMaxOffset ||
+           (Pattern.m_nOffsetsVc.empty() ? nOffset != 0 : nOffset <= Pattern.m_nOffsetsVc.back()))
+        {
+            return false;                                  // Offsets must start with 0 and ascend
+        }
+        Pattern.m_nOffsetsVc.push_back(nOffset);
+    }
+
+    return (Pattern.m_nOffsetsVc.size() > 1);
+}
+
+/**
+ * @brief Returns number of blocks of the result of the sieve
+ * @param None
+ * @return Number of blocks
+ */
+size_t TupleFinder::getBlocksNum() const
+{
+    return m_pPrimeNumVector->m_pBlocksVector->size();
+}
+
+/**
+ * @brief Finds tuples of the pattern whose all members belong to the interval of the block
+ * @param nBlock Index of the block
+ * @param Pattern Pattern of the tuple
+ * @param pFirstVc Container to append first members of tuples in ascending order (nullptr if only the number is needed)
+ * @return Number of tuples
+ */
+uint64_t TupleFinder::find(size_t nBlock, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const
+{
+    const SieveBlock &Block = (*m_pPrimeNumVector->m_pBlocksVector)[nBlock];
+    uint64_t nCount = findSmall(Block, Pattern, pFirstVc);
+
+    return nCount + (Block.m_fSieved ? findSieved(Block, Pattern, pFirstVc) : findDirect(Block, Pattern, pFirstVc));
+}
+
+/**
+ * @brief Checks tuples which start not greater than m_nSmallLimit by the primality test: primes of the wheel are not
+ *        in the bits of spokes
+ * @param Block Block of the interval
+ * @param Pattern Pattern of the tuple
+ * @param pFirstVc Container to append first members of tuples in (it may be nullptr)
+ * @return Number of tuples
+ */
+uint64_t TupleFinder::findSmall(const SieveBlock &Block, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const
+{
+    uint64_t nHigh = Block.m_Int.m_nHighIntervalSide, nCount(0);
+
+    for(uint64_t n = Block.m_Int.m_nLowIntervalSide; n <= nHigh && n <= m_nSmallLimit; ++n)
+    {
+        bool fTuple = (Pattern.m_nOffsetsVc.back() <= nHigh - n);
+
+        for(size_t j = 0; fTuple && j < Pattern.m_nOffsetsVc.size(); ++j)
+        {
+            fTuple = MillerRabin::isPrime(n + Pattern.m_nOffsetsVc[j]);
+        }
+
+        if(fTuple)
+        {
+            ++nCount;
+            if(pFirstVc)
+            {
+                pFirstVc->push_back(n);
+            }
+        }
+    }
+
+    return nCount;
+}
+
+/**
+ * @brief Finds tuples in primes of the block of the direct test by the binary search of members
+ * @param Block Block of the direct test
+ * @param Pattern Pattern of the tuple
+ * @param pFirstVc Container to append first members of tuples in (it may be nullptr)
+ * @return Number of tuples
+ */
+uint64_t TupleFinder::findDirect(const SieveBlock &Block, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const
+{
+    std::vector <uint64_t>::const_iterator Begin = m_pPrimeNumVector->m_pDirectVector->begin() + Block.m_nDirectBegin;
+    std::vector <uint64_t>::const_iterator End = m_pPrimeNumVector->m_pDirectVector->begin() + Block.m_nDirectEnd;
+    uint64_t nHigh = Block.m_Int.m_nHighIntervalSide, nCount(0);
+
+    for(std::vector <uint64_t>::const_iterator Iter = Begin; Iter != End; ++Iter)
+    {
+        bool fTuple = (*Iter > m_nSmallLimit && Pattern.m_nOffsetsVc.back() <= nHigh - *Iter);
+
+        for(size_t j = 1; fTuple && j < Pattern.m_nOffsetsVc.size(); ++j)
+        {
+            fTuple = std::binary_search(Iter, End, *Iter + Pattern.m_nOffsetsVc[j]);
+        }
+
+        if(fTuple)
+        {
+            ++nCount;
+            if(pFirstVc)
+            {
+                pFirstVc->push_back(*Iter);
+            }
+        }
+    }
+
+    return nCount;
+}
+
+/**
+ * @brief Finds tuples in the sieved block. For every spoke words of primes are ANDed with words of the spokes of other
+ *        members shifted by their distance in indices. Bits out of the interval are cleared, so the last member
+ *        must belong to the interval too
+ * @param Block Sieved block
+ * @param Pattern Pattern of the tuple
+ * @param pFirstVc Container to append first members of tuples in (it may be nullptr)
+ * @return Number of tuples
+ */
+uint64_t TupleFinder::findSieved(const SieveBlock &Block, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const
+{
+    const VectorSieveWords &SieveVc = *m_pPrimeNumVector->m_pSieveVector;
+    const std::vector <uint32_t> &SpokesVc = *m_pPrimeNumVector->m_pSpokesVector;
+    uint32_t nPrimor = m_pPrimeNumVector->m_nPrimor, nSpokes = m_pPrimeNumVector->m_nNumOfSpokes;
+    uint64_t nRows = ((Block.m_Int.m_nHighIntervalSide / nPrimor - Block.m_nOrigin) >> 6) + 1;
+    size_t nBegin = (pFirstVc ? pFirstVc->size() : 0), nMembers = Pattern.m_nOffsetsVc.size();
+    std::vector <uint64_t> nFirstVc(nSpokes), nLastVc(nSpokes);              // Indices of every spoke in the interval
+    std::vector <char> fInsideVc(nSpokes);
+    uint64_t nCount(0);
+
+    for(uint32_t i = 0; i < nSpokes; ++i)
+    {
+        fInsideVc[i] = m_pPrimeNumVector->getSpokeRange(Block, i, nFirstVc[i], nLastVc[i]);
+    }
+
+    auto PrimeWord = [&] (uint32_t nSpoke, uint64_t nRow) -> uint64_t      // Primes of the word of the spoke
+    {
+        if(!fInsideVc[nSpoke] || nRow >= nRows)
+        {
+            return 0;
+        }
+
+        return ~SieveVc[nSpoke][Block.m_nWordOffset + nRow] &
+               PrimeNumbersVector::rowMask(nFirstVc[nSpoke], nLastVc[nSpoke], Block.m_nOrigin + 64 * nRow);
+    };
+
+    std::vector <uint32_t> nTargetVc(nMembers), nShiftVc(nMembers);          // Spoke and distance in indices of every member
+    for(uint32_t i = 0; i < nSpokes; ++i)
+    {
+        bool fAdmissible(fInsideVc[i]);
+
+        for(size_t j = 1; fAdmissible && j < nMembers; ++j)
+        {
+            uint64_t nSum = SpokesVc[i] + Pattern.m_nOffsetsVc[j];
+
+            fAdmissible = (m_nSpokeIdxVc[nSum % nPrimor] >= 0);
+            nTargetVc[j] = m_nSpokeIdxVc[nSum % nPrimor];
+            nShiftVc[j] = nSum / nPrimor;
+        }
+
+        if(!fAdmissible)
+        {
+            continue;                                                        // A member is divisible by a prime of the wheel
+        }
+
+        uint64_t nSmallMask(0);                                              // Numbers up to m_nSmallLimit are checked directly
+        if(!Block.m_nOrigin && SpokesVc[i] <= m_nSmallLimit)
+        {
+            nSmallMask = (static_cast <uint64_t> (1) << ((m_nSmallLimit - SpokesVc[i]) / nPrimor + 1)) - 1;
+        }
+
+        for(uint64_t w = (nFirstVc[i] - Block.m_nOrigin) >> 6, p = (nLastVc[i] - Block.m_nOrigin) >> 6; w <= p; ++w)
+        {
+            uint64_t nBits = PrimeWord(i, w) & (w ? ~static_cast <uint64_t> (0) : ~nSmallMask);
+
+            for(size_t j = 1; nBits && j < nMembers; ++j)
+            {
+                uint64_t nRow = w + (nShiftVc[j] >> 6);
+                uint32_t nShift = nShiftVc[j] & 63;
+                uint64_t nMember = PrimeWord(nTargetVc[j], nRow) >> nShift;
+
+                if(nShift)
+                {
+                    nMember |= PrimeWord(nTargetVc[j], nRow + 1) << (64 - nShift);
+                }
+                nBits &= nMember;
+            }
+
+            nCount += __builtin_popcountll(nBits);
+            for(; pFirstVc && nBits; nBits &= nBits - 1)
+            {
+                pFirstVc->push_back((Block.m_nOrigin + 64 * w + __builtin_ctzll(nBits)) * nPrimor + SpokesVc[i]);
+            }
+        }
+    }
+
+    if(pFirstVc)
+    {
+        std::sort(pFirstVc->begin() + nBegin, pFirstVc->end());
+    }
+
+    return nCount;
+}
+
+//*****************************************************************************************
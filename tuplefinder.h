@@ -0,0 +1,50 @@
+/**
+  *************************************************************************************************************************
+  * @file    tuplefinder.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Class to find prime k-tuples in the result of the sieve without getting primes one by one. The member of
+  *          the tuple with the offset d from the number of the spoke s is in the spoke (s + d) % primorial and
+  *          (s + d) / primorial indices further, so words of the first spoke are ANDed with shifted words of the spokes
+  *          of other members, and 64 candidates are checked at once. Spokes which give a member divisible by a prime
+  *          of the wheel are skipped. Tuples which start not greater than the largest prime of the wheel, and tuples
+  *          of blocks of the direct test, are checked number by number
+  **************************************************************************************************************************
+*/
+
+#ifndef TUPLEFINDER_H
+#define TUPLEFINDER_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+#include "primenumbersvector.h"
+#include "tuplepattern.hpp"
+
+class TupleFinder
+{
+public:
+    TupleFinder(const PrimeNumbersVector *pPrimeNumVector);
+    ~TupleFinder();
+
+    size_t getBlocksNum() const;                            // Blocks are intervals of FindPrimes in the same order
+    uint64_t find(size_t nBlock, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc = nullptr) const;
+
+    static bool parsePattern(const std::string &Text, TuplePattern &Pattern);  // Name or offsets separated by commas
+
+private:
+    static constexpr uint64_t m_nSmallLimit = 13;           // Tuples up to the largest prime of the wheel are checked directly
+
+    const PrimeNumbersVector *m_pPrimeNumVector;            // Result of the sieve
+    std::vector <int32_t> m_nSpokeIdxVc;                    // Index of the spoke of every remainder modulo primorial (-1 if it is not a spoke)
+
+    uint64_t findSmall(const SieveBlock &Block, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const;
+    uint64_t findDirect(const SieveBlock &Block, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const;
+    uint64_t findSieved(const SieveBlock &Block, const TuplePattern &Pattern, std::vector <uint64_t> *pFirstVc) const;
+};
+
+#endif // TUPLEFINDER_H
+
+//*****************************************************************************************
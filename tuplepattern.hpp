@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file    tuplepattern.hpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Pattern of the prime k-tuple: offsets of its members from the
+  *          first one in ascending order (the first offset is 0), e.g.
+  *          0 2 for twins or 0 2 6 for triplets
+  ******************************************************************************
+*/
+
+#ifndef TUPLEPATTERN_HPP
+#define TUPLEPATTERN_HPP
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct TuplePattern
+{
+    static constexpr uint32_t m_nMaxOffset = 1 << 16;       // Max offset of the last member
+
+    std::string m_Name;                                     // Name in the output
+    std::vector <uint32_t> m_nOffsetsVc;                    // Offsets of members
+
+    TuplePattern(const std::string &Name, const std::vector <uint32_t> &nOffsetsVc): m_Name(Name), m_nOffsetsVc(nOffsetsVc) {}
+    TuplePattern() {}
+};
+
+#endif // TUPLEPATTERN_HPP
+
+//*****************************************************************************************
@@ -0,0 +1,229 @@
+/**
+  *************************************************************************************************************************
+  * @file    tuplesoutput.cpp
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which counts prime k-tuples of every interval and writes
+  *          them to the file. The result of the sieve is scanned by TupleFinder word by word, the stream of the
+  *          pipelined mode is checked in the window of the largest offset
+  **************************************************************************************************************************
+*/
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+#include "tuplesoutput.h"
+#include "tuplefinder.h"
+#include "profiler.h"
+
+/**
+ * @brief Class TuplesOutput constructor
+ * @param pFileName Name of the file to write in
+ * @param pIntVc Intervals of FindPrimes (sorted and merged)
+ * @param PatternsVc Patterns to find
+ * @param fList Write first members of tuples, not only their number
+ */
+TuplesOutput::TuplesOutput(const char *pFileName, const std::vector <Interval> *pIntVc, const std::vector <TuplePattern> &PatternsVc,
+                           bool fList):
+    PrimesOutput(), m_pFileName(pFileName), m_pIntVc(pIntVc), m_PatternsVc(PatternsVc), m_fList(fList), m_nInterval(0),
+    m_nMaxOffset(0)
+{
+    for(const TuplePattern &Pattern : m_PatternsVc)
+    {
+        m_nMaxOffset = std::max(m_nMaxOffset, Pattern.m_nOffsetsVc.back());
+    }
+}
+
+/**
+ * @brief Class TuplesOutput destructor
+ */
+TuplesOutput::~TuplesOutput() {}
+
+/**
+ * @brief Clears the result before the next output
+ * @param None
+ * @return None
+ */
+void TuplesOutput::reset()
+{
+    m_nCountVc.assign(m_pIntVc->size() * m_PatternsVc.size(), 0);
+    m_FirstVc.assign(m_fList ? m_nCountVc.size() : 0, std::vector <uint64_t> ());
+    m_WindowVc.clear();
+    m_nInterval = 0;
+}
+
+/**
+ * @brief Implementation of the abstract function to output tuples: words of the result of the sieve are scanned
+ *        by TupleFinder for every interval and pattern
+ * @param pPrimeNumVc Container to prime numbers from
+ * @return None
+ */
+void TuplesOutput::output(PrimeNumbersVector *pPrimeNumVc)
+{
+    Profiler::ScopedTimer Timer("tuples");
+    TupleFinder Finder(pPrimeNumVc);
+
+    reset();
+    for(size_t i = 0, p = Finder.getBlocksNum(); i < p; ++i)
+    {
+        for(size_t j = 0, q = m_PatternsVc.size(); j < q; ++j)
+        {
+            size_t nIdx = i * q + j;
+            m_nCountVc[nIdx] = Finder.find(i, m_PatternsVc[j], m_fList ? &m_FirstVc[nIdx] : nullptr);
+        }
+    }
+
+    writeFile();
+}
+
+/**
+ * @brief Start of the stream of primes
+ * @param None
+ * @return None
+ */
+void TuplesOutput::begin()
+{
+    reset();
+}
+
+/**
+ * @brief Next primes of the stream. The prime leaves the window when the next prime is further than the largest offset,
+ *        then all members of its tuples are in the window
+ * @param PrimesVc Primes in ascending order
+ * @return None
+ */
+void TuplesOutput::write(const std::vector <uint64_t> &PrimesVc)
+{
+    Profiler::ScopedTimer Timer("tuples");
+
+    for(uint64_t nPrime : PrimesVc)
+    {
+        while(!m_WindowVc.empty() && nPrime - m_WindowVc.front() > m_nMaxOffset)
+        {
+            checkTuples(m_WindowVc.front());
+            m_WindowVc.pop_front();
+        }
+        m_WindowVc.push_back(nPrime);
+    }
+}
+
+/**
+ * @brief End of the stream: the rest of the window is checked and the result is written
+ * @param None
+ * @return None
+ */
+void TuplesOutput::end()
+{
+    for(; !m_WindowVc.empty(); m_WindowVc.pop_front())
+    {
+        checkTuples(m_WindowVc.front());
+    }
+
+    writeFile();
+}
+
+/**
+ * @brief Checks tuples of all patterns which start with the first prime of the window
+ * @param nPrime The first prime of the window
+ * @return None
+ */
+void TuplesOutput::checkTuples(uint64_t nPrime)
+{
+    while(m_nInterval < m_pIntVc->size() && (*m_pIntVc)[m_nInterval].m_nHighIntervalSide < nPrime)
+    {
+        ++m_nInterval;                                              // Primes come in order of intervals
+    }
+
+    if(m_nInterval == m_pIntVc->size())
+    {
+        return;
+    }
+
+    uint64_t nHigh = (*m_pIntVc)[m_nInterval].m_nHighIntervalSide;
+    for(size_t j = 0, q = m_PatternsVc.size(); j < q; ++j)
+    {
+        const std::vector <uint32_t> &nOffsetsVc = m_PatternsVc[j].m_nOffsetsVc;
+        bool fTuple = (nOffsetsVc.back() <= nHigh - nPrime);       // All members belong to the interval
+
+        for(size_t k = 1; fTuple && k < nOffsetsVc.size(); ++k)
+        {
+            fTuple = std::binary_search(m_WindowVc.begin(), m_WindowVc.end(), nPrime + nOffsetsVc[k]);
+        }
+
+        if(fTuple)
+        {
+            size_t nIdx = m_nInterval * q + j;
+
+            ++m_nCountVc[nIdx];
+            if(m_fList)
+            {
+                m_FirstVc[nIdx].push_back(nPrime);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes number of tuples (and their first members) of every interval and pattern to the file
+ * @param None
+ * @return None
+ */
+void TuplesOutput::writeFile() const
+{
+    std::ofstream Out(m_pFileName);
+    uint64_t nFound(0);
+
+    if(!Out)
+    {
+        std::cerr << "File opening error!\n";
+        exit(1);
+    }
+
+    Out << "<root>\n<tuples>\n";
+    for(size_t i = 0, p = m_pIntVc->size(); i < p; ++i)
+    {
+        Out << "  <interval>\n    <low>" << (*m_pIntVc)[i].m_nLowIntervalSide << "</low>\n    <high>"
+            << (*m_pIntVc)[i].m_nHighIntervalSide << "</high>\n";
+
+        for(size_t j = 0, q = m_PatternsVc.size(); j < q; ++j)
+        {
+            Out << "    <tuple>\n      <name>" << m_PatternsVc[j].m_Name << "</name>\n      <offsets>";
+            for(uint32_t nOffset : m_PatternsVc[j].m_nOffsetsVc)
+            {
+                Out << ' ' << nOffset;
+            }
+            Out << " </offsets>\n      <count>" << m_nCountVc[i * q + j] << "</count>\n";
+
+            if(m_fList)
+            {
+                Out << "      <first> ";
+                for(uint64_t nFirst : m_FirstVc[i * q + j])
+                {
+                    Out << nFirst << ' ';
+                }
+                Out << "</first>\n";
+            }
+            Out << "    </tuple>\n";
+
+            nFound += m_nCountVc[i * q + j];
+        }
+        Out << "  </interval>\n";
+    }
+    Out << "</tuples>\n</root>";
+
+    Profiler::get().addCounter("tuples_found", nFound);
+}
+
+/**
+ * @brief Returns number of tuples of every interval and pattern
+ * @param None
+ * @return Tuples of the pattern j of the interval i are [i * patterns + j]
+ */
+const std::vector <uint64_t> &TuplesOutput::getCounts() const
+{
+    return m_nCountVc;
+}
+
+//*****************************************************************************************
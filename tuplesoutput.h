@@ -0,0 +1,56 @@
+/**
+  *************************************************************************************************************************
+  * @file    tuplesoutput.h
+  * @author  Alexander Porada
+  *          a.porada@online.ua
+  * @date    19-October-2026
+  * @brief   Derived class from the abstract class PrimesOutput which counts prime k-tuples of every interval and writes
+  *          them to the file. The result of the sieve is scanned by TupleFinder word by word, the stream of the
+  *          pipelined mode is checked in the window of the largest offset
+  **************************************************************************************************************************
+*/
+
+#ifndef TUPLESOUTPUT_H
+#define TUPLESOUTPUT_H
+
+#include <vector>
+#include <deque>
+
+#include "primesoutput.hpp"
+#include "interval.hpp"
+#include "tuplepattern.hpp"
+
+class TuplesOutput: public PrimesOutput
+{
+public:
+    TuplesOutput(const char *pFileName, const std::vector <Interval> *pIntVc, const std::vector <TuplePattern> &PatternsVc,
+                 bool fList = false);
+    virtual ~TuplesOutput() override;
+
+    void output(PrimeNumbersVector *pPrimeNumVc) override;
+
+    void begin() override;
+    void write(const std::vector <uint64_t> &PrimesVc) override;
+    void end() override;
+
+    const std::vector <uint64_t> &getCounts() const;       // Tuples of the pattern j of the interval i are [i * patterns + j]
+
+private:
+    const char *m_pFileName;
+    const std::vector <Interval> *m_pIntVc;                 // Intervals of FindPrimes
+    std::vector <TuplePattern> m_PatternsVc;                // Patterns to find
+    bool m_fList;                                           // Write first members of tuples, not only their number
+    std::vector <uint64_t> m_nCountVc;                      // Number of tuples of every interval and pattern
+    std::vector <std::vector <uint64_t> > m_FirstVc;        // First members of tuples of every interval and pattern
+    std::deque <uint64_t> m_WindowVc;                       // Primes of the stream which may be members of a tuple
+    size_t m_nInterval;                                     // Interval of the first prime of the window
+    uint32_t m_nMaxOffset;                                  // Max offset of all patterns
+
+    void reset();
+    void checkTuples(uint64_t nPrime);
+    void writeFile() const;
+};
+
+#endif // TUPLESOUTPUT_H
+
+//*****************************************************************************************